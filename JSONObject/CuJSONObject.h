@@ -13,19 +13,108 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <ostream>
 #include <variant>
 #include <memory>
+#include <new>
+#include <iterator>
 #include <limits>
 #include <exception>
 #include <algorithm>
 #include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <array>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <filesystem>
 #include <cstdio>
 #include <cstdlib>
 #include <cstdint>
 #include <climits>
+#include <cfloat>
+#include <clocale>
 #include <cstring>
 #include <cinttypes>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define _CU_JSON_AVX2_ 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define _CU_JSON_SSE2_ 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define _CU_JSON_NEON_ 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // defined(_MSC_VER)
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define _CU_JSON_MMAP_ 1
+#endif
+
+#if defined(_WIN32)
+#include <io.h>
+#endif
+
+// CU_JSON_BIND(Type, field...) declares the JSON members of a struct for CU::JSONBind,
+// use it in the namespace of the struct with up to 32 public fields.
+#define _CU_JSON_EXPAND_(x) x
+#define _CU_JSON_CONCAT_(a, b) a##b
+#define _CU_JSON_SELECT_(name, count) _CU_JSON_CONCAT_(name, count)
+#define _CU_JSON_COUNT_(...) _CU_JSON_EXPAND_(_CU_JSON_COUNT_N_(__VA_ARGS__, \
+    32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, \
+    16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define _CU_JSON_COUNT_N_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, \
+    _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define _CU_JSON_FIELD_(T, f) CU::JSONBind::MakeField(#f, &T::f)
+#define _CU_JSON_FIELDS_1(T, f) _CU_JSON_FIELD_(T, f)
+#define _CU_JSON_FIELDS_2(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_1(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_3(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_2(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_4(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_3(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_5(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_4(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_6(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_5(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_7(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_6(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_8(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_7(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_9(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_8(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_10(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_9(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_11(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_10(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_12(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_11(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_13(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_12(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_14(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_13(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_15(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_14(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_16(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_15(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_17(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_16(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_18(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_17(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_19(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_18(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_20(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_19(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_21(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_20(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_22(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_21(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_23(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_22(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_24(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_23(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_25(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_24(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_26(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_25(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_27(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_26(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_28(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_27(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_29(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_28(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_30(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_29(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_31(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_30(T, __VA_ARGS__))
+#define _CU_JSON_FIELDS_32(T, f, ...) _CU_JSON_FIELD_(T, f), _CU_JSON_EXPAND_(_CU_JSON_FIELDS_31(T, __VA_ARGS__))
+#define CU_JSON_BIND(T, ...) \
+    [[maybe_unused]] inline constexpr auto _CU_JSON_Bind_Fields(const T*) \
+    { \
+        return std::make_tuple(_CU_JSON_EXPAND_(_CU_JSON_SELECT_(_CU_JSON_FIELDS_, _CU_JSON_COUNT_(__VA_ARGS__))(T, __VA_ARGS__))); \
+    }
+
 namespace CU
 {
     class JSONExcept : public std::exception
@@ -127,6 +216,17 @@ namespace CU
                 length_ = new_len;
             }
 
+            void append(const char* src, size_t src_len) noexcept
+            {
+                auto new_len = length_ + src_len;
+                if (new_len >= capacity_) {
+                    resize(capacity_ + new_len);
+                }
+                std::memcpy((data() + length_), src, src_len);
+                *(data() + new_len) = '\0';
+                length_ = new_len;
+            }
+
             void append(char ch) noexcept
             {
                 if ((length_ + 1) >= capacity_) {
@@ -209,52 +309,240 @@ namespace CU
             size_t capacity_;
     };
 
+    class _JSON_Key_Table
+    {
+        public:
+            struct Entry
+            {
+                Entry(std::string_view key, size_t hash) : key(key), hash(hash), refCount(1) { }
+
+                const std::string key;
+                const size_t hash;
+                std::atomic<size_t> refCount;
+            };
+
+            _JSON_Key_Table(const _JSON_Key_Table &other) = delete;
+            _JSON_Key_Table &operator=(const _JSON_Key_Table &other) = delete;
+
+            // Never destroyed, keys held by other static objects may be released after exit.
+            static _JSON_Key_Table &Instance()
+            {
+                static auto instance = new _JSON_Key_Table();
+                return *instance;
+            }
+
+            static size_t Hash(std::string_view key) noexcept
+            {
+                return std::hash<std::string_view>()(key);
+            }
+
+            // Each thread remembers its recently interned keys, so parsing the same keys over and 
+            // over again only touches the shared table on a cache miss.
+            Entry* acquire(std::string_view key, size_t hash)
+            {
+                thread_local Cache_ cache{};
+                auto &cached = cache.entries[hash & (cacheSize_ - 1)];
+                if (cached != nullptr && cached->hash == hash && cached->key == key) {
+                    retain(cached);
+                    return cached;
+                }
+                auto entry = intern_(key, hash);
+                retain(entry);
+                if (cached != nullptr) {
+                    release(cached);
+                }
+                cached = entry;
+                return entry;
+            }
+
+            void retain(Entry* entry) noexcept
+            {
+                entry->refCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void release(Entry* entry) noexcept
+            {
+                if (entry->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    auto &shard = shards_[entry->hash % shardCount_];
+                    {
+                        std::unique_lock<std::mutex> lock(shard.mutex);
+                        auto range = shard.entries.equal_range(entry->hash);
+                        for (auto iter = range.first; iter != range.second; iter++) {
+                            if (iter->second == entry) {
+                                shard.entries.erase(iter);
+                                break;
+                            }
+                        }
+                    }
+                    delete entry;
+                }
+            }
+
+        private:
+            static constexpr size_t shardCount_ = 16;
+            static constexpr size_t cacheSize_ = 256;
+
+            struct Identity_
+            {
+                size_t operator()(size_t hash) const noexcept
+                {
+                    return hash;
+                }
+            };
+
+            struct Shard_
+            {
+                std::mutex mutex;
+                std::unordered_multimap<size_t, Entry*, Identity_> entries;
+            };
+
+            struct Cache_
+            {
+                std::array<Entry*, cacheSize_> entries{};
+
+                ~Cache_()
+                {
+                    for (auto entry : entries) {
+                        if (entry != nullptr) {
+                            Instance().release(entry);
+                        }
+                    }
+                }
+            };
+
+            std::array<Shard_, shardCount_> shards_;
+
+            _JSON_Key_Table() : shards_() { }
+
+            Entry* intern_(std::string_view key, size_t hash)
+            {
+                auto &shard = shards_[hash % shardCount_];
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                auto range = shard.entries.equal_range(hash);
+                for (auto iter = range.first; iter != range.second; iter++) {
+                    auto entry = iter->second;
+                    if (entry->key != key) {
+                        continue;
+                    }
+                    // An entry whose count already dropped to zero is being released by another 
+                    // thread, it must not be revived.
+                    auto count = entry->refCount.load(std::memory_order_relaxed);
+                    while (count != 0 && !entry->refCount.compare_exchange_weak(count, (count + 1), std::memory_order_relaxed)) { }
+                    if (count != 0) {
+                        return entry;
+                    }
+                    shard.entries.erase(iter);
+                    break;
+                }
+                auto entry = new Entry(key, hash);
+                shard.entries.emplace(hash, entry);
+                return entry;
+            }
+    };
+
+    // Interned object key, equal keys share one refcounted entry holding the string and its hash, 
+    // so a key costs a pointer per member and compares by address.
+    class JSONKey
+    {
+        public:
+            inline JSONKey() noexcept;
+            inline explicit JSONKey(std::string_view key);
+            inline JSONKey(const JSONKey &other) noexcept;
+            inline JSONKey(JSONKey &&other) noexcept;
+            inline ~JSONKey();
+
+            inline JSONKey &operator=(const JSONKey &other) noexcept;
+            inline JSONKey &operator=(JSONKey &&other) noexcept;
+            inline bool operator==(const JSONKey &other) const noexcept;
+            inline bool operator!=(const JSONKey &other) const noexcept;
+            inline bool operator==(std::string_view other) const noexcept;
+            inline bool operator!=(std::string_view other) const noexcept;
+            inline bool operator<(const JSONKey &other) const noexcept;
+            inline operator const std::string &() const noexcept;
+            inline operator std::string_view() const noexcept;
+            inline char operator[](size_t pos) const noexcept;
+
+            inline const std::string &str() const noexcept;
+            inline std::string_view view() const noexcept;
+            inline const char* data() const noexcept;
+            inline const char* c_str() const noexcept;
+            inline size_t size() const noexcept;
+            inline size_t length() const noexcept;
+            inline size_t hash() const noexcept;
+            inline bool empty() const noexcept;
+            inline int compare(std::string_view other) const noexcept;
+            inline std::string::const_iterator begin() const noexcept;
+            inline std::string::const_iterator end() const noexcept;
+
+        private:
+            _JSON_Key_Table::Entry* entry_;
+    };
+
+    // JSONObject::JSONPair::key used to be a std::string, these keep string expressions on it compiling.
+    inline std::string operator+(const JSONKey &lhs, const JSONKey &rhs);
+    inline std::string operator+(const JSONKey &lhs, std::string_view rhs);
+    inline std::string operator+(std::string_view lhs, const JSONKey &rhs);
+    inline std::string operator+(const JSONKey &lhs, char rhs);
+    inline std::string operator+(char lhs, const JSONKey &rhs);
+    inline bool operator==(std::string_view lhs, const JSONKey &rhs) noexcept;
+    inline bool operator!=(std::string_view lhs, const JSONKey &rhs) noexcept;
+    inline std::ostream &operator<<(std::ostream &stream, const JSONKey &key);
+
+    // Writes to any JSONItem / JSONArray / JSONObject advance the generation, a hash memoised by a 
+    // container that handed out a mutable reference only holds while the generation stays the same.
+    // The low bit is set once a memoised hash depends on the current generation, writes only advance 
+    // it then, so writes in between hashing cost a single load.
+    class _JSON_Hash_Generation
+    {
+        public:
+            static size_t Observe() noexcept
+            {
+                auto &generation = Value_();
+                auto value = generation.load(std::memory_order_relaxed);
+                while ((value & 1) == 0) {
+                    if (generation.compare_exchange_weak(value, (value + 1), std::memory_order_relaxed)) {
+                        return (value + 1);
+                    }
+                }
+                return value;
+            }
+
+            static bool Current(size_t observed) noexcept
+            {
+                return (Value_().load(std::memory_order_relaxed) == observed);
+            }
+
+            static void Advance() noexcept
+            {
+                auto &generation = Value_();
+                auto value = generation.load(std::memory_order_relaxed);
+                while ((value & 1) != 0) {
+                    if (generation.compare_exchange_weak(value, (value + 1), std::memory_order_relaxed)) {
+                        return;
+                    }
+                }
+            }
+
+        private:
+            static std::atomic<size_t> &Value_() noexcept
+            {
+                static std::atomic<size_t> generation(0);
+                return generation;
+            }
+    };
+
     class JSONObject;
     class JSONArray;
     class JSONItem;
+    class JSONWriter;
+    class JSONPath;
+    class _JSON_Reader;
 
-    inline _JSON_String _StringToJSONRaw(const std::string &str)
+    namespace JSONBinary
     {
-        _JSON_String raw("\"");
-        for (const auto &ch : str) {
-            switch (ch) {
-                case '\\':
-                    raw.append("\\\\");
-                    break;
-                case '\"':
-                    raw.append("\\\"");
-                    break;
-                case '\n':
-                    raw.append("\\n");
-                    break;
-                case '\t':
-                    raw.append("\\t");
-                    break;
-                case '\r':
-                    raw.append("\\r");
-                    break;
-                case '\f':
-                    raw.append("\\f");
-                    break;
-                case '\a':
-                    raw.append("\\a");
-                    break;
-                case '\b':
-                    raw.append("\\b");
-                    break;
-                case '\v':
-                    raw.append("\\v");
-                    break;
-                case '/':
-                    raw.append("\\/");
-                    break;
-                default:
-                    raw.append(ch);
-                    break;
-            }
-        }
-        raw.append('\"');
-        return raw;
+        class _Binary_Encoder;
+        class _Compact_Encoder;
+        class Item;
     }
 
     class JSONItem
@@ -273,8 +561,11 @@ namespace CU
             inline JSONItem(double value);
             inline JSONItem(const char* value);
             inline JSONItem(const std::string &value);
+            inline JSONItem(std::string &&value) noexcept;
             inline JSONItem(const JSONArray &value);
+            inline JSONItem(JSONArray &&value);
             inline JSONItem(const JSONObject &value);
+            inline JSONItem(JSONObject &&value);
             inline JSONItem(const JSONItem &other);
             inline JSONItem(JSONItem &&other) noexcept;
             inline ~JSONItem();
@@ -308,14 +599,41 @@ namespace CU
             inline JSONObject toObject() const;
             inline _JSON_String toRaw() const;
 
+            inline const std::string &asString() const;
+            inline const JSONArray &asArray() const;
+            inline const JSONObject &asObject() const;
+            inline std::string &asString();
+            inline JSONArray &asArray();
+            inline JSONObject &asObject();
+            inline std::string takeString();
+            inline JSONArray takeArray();
+            inline JSONObject takeObject();
+
             inline void clear();
             inline size_t size() const;
             inline size_t hash() const;
             inline ItemType type() const;
+
+            inline const JSONItem* get(const JSONPath &path) const;
+            inline std::vector<const JSONItem*> select(const JSONPath &path) const;
             
         private:
+            friend class JSONArray;
+            friend class JSONObject;
+            friend class JSONWriter;
+            friend class JSONBinary::_Binary_Encoder;
+            friend class JSONBinary::_Compact_Encoder;
+
+            // How long a computed hash holds: until the container is modified, while the hash generation 
+            // stays the same, or not at all since a string below was handed out by reference.
+            enum class HashScope_ : uint8_t {CONTAINER, GENERATION, NONE};
+
             ItemType type_;
+            bool exposed_;
             ItemValue value_;
+
+            inline size_t computeHash_(HashScope_ &scope) const;
+            inline void destroy_() noexcept;
     };
 
     class JSONArray
@@ -338,6 +656,7 @@ namespace CU
             inline JSONArray &operator=(const JSONArray &other);
             inline JSONArray &operator=(JSONArray &&other) noexcept;
             inline JSONArray &operator+=(const JSONArray &other);
+            inline JSONArray &operator+=(JSONArray &&other);
             inline JSONArray operator+(const JSONArray &other) const;
             inline bool operator==(const JSONArray &other) const;
             inline bool operator!=(const JSONArray &other) const;
@@ -346,6 +665,10 @@ namespace CU
             inline const JSONItem &at(size_t pos) const;
             inline iterator find(const JSONItem &item);
             inline void add(const JSONItem &item);
+            inline void add(JSONItem &&item);
+            inline void insert(size_t pos, const JSONItem &item);
+            inline void insert(size_t pos, JSONItem &&item);
+            inline void erase(size_t pos);
             inline void remove(const JSONItem &item);
             inline void resize(size_t new_size);
             inline void clear();
@@ -357,6 +680,12 @@ namespace CU
 
             inline const std::vector<JSONItem> &data() const;
 
+            inline const JSONItem* get(const JSONPath &path) const;
+            inline std::vector<const JSONItem*> select(const JSONPath &path) const;
+
+            template <typename ..._Args>
+            JSONItem &emplace(_Args &&...args);
+
             inline JSONItem &front();
             inline JSONItem &back();
             inline const JSONItem &front() const;
@@ -367,31 +696,68 @@ namespace CU
             inline const_iterator end() const;
             
         private:
+            friend class JSONItem;
+
+            // hash_ holds the memoised hash, 0 before it is computed. memoGeneration_ is 0 when the hash 
+            // holds until the array is modified, otherwise the hash generation it holds for. That is the 
+            // case once the array or a container below it is exposed, a mutable reference or iterator 
+            // into it has been handed out and writes through it bypass the array.
             std::vector<JSONItem> data_;
+            mutable std::atomic<size_t> hash_;
+            mutable std::atomic<size_t> memoGeneration_;
+            bool exposed_;
+
+            inline size_t computeHash_(JSONItem::HashScope_ &scope) const;
+            inline bool cachedHash_(size_t &hashVal, JSONItem::HashScope_ &scope) const noexcept;
+            inline void memoise_(size_t hashVal, JSONItem::HashScope_ scope) const noexcept;
+            inline void resetHash_() noexcept;
+            inline void expose_() noexcept;
     };
 
+    // Members are kept in insertion order in one contiguous vector, searched linearly while the object is 
+    // small and through an open-addressing index of member positions past indexThreshold members.
+    // References to members stay valid until the next insertion or removal.
     class JSONObject
     {
         public:
+            struct JSONPair
+            {
+                JSONKey key;
+                JSONItem value;
+            };
+
+            typedef std::vector<JSONPair>::const_iterator const_iterator;
+
+            static constexpr size_t indexThreshold = 16;
+
             inline JSONObject();
             inline JSONObject(std::string_view jsonText);
             inline JSONObject(const JSONObject &other);
             inline JSONObject(JSONObject &&other) noexcept;
-            inline JSONObject(std::unordered_map<std::string, JSONItem> &&data, std::vector<std::string> &&order) noexcept;
+            inline JSONObject(std::vector<JSONPair> &&members);
+            inline JSONObject(std::unordered_map<std::string, JSONItem> &&data, std::vector<std::string> &&order);
             inline ~JSONObject();
 
             inline JSONObject &operator=(const JSONObject &other);
             inline JSONObject &operator=(JSONObject &&other) noexcept;
             inline JSONObject &operator+=(const JSONObject &other);
+            inline JSONObject &operator+=(JSONObject &&other);
             inline JSONObject operator+(const JSONObject &other) const;
             inline bool operator==(const JSONObject &other) const;
             inline bool operator!=(const JSONObject &other) const;
             inline JSONItem &operator[](const std::string &key);
+            inline JSONItem &operator[](const JSONKey &key);
             
             inline const JSONItem &at(const std::string &key) const;
+            inline const JSONItem &at(const JSONKey &key) const;
             inline bool contains(const std::string &key) const;
+            inline bool contains(const JSONKey &key) const;
             inline void add(const std::string &key, const JSONItem &value);
+            inline void add(const std::string &key, JSONItem &&value);
+            inline void add(const JSONKey &key, const JSONItem &value);
+            inline void add(const JSONKey &key, JSONItem &&value);
             inline void remove(const std::string &key);
+            inline void remove(const JSONKey &key);
             inline void clear();
             inline size_t size() const;
             inline size_t hash() const;
@@ -400,1725 +766,12014 @@ namespace CU
             inline std::string toString() const;
             inline std::string toFormatedString() const;
 
-            inline const std::unordered_map<std::string, JSONItem> &data() const;
-            inline const std::vector<std::string> &order() const;
+            inline const JSONItem* find(std::string_view key) const;
+            inline const JSONItem* find(const JSONKey &key) const;
+            inline const JSONItem* get(const JSONPath &path) const;
+            inline std::vector<const JSONItem*> select(const JSONPath &path) const;
+            inline const std::vector<JSONPair> &members() const;
+            inline std::vector<JSONPair> toPairs() const;
 
-            struct JSONPair
+            template <typename ..._Args>
+            JSONItem &emplace(const std::string &key, _Args &&...args);
+
+            template <typename ..._Args>
+            JSONItem &emplace(const JSONKey &key, _Args &&...args);
+
+            inline const_iterator begin() const;
+            inline const_iterator end() const;
+
+            // Copies of the members in the former storage layout, built on every call.
+            [[deprecated("copies every member, iterate the object or use find() instead")]]
+            inline std::unordered_map<std::string, JSONItem> data() const;
+            [[deprecated("copies every key, iterate the object instead")]]
+            inline std::vector<std::string> order() const;
+
+        private:
+            friend class JSONItem;
+
+            static constexpr uint32_t emptySlot_ = static_cast<uint32_t>(-1);
+            static constexpr size_t npos_ = static_cast<size_t>(-1);
+
+            std::vector<JSONPair> members_;
+            std::vector<uint32_t> index_;
+            // Same meaning as in JSONArray.
+            mutable std::atomic<size_t> hash_;
+            mutable std::atomic<size_t> memoGeneration_;
+            bool exposed_;
+
+            inline size_t findPos_(std::string_view key) const;
+            inline size_t findPos_(const JSONKey &key) const;
+            inline size_t slot_(std::string_view key, size_t hash) const;
+            inline size_t slot_(const JSONKey &key) const;
+            inline size_t computeHash_(JSONItem::HashScope_ &scope) const;
+            inline bool cachedHash_(size_t &hashVal, JSONItem::HashScope_ &scope) const noexcept;
+            inline void memoise_(size_t hashVal, JSONItem::HashScope_ scope) const noexcept;
+            inline JSONItem &findOrInsert_(const std::string &key);
+            inline JSONItem &findOrInsert_(const JSONKey &key);
+            inline JSONItem &insert_(const JSONKey &key);
+            inline void insertIndex_(size_t pos);
+            inline void eraseIndex_(size_t pos);
+            inline void buildIndex_();
+            inline void modified_() noexcept;
+            inline void expose_() noexcept;
+    };
+
+    // Compiled JSON Pointer (RFC 6901) such as "/a/b/3", resolved by reference against the DOM or a 
+    // JSONBinary buffer. Two extensions select several values: a "*" segment matches every element or 
+    // member, and a "[?<pointer><op><JSON value>]" segment keeps those for which the relative pointer 
+    // compares true, op being one of == != < <= > >= or omitted to test that the pointer resolves.
+    // The empty path selects the root, which a JSONArray or JSONObject root cannot be returned as, 
+    // so get() and select() on those reject it.
+    class JSONPath
+    {
+        public:
+            enum class SegmentType : uint8_t {KEY, WILDCARD, FILTER};
+            enum class FilterOp : uint8_t {EXISTS, EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL};
+
+            struct Segment
             {
-                std::string key;
+                SegmentType type;
+                JSONKey key;
+                size_t index;
+                FilterOp op;
+                std::vector<Segment> operand;
                 JSONItem value;
             };
-            inline std::vector<JSONPair> toPairs() const;
+
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            inline JSONPath();
+            inline JSONPath(std::string_view path);
+            inline JSONPath(const char* path);
+
+            inline JSONPath &append(std::string_view key);
+            inline JSONPath &append(size_t pos);
+            inline JSONPath &appendWildcard();
+
+            inline const JSONItem* get(const JSONItem &root) const;
+            inline const JSONItem* get(const JSONArray &root) const;
+            inline const JSONItem* get(const JSONObject &root) const;
+            inline std::optional<JSONBinary::Item> get(const JSONBinary::Item &root) const;
+            inline std::vector<const JSONItem*> select(const JSONItem &root) const;
+            inline std::vector<const JSONItem*> select(const JSONArray &root) const;
+            inline std::vector<const JSONItem*> select(const JSONObject &root) const;
+            inline std::vector<JSONBinary::Item> select(const JSONBinary::Item &root) const;
+
+            inline bool isSingular() const;
+            inline bool empty() const;
+            inline size_t size() const;
+            inline const std::vector<Segment> &segments() const;
+            inline std::string toString() const;
 
         private:
-            std::unordered_map<std::string, JSONItem> data_;
-            std::vector<std::string> order_;
+            class DomNode_;
+            class BinaryNode_;
+
+            std::vector<Segment> segments_;
+
+            inline void checkContainerRoot_() const;
+            inline const JSONItem* getItem_(const DomNode_ &root) const;
+            inline std::vector<const JSONItem*> selectItems_(const DomNode_ &root) const;
+
+            inline static std::vector<Segment> Compile_(std::string_view path);
+            inline static Segment CompileFilter_(std::string_view filter);
+            inline static Segment KeySegment_(std::string_view key);
+            inline static bool Compare_(const JSONItem &value, FilterOp op, const JSONItem &operand);
+            inline static void Print_(std::string &text, const std::vector<Segment> &segments);
+
+            template <typename _Node, typename _Visitor>
+            static bool Walk_(const Segment* segment, const Segment* end, const _Node &node, _Visitor &visitor);
+
+            template <typename _Node>
+            static bool Match_(const Segment &filter, const _Node &node);
     };
 
-    namespace _JSON_Parse_Utils
+    // JSON Schema subset compiled once into a table of nodes: type, enum, minimum, maximum, maxLength, 
+    // properties, required and items, other keywords are ignored. Values are checked over an existing tree, 
+    // or while parsing so that a bad payload is rejected before the rest of its DOM is built.
+    class JSONSchema
     {
-        inline void ThrowSyntaxExcept(std::string_view message, std::string_view jsonText = "", size_t beginPos = 0) 
-        {
-            static const auto countLine = [](std::string_view jsonText, size_t beginPos) -> size_t {
-                if (beginPos > jsonText.size()) {
-                    return 0;
-                }
+        public:
+            inline JSONSchema();
+            inline JSONSchema(const JSONObject &schema);
+            inline JSONSchema(std::string_view schemaText);
 
-                size_t count = 0;
-                for (size_t pos = 0; pos < beginPos; pos++) {
-                    if (jsonText[pos] == '\n') {
-                        count++;
-                    }
-                }
-                return count;
+            inline void validate(const JSONItem &item) const;
+            inline void validate(const JSONArray &array) const;
+            inline void validate(const JSONObject &object) const;
+            inline bool isValid(const JSONItem &item) const;
+            inline JSONItem parse(std::string_view jsonText) const;
+
+        private:
+            struct Node_
+            {
+                uint8_t types;
+                bool hasMinimum;
+                bool hasMaximum;
+                double minimum;
+                double maximum;
+                size_t maxLength;
+                size_t items;
+                size_t firstProperty;
+                size_t propertyCount;
+                std::vector<JSONItem> enumValues;
             };
 
-            if (jsonText.size() > 0) {
-                char except_msg[4096]{};
-                std::snprintf(except_msg, sizeof(except_msg), 
-                    "Invalid syntax on line %zu: %s", (countLine(jsonText, beginPos) + 1), message.data());
-                throw JSONExcept(except_msg);
-            }
-            throw JSONExcept(std::string("Invalid syntax: ") + message.data());
-        }
+            struct Property_
+            {
+                JSONKey key;
+                size_t node;
+                bool required;
+            };
 
-        template <typename _Ty>
-        struct Result 
-        {
-            _Ty resultVal;
-            size_t endPos;
+            // Thrown by the checks, the path is collected from the innermost value outwards.
+            struct Violation_
+            {
+                std::vector<std::string> path;
+                std::string message;
+            };
 
-            Result() : resultVal(), endPos(-1) { }
+            static constexpr uint8_t typeNull_ = 0x01;
+            static constexpr uint8_t typeBoolean_ = 0x02;
+            static constexpr uint8_t typeInteger_ = 0x04;
+            static constexpr uint8_t typeNumber_ = 0x08;
+            static constexpr uint8_t typeString_ = 0x10;
+            static constexpr uint8_t typeArray_ = 0x20;
+            static constexpr uint8_t typeObject_ = 0x40;
+            static constexpr uint8_t typeAny_ = 0x7F;
+            static constexpr size_t npos_ = static_cast<size_t>(-1);
+
+            std::vector<Node_> nodes_;
+            std::vector<Property_> properties_;
+            size_t root_;
+
+            inline size_t compile_(const JSONItem &schema);
+            inline size_t compile_(const JSONObject &schema);
+            inline size_t propertyNode_(size_t node, const JSONKey &key) const noexcept;
+            inline void check_(size_t node, const JSONItem &item) const;
+            inline void checkArray_(size_t node, const JSONArray &array) const;
+            inline void checkObject_(size_t node, const JSONObject &object) const;
+            inline void checkValue_(size_t node, uint8_t type, const JSONItem &item) const;
+            inline void parse_(size_t node, _JSON_Reader &reader, JSONItem &item) const;
+
+            inline static uint8_t TypeOf_(const JSONItem &item) noexcept;
+            inline static bool Equal_(const JSONItem &item, const JSONItem &value);
+            inline static double Number_(const JSONItem &item);
+            inline static void CheckType_(uint8_t types, uint8_t type);
+            [[noreturn]] inline static void Fail_(const char* message);
+            [[noreturn]] inline static void Throw_(const Violation_ &violation);
+    };
 
-            Result(const Result &other) : resultVal(other.resultVal), endPos(other.endPos) { }
+    namespace _JSON_Number_Utils
+    {
+        struct DiyFp
+        {
+            uint64_t f;
+            int e;
+        };
 
-            Result(Result &&other) noexcept : resultVal(std::move(other.resultVal)), endPos(other.endPos) { }
+        struct CachedPower
+        {
+            uint64_t f;
+            int e;
+            int k;
         };
 
-        inline size_t IgnoreBlank(std::string_view jsonText, size_t beginPos) noexcept
+        inline DiyFp Subtract(const DiyFp &x, const DiyFp &y) noexcept
         {
-            static const auto isBlankChar = [](char ch) -> bool {
-                switch (ch) {
-                    case ' ':
-                    case '\n':
-                    case '\t':
-                    case '\r':
-                    case '\f':
-                    case '\a':
-                    case '\b':
-                    case '\v':
-                        return true;
-                    default:
-                        break;
-                }
-                return false;
-            };
+            return {(x.f - y.f), x.e};
+        }
 
-            for (auto pos = beginPos; pos < jsonText.size(); pos++) {
-                if (!isBlankChar(jsonText[pos])) {
-                    return pos;
-                }
+        inline DiyFp Multiply(const DiyFp &x, const DiyFp &y) noexcept
+        {
+            auto xLow = x.f & 0xFFFFFFFFu;
+            auto xHigh = x.f >> 32;
+            auto yLow = y.f & 0xFFFFFFFFu;
+            auto yHigh = y.f >> 32;
+
+            auto p0 = xLow * yLow;
+            auto p1 = xLow * yHigh;
+            auto p2 = xHigh * yLow;
+            auto p3 = xHigh * yHigh;
+            uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu) + (uint64_t(1) << 31);
+            return {(p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32)), (x.e + y.e + 64)};
+        }
+
+        inline DiyFp Normalize(DiyFp x) noexcept
+        {
+            while ((x.f >> 63) == 0) {
+                x.f <<= 1;
+                x.e--;
             }
-            return std::string_view::npos;
+            return x;
         }
 
-        inline Result<JSONArray> ParseJSONArray(std::string_view jsonText, size_t beginPos);
+        inline CachedPower GetCachedPower(int e) noexcept
+        {
+            static constexpr int cachedPowersMinDecExp = -300;
+            static constexpr int cachedPowersDecStep = 8;
+            static constexpr int alpha = -60;
+            static constexpr CachedPower cachedPowers[] = {
+                {0xAB70FE17C79AC6CA, -1060, -300},
+                {0xFF77B1FCBEBCDC4F, -1034, -292},
+                {0xBE5691EF416BD60C, -1007, -284},
+                {0x8DD01FAD907FFC3C, -980, -276},
+                {0xD3515C2831559A83, -954, -268},
+                {0x9D71AC8FADA6C9B5, -927, -260},
+                {0xEA9C227723EE8BCB, -901, -252},
+                {0xAECC49914078536D, -874, -244},
+                {0x823C12795DB6CE57, -847, -236},
+                {0xC21094364DFB5637, -821, -228},
+                {0x9096EA6F3848984F, -794, -220},
+                {0xD77485CB25823AC7, -768, -212},
+                {0xA086CFCD97BF97F4, -741, -204},
+                {0xEF340A98172AACE5, -715, -196},
+                {0xB23867FB2A35B28E, -688, -188},
+                {0x84C8D4DFD2C63F3B, -661, -180},
+                {0xC5DD44271AD3CDBA, -635, -172},
+                {0x936B9FCEBB25C996, -608, -164},
+                {0xDBAC6C247D62A584, -582, -156},
+                {0xA3AB66580D5FDAF6, -555, -148},
+                {0xF3E2F893DEC3F126, -529, -140},
+                {0xB5B5ADA8AAFF80B8, -502, -132},
+                {0x87625F056C7C4A8B, -475, -124},
+                {0xC9BCFF6034C13053, -449, -116},
+                {0x964E858C91BA2655, -422, -108},
+                {0xDFF9772470297EBD, -396, -100},
+                {0xA6DFBD9FB8E5B88F, -369, -92},
+                {0xF8A95FCF88747D94, -343, -84},
+                {0xB94470938FA89BCF, -316, -76},
+                {0x8A08F0F8BF0F156B, -289, -68},
+                {0xCDB02555653131B6, -263, -60},
+                {0x993FE2C6D07B7FAC, -236, -52},
+                {0xE45C10C42A2B3B06, -210, -44},
+                {0xAA242499697392D3, -183, -36},
+                {0xFD87B5F28300CA0E, -157, -28},
+                {0xBCE5086492111AEB, -130, -20},
+                {0x8CBCCC096F5088CC, -103, -12},
+                {0xD1B71758E219652C, -77, -4},
+                {0x9C40000000000000, -50, 4},
+                {0xE8D4A51000000000, -24, 12},
+                {0xAD78EBC5AC620000, 3, 20},
+                {0x813F3978F8940984, 30, 28},
+                {0xC097CE7BC90715B3, 56, 36},
+                {0x8F7E32CE7BEA5C70, 83, 44},
+                {0xD5D238A4ABE98068, 109, 52},
+                {0x9F4F2726179A2245, 136, 60},
+                {0xED63A231D4C4FB27, 162, 68},
+                {0xB0DE65388CC8ADA8, 189, 76},
+                {0x83C7088E1AAB65DB, 216, 84},
+                {0xC45D1DF942711D9A, 242, 92},
+                {0x924D692CA61BE758, 269, 100},
+                {0xDA01EE641A708DEA, 295, 108},
+                {0xA26DA3999AEF774A, 322, 116},
+                {0xF209787BB47D6B85, 348, 124},
+                {0xB454E4A179DD1877, 375, 132},
+                {0x865B86925B9BC5C2, 402, 140},
+                {0xC83553C5C8965D3D, 428, 148},
+                {0x952AB45CFA97A0B3, 455, 156},
+                {0xDE469FBD99A05FE3, 481, 164},
+                {0xA59BC234DB398C25, 508, 172},
+                {0xF6C69A72A3989F5C, 534, 180},
+                {0xB7DCBF5354E9BECE, 561, 188},
+                {0x88FCF317F22241E2, 588, 196},
+                {0xCC20CE9BD35C78A5, 614, 204},
+                {0x98165AF37B2153DF, 641, 212},
+                {0xE2A0B5DC971F303A, 667, 220},
+                {0xA8D9D1535CE3B396, 694, 228},
+                {0xFB9B7CD9A4A7443C, 720, 236},
+                {0xBB764C4CA7A44410, 747, 244},
+                {0x8BAB8EEFB6409C1A, 774, 252},
+                {0xD01FEF10A657842C, 800, 260},
+                {0x9B10A4E5E9913129, 827, 268},
+                {0xE7109BFBA19C0C9D, 853, 276},
+                {0xAC2820D9623BF429, 880, 284},
+                {0x80444B5E7AA7CF85, 907, 292},
+                {0xBF21E44003ACDD2D, 933, 300},
+                {0x8E679C2F5E44FF8F, 960, 308},
+                {0xD433179D9C8CB841, 986, 316},
+                {0x9E19DB92B4E31BA9, 1013, 324}
+            };
 
-        inline Result<JSONObject> ParseJSONObject(std::string_view jsonText, size_t beginPos);
+            // Picks 10^-k so that alpha <= e + e_k + 64 <= alpha + 28.
+            auto f = alpha - e - 1;
+            auto k = (f * 78913) / (1 << 18) + static_cast<int>(f > 0);
+            auto index = (-cachedPowersMinDecExp + k + (cachedPowersDecStep - 1)) / cachedPowersDecStep;
+            return cachedPowers[index];
+        }
 
-        inline Result<_JSON_String> ParseEscapeChar(std::string_view jsonText, size_t beginPos)
+        inline int FindLargestPow10(uint32_t value, uint32_t &pow10) noexcept
         {
-            static const auto parseUnicode = [](std::string_view jsonText, size_t beginPos) -> _JSON_String
-            {
-                static constexpr int utf8bit_max = 0x7F;
-                static constexpr int utf16bit_max = 0x7FF;
-                static constexpr int utf24bit_max = 0xFFFF;
-                static constexpr int utf32bit_max = 0x10FFFF;
+            static constexpr uint32_t pow10s[] = {
+                1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+            };
 
-                if (jsonText.size() >= (beginPos + 4)) {
-                    int unicodeVal = std::strtol(jsonText.substr(beginPos, 4).data(), nullptr, 16);
-                    if (unicodeVal <= utf8bit_max) {
-                        char unicodeChar[2]{};
-                        unicodeChar[0] = static_cast<char>(unicodeVal);
-                        return unicodeChar;
-                    } else if (unicodeVal <= utf16bit_max) {
-                        char unicodeChar[3]{};
-                        unicodeChar[0] = static_cast<char>(0xC0 | ((unicodeVal >> 6) & 0x1F));
-                        unicodeChar[1] = static_cast<char>(0x80 | (unicodeVal & 0x3F));
-                        return unicodeChar;
-                    } else if (unicodeVal <= utf24bit_max) {
-                        char unicodeChar[4]{};
-                        unicodeChar[0] = static_cast<char>(0xE0 | ((unicodeVal >> 12) & 0x0F));
-                        unicodeChar[1] = static_cast<char>(0x80 | ((unicodeVal >> 6) & 0x3F));
-                        unicodeChar[2] = static_cast<char>(0x80 | (unicodeVal & 0x3F));
-                        return unicodeChar;
-                    } else if (unicodeVal <= utf32bit_max) {
-                        char unicodeChar[5]{};
-                        unicodeChar[0] = static_cast<char>(0xF0 | ((unicodeVal >> 18) & 0x07));
-                        unicodeChar[1] = static_cast<char>(0x80 | ((unicodeVal >> 12) & 0x3F));
-                        unicodeChar[2] = static_cast<char>(0x80 | ((unicodeVal >> 6) & 0x3F));
-                        unicodeChar[3] = static_cast<char>(0x80 | (unicodeVal & 0x3F));
-                        return unicodeChar;
-                    }
-                }
-
-                ThrowSyntaxExcept("faild to parse unicode escape char", jsonText, beginPos);
-                return {};
-            };
-
-            if (jsonText[beginPos] != '\\') {
-                return {};
+            int digits = 10;
+            while (digits > 1 && value < pow10s[digits - 1]) {
+                digits--;
             }
+            pow10 = pow10s[digits - 1];
+            return digits;
+        }
 
-            Result<_JSON_String> charResult{};
-            auto pos = beginPos + 1;
-            switch (jsonText[pos]) {
-                case 'n':
-                    charResult.resultVal.append('\n');
-                    pos++;
-                    break;
-                case 'r':
-                    charResult.resultVal.append('\r');
-                    pos++;
-                    break;
-                case 't':
-                    charResult.resultVal.append('\t');
-                    pos++;
-                    break;
-                case 'b':
-                    charResult.resultVal.append('\b');
-                    pos++;
-                    break;
-                case 'f':
-                    charResult.resultVal.append('\f');
-                    pos++;
-                    break;
-                case 'a':
-                    charResult.resultVal.append('\a');
-                    pos++;
-                    break;
-                case 'v':
-                    charResult.resultVal.append('\v');
-                    pos++;
-                    break;
-                case '/':
-                    charResult.resultVal.append('/');
-                    pos++;
-                    break;
-                case '\\':
-                    charResult.resultVal.append('\\');
-                    pos++;
-                    break;
-                case '\"':
-                    charResult.resultVal.append('\"');
-                    pos++;
-                    break;
-                case '\'':
-                    charResult.resultVal.append('\'');
-                    pos++;
-                    break;
-                case 'u':
-                    pos++;
-                    charResult.resultVal.append(parseUnicode(jsonText, pos).data());
-                    pos += 4;
-                    break;
-                default:
-                    ThrowSyntaxExcept("unknown escape char", jsonText, pos);
-                    break;
+        inline void Grisu2Round(char* buffer, int length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK) noexcept
+        {
+            while (rest < dist && (delta - rest) >= tenK && ((rest + tenK) < dist || (dist - rest) > (rest + tenK - dist))) {
+                buffer[length - 1]--;
+                rest += tenK;
             }
-            charResult.endPos = pos;
-            return charResult;
         }
 
-        inline Result<_JSON_String> ParseJSONString(std::string_view jsonText, size_t beginPos)
+        inline void Grisu2DigitGen(char* buffer, int &length, int &decimalExponent, DiyFp low, DiyFp w, DiyFp high) noexcept
         {
-            auto pos = IgnoreBlank(jsonText, beginPos);
-            if (jsonText[pos] != '\"') {
-                ThrowSyntaxExcept("JSON String must begin with \'\"\'", jsonText, beginPos);
+            auto delta = Subtract(high, low).f;
+            auto dist = Subtract(high, w).f;
+            DiyFp one = {(uint64_t(1) << -high.e), high.e};
+
+            auto p1 = static_cast<uint32_t>(high.f >> -one.e);
+            auto p2 = high.f & (one.f - 1);
+
+            uint32_t pow10 = 0;
+            auto digits = FindLargestPow10(p1, pow10);
+            while (digits > 0) {
+                auto digit = p1 / pow10;
+                p1 %= pow10;
+                buffer[length++] = static_cast<char>('0' + digit);
+                digits--;
+
+                auto rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+                if (rest <= delta) {
+                    decimalExponent += digits;
+                    Grisu2Round(buffer, length, dist, delta, rest, (static_cast<uint64_t>(pow10) << -one.e));
+                    return;
+                }
+                pow10 /= 10;
             }
-            pos++;
 
-            Result<_JSON_String> stringResult{};
-            while (pos < jsonText.size()) {
-                if (jsonText[pos] == '\"') {
+            int fractionDigits = 0;
+            for (;;) {
+                p2 *= 10;
+                auto digit = p2 >> -one.e;
+                p2 &= (one.f - 1);
+                buffer[length++] = static_cast<char>('0' + digit);
+                fractionDigits++;
+                delta *= 10;
+                dist *= 10;
+                if (p2 <= delta) {
                     break;
-                } else if (jsonText[pos] == '\\') {
-                    auto charResult = ParseEscapeChar(jsonText, pos);
-                    stringResult.resultVal.append(charResult.resultVal.data());
-                    pos = charResult.endPos;
-                } else {
-                    stringResult.resultVal.append(jsonText[pos]);
-                    pos++;
                 }
             }
-            if (pos >= jsonText.size()) {
-                ThrowSyntaxExcept("JSON String must end with \'\"\'", jsonText, beginPos);
+            decimalExponent -= fractionDigits;
+            Grisu2Round(buffer, length, dist, delta, p2, one.f);
+        }
+
+        // Shortest digits that read back as value (Grisu2), value must be finite and positive.
+        inline void Grisu2(char* buffer, int &length, int &decimalExponent, double value) noexcept
+        {
+            static constexpr int significandBits = 52;
+            static constexpr int exponentBias = 1075;
+            static constexpr uint64_t hiddenBit = uint64_t(1) << significandBits;
+
+            uint64_t bits = 0;
+            std::memcpy(std::addressof(bits), std::addressof(value), sizeof(bits));
+            auto biasedExponent = static_cast<int>(bits >> significandBits);
+            auto significand = bits & (hiddenBit - 1);
+
+            DiyFp v{};
+            if (biasedExponent == 0) {
+                v = {significand, (1 - exponentBias)};
+            } else {
+                v = {(significand + hiddenBit), (biasedExponent - exponentBias)};
+            }
+            auto high = Normalize({((v.f << 1) + 1), (v.e - 1)});
+            DiyFp low{};
+            if (significand == 0 && biasedExponent > 1) {
+                low = {((v.f << 2) - 1), (v.e - 2)};
+            } else {
+                low = {((v.f << 1) - 1), (v.e - 1)};
             }
+            low = {(low.f << (low.e - high.e)), high.e};
 
-            stringResult.endPos = pos + 1;
-            return stringResult;
+            auto cached = GetCachedPower(high.e);
+            DiyFp power = {cached.f, cached.e};
+            auto w = Multiply(Normalize(v), power);
+            auto wLow = Multiply(low, power);
+            auto wHigh = Multiply(high, power);
+
+            length = 0;
+            decimalExponent = -cached.k;
+            Grisu2DigitGen(buffer, length, decimalExponent, {(wLow.f + 1), wLow.e}, w, {(wHigh.f - 1), wHigh.e});
         }
 
-        inline Result<JSONItem> ParseJSONItem(std::string_view jsonText, size_t beginPos)
+        inline size_t FormatUnsigned(char* buffer, uint64_t value) noexcept
         {
-            static const auto compareText = 
-                [](std::string_view text, size_t beginPos, std::string_view cmpText) -> bool 
-            {
-                if ((beginPos + cmpText.size()) >= text.size()) {
-                    return false;
-                }
-                return (std::memcmp(&text[beginPos], cmpText.data(), cmpText.size()) == 0);
-            };
-            static const auto splitNumberText = [](std::string_view text, size_t beginPos) -> _JSON_String {
-                _JSON_String numberText{};
-                for (auto pos = beginPos; pos < text.size(); pos++) {
-                    switch (text[pos]) {
-                        case '-':
-                        case '+':
-                        case '.':
-                        case '0':
-                        case '1':
-                        case '2':
-                        case '3':
-                        case '4':
-                        case '5':
-                        case '6':
-                        case '7':
-                        case '8':
-                        case '9':
-                        case 'e':
-                        case 'E':
-                            numberText.append(text[pos]);
-                            break;
-                        default:
-                            return numberText;
-                    }
-                }
-                return numberText;
-            };
+            static constexpr char digitPairs[] = 
+                "0001020304050607080910111213141516171819"
+                "2021222324252627282930313233343536373839"
+                "4041424344454647484950515253545556575859"
+                "6061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+
+            char digits[20]{};
+            size_t pos = sizeof(digits);
+            while (value >= 100) {
+                auto pair = static_cast<size_t>(value % 100) * 2;
+                value /= 100;
+                digits[--pos] = digitPairs[pair + 1];
+                digits[--pos] = digitPairs[pair];
+            }
+            if (value >= 10) {
+                auto pair = static_cast<size_t>(value) * 2;
+                digits[--pos] = digitPairs[pair + 1];
+                digits[--pos] = digitPairs[pair];
+            } else {
+                digits[--pos] = static_cast<char>('0' + value);
+            }
+            std::memcpy(buffer, (digits + pos), (sizeof(digits) - pos));
+            return (sizeof(digits) - pos);
+        }
 
-            Result<JSONItem> itemResult{};
-            auto pos = IgnoreBlank(jsonText, beginPos);
-            switch (jsonText[pos]) {
-                case '{':
-                    {
-                        auto objectResult = ParseJSONObject(jsonText, pos);
-                        itemResult.resultVal = std::move(objectResult.resultVal);
-                        itemResult.endPos = objectResult.endPos;
-                    }
-                    break;
-                case '[':
-                    {
-                        auto arrayResult = ParseJSONArray(jsonText, pos);
-                        itemResult.resultVal = std::move(arrayResult.resultVal);
-                        itemResult.endPos = arrayResult.endPos;
-                    }
-                    break;
-                case '\"':
-                    {
-                        auto stringResult = ParseJSONString(jsonText, pos);
-                        itemResult.resultVal = stringResult.resultVal.data();
-                        itemResult.endPos = stringResult.endPos;
-                    }
-                    break;
-                case '-':
-                case '+':
-                case '0':
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                case '5':
-                case '6':
-                case '7':
-                case '8':
-                case '9':
-                    {
-                        auto numberText = splitNumberText(jsonText, pos);
-                        if (std::string_view(numberText.data()).find('.') != std::string_view::npos) {
-                            itemResult.resultVal = std::strtod(numberText.data(), nullptr);
-                        } else {
-                            auto number = std::strtoll(numberText.data(), nullptr, 10);
-                            if (number >= std::numeric_limits<int>::min() && number <= std::numeric_limits<int>::max()) {
-                                itemResult.resultVal = static_cast<int>(number);
-                            } else {
-                                itemResult.resultVal = static_cast<int64_t>(number);
-                            }
-                        }
-                        itemResult.endPos = pos + numberText.length();
-                    }
-                    break;
-                case 'n':
-                    if (compareText(jsonText, pos, "null")) {
-                        itemResult.resultVal = JSONItem::ItemNull();
-                        itemResult.endPos = pos + 4;
-                    }
-                    break;
-                case 't':
-                    if (compareText(jsonText, pos, "true")) {
-                        itemResult.resultVal = true;
-                        itemResult.endPos = pos + 4;
-                    }
-                    break;
-                case 'f':
-                    if (compareText(jsonText, pos, "false")) {
-                        itemResult.resultVal = false;
-                        itemResult.endPos = pos + 5;
-                    }
-                    break;
-                default:
-                    ThrowSyntaxExcept("unknown JSON Item", jsonText, pos);
-                    break;
+        inline size_t FormatInteger(char* buffer, int64_t value) noexcept
+        {
+            if (value < 0) {
+                buffer[0] = '-';
+                return (FormatUnsigned((buffer + 1), (uint64_t(0) - static_cast<uint64_t>(value))) + 1);
             }
-            return itemResult;
+            return FormatUnsigned(buffer, static_cast<uint64_t>(value));
         }
 
-        inline Result<JSONArray> ParseJSONArray(std::string_view jsonText, size_t beginPos)
+        // Writes the shortest text that reads back as the same double, at most 25 chars.
+        // The text always contains a '.', NaN and infinity have no JSON form and become null.
+        inline size_t FormatDouble(char* buffer, double value) noexcept
         {
-            auto pos = IgnoreBlank(jsonText, beginPos);
-            if (jsonText[pos] != '[') {
-                ThrowSyntaxExcept("JSON Array must begin with \'[\'", jsonText, beginPos);
+            static constexpr int minExponent = -4;
+            static constexpr int maxExponent = 17;
+
+            uint64_t bits = 0;
+            std::memcpy(std::addressof(bits), std::addressof(value), sizeof(bits));
+            if (((bits >> 52) & 0x7FF) == 0x7FF) {
+                std::memcpy(buffer, "null", 4);
+                return 4;
             }
 
-            pos = IgnoreBlank(jsonText, (pos + 1));
-            if (jsonText[pos] == ']') {
-                Result<JSONArray> arrayResult{};
-                arrayResult.endPos = pos + 1;
-                return arrayResult;
+            size_t size = 0;
+            if ((bits >> 63) != 0) {
+                buffer[size++] = '-';
+                value = -value;
+            }
+            if (value == 0) {
+                std::memcpy((buffer + size), "0.0", 3);
+                return (size + 3);
             }
 
-            std::vector<JSONItem> array{};
-            while (pos < jsonText.size()) {
-                auto itemResult = ParseJSONItem(jsonText, IgnoreBlank(jsonText, pos));
-                array.emplace_back(std::move(itemResult.resultVal));
+            auto digits = buffer + size;
+            int length = 0;
+            int decimalExponent = 0;
+            Grisu2(digits, length, decimalExponent, value);
+
+            // Decimal point position relative to the first digit.
+            auto pointPos = length + decimalExponent;
+            if (length <= pointPos && pointPos <= maxExponent) {
+                std::memset((digits + length), '0', (pointPos - length));
+                digits[pointPos] = '.';
+                digits[pointPos + 1] = '0';
+                return (size + pointPos + 2);
+            } else if (0 < pointPos && pointPos <= maxExponent) {
+                std::memmove((digits + pointPos + 1), (digits + pointPos), (length - pointPos));
+                digits[pointPos] = '.';
+                return (size + length + 1);
+            } else if (minExponent < pointPos && pointPos <= 0) {
+                std::memmove((digits + 2 - pointPos), digits, length);
+                digits[0] = '0';
+                digits[1] = '.';
+                std::memset((digits + 2), '0', -pointPos);
+                return (size + 2 - pointPos + length);
+            }
 
-                pos = IgnoreBlank(jsonText, itemResult.endPos);
-                if (jsonText[pos] == ']') {
-                    break;
-                } else if (jsonText[pos] == ',') {
-                    pos++;
-                } else {
-                    ThrowSyntaxExcept("JSON Array elements must be separated by \',\'", jsonText, pos);
-                }
+            if (length == 1) {
+                digits[1] = '.';
+                digits[2] = '0';
+                length = 3;
+            } else {
+                std::memmove((digits + 2), (digits + 1), (length - 1));
+                digits[1] = '.';
+                length++;
             }
-            if (pos >= jsonText.size()) {
-                ThrowSyntaxExcept("JSON Array must end with \']\'", jsonText, beginPos);
+            digits[length++] = 'e';
+            auto exponent = pointPos - 1;
+            if (exponent < 0) {
+                digits[length++] = '-';
+                exponent = -exponent;
+            } else {
+                digits[length++] = '+';
             }
-
-            Result<JSONArray> arrayResult{};
-            arrayResult.resultVal = std::move(array);
-            arrayResult.endPos = pos + 1;
-            return arrayResult;
+            length += static_cast<int>(FormatUnsigned((digits + length), static_cast<uint64_t>(exponent)));
+            return (size + length);
         }
 
-        inline Result<JSONObject> ParseJSONObject(std::string_view jsonText, size_t beginPos)
+        inline int CountLeadingZero(uint64_t val) noexcept
         {
-            auto pos = IgnoreBlank(jsonText, beginPos);
-            if (jsonText[pos] != '{') {
-                ThrowSyntaxExcept("JSON Object must begin with \'{\'", jsonText, pos);
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_clzll(val);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+            unsigned long idx = 0;
+            _BitScanReverse64(std::addressof(idx), val);
+            return (63 - static_cast<int>(idx));
+#else
+            int count = 0;
+            while ((val >> 63) == 0) {
+                val <<= 1;
+                count++;
             }
+            return count;
+#endif
+        }
 
-            pos = IgnoreBlank(jsonText, (pos + 1));
-            if (jsonText[pos] == '}') {
-                Result<JSONObject> objectResult{};
-                objectResult.endPos = pos + 1;
-                return objectResult;
-            }
+        inline uint64_t MultiplyFull(uint64_t x, uint64_t y, uint64_t &low) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            auto product = static_cast<unsigned __int128>(x) * y;
+            low = static_cast<uint64_t>(product);
+            return static_cast<uint64_t>(product >> 64);
+#else
+            auto xLow = x & 0xFFFFFFFFu;
+            auto xHigh = x >> 32;
+            auto yLow = y & 0xFFFFFFFFu;
+            auto yHigh = y >> 32;
+
+            auto p0 = xLow * yLow;
+            auto p1 = xLow * yHigh;
+            auto p2 = xHigh * yLow;
+            auto p3 = xHigh * yHigh;
+            auto mid = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+            low = (mid << 32) | (p0 & 0xFFFFFFFFu);
+            return (p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32));
+#endif
+        }
 
-            std::unordered_map<std::string, JSONItem> data{};
-            std::vector<std::string> order{};
-            while (pos < jsonText.size()) {
-                auto stringResult = ParseJSONString(jsonText, IgnoreBlank(jsonText, pos));
+        inline uint64_t LoadEightChars(const char* text) noexcept
+        {
+            uint64_t val = 0;
+            std::memcpy(std::addressof(val), text, sizeof(val));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            val = __builtin_bswap64(val);
+#endif
+            return val;
+        }
 
-                pos = IgnoreBlank(jsonText, stringResult.endPos);
-                if (jsonText[pos] != ':') {
-                    ThrowSyntaxExcept("key and value must be separated by \':\'", jsonText, pos);
-                }
+        inline bool IsEightDigits(uint64_t val) noexcept
+        {
+            return (((val & 0xF0F0F0F0F0F0F0F0) | (((val + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 
+                0x3333333333333333);
+        }
 
-                auto itemResult = ParseJSONItem(jsonText, IgnoreBlank(jsonText, (pos + 1)));
-                data.emplace(stringResult.resultVal.data(), std::move(itemResult.resultVal));
-                order.emplace_back(stringResult.resultVal.data());
+        // Converts eight ASCII digits loaded in little-endian order with three multiplications.
+        inline uint32_t ParseEightDigits(uint64_t val) noexcept
+        {
+            static constexpr uint64_t mask = 0x000000FF000000FF;
+            static constexpr uint64_t mul1 = 0x000F424000000064;
+            static constexpr uint64_t mul2 = 0x0000271000000001;
+
+            val -= 0x3030303030303030;
+            val = (val * 10) + (val >> 8);
+            val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+            return static_cast<uint32_t>(val);
+        }
 
-                pos = IgnoreBlank(jsonText, itemResult.endPos);
-                if (jsonText[pos] == '}') {
-                    break;
-                } else if (jsonText[pos] == ',') {
-                    pos++;
+        // Clinger's fast path, then Eisel-Lemire with 128-bit truncated powers of five, 
+        // returns false for the rare cases that need an exact fallback.
+        inline bool ComputeDouble(uint64_t mantissa, int64_t exponent, bool negative, double &value) noexcept
+        {
+            static constexpr int64_t smallestPower = -342;
+            static constexpr int64_t largestPower = 308;
+            static constexpr double exactPow10s[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            static constexpr uint64_t powersOfFive[] = {
+                0xEEF453D6923BD65A, 0x113FAA2906A13B3F,
+                0x9558B4661B6565F8, 0x4AC7CA59A424C507,
+                0xBAAEE17FA23EBF76, 0x5D79BCF00D2DF649,
+                0xE95A99DF8ACE6F53, 0xF4D82C2C107973DC,
+                0x91D8A02BB6C10594, 0x79071B9B8A4BE869,
+                0xB64EC836A47146F9, 0x9748E2826CDEE284,
+                0xE3E27A444D8D98B7, 0xFD1B1B2308169B25,
+                0x8E6D8C6AB0787F72, 0xFE30F0F5E50E20F7,
+                0xB208EF855C969F4F, 0xBDBD2D335E51A935,
+                0xDE8B2B66B3BC4723, 0xAD2C788035E61382,
+                0x8B16FB203055AC76, 0x4C3BCB5021AFCC31,
+                0xADDCB9E83C6B1793, 0xDF4ABE242A1BBF3D,
+                0xD953E8624B85DD78, 0xD71D6DAD34A2AF0D,
+                0x87D4713D6F33AA6B, 0x8672648C40E5AD68,
+                0xA9C98D8CCB009506, 0x680EFDAF511F18C2,
+                0xD43BF0EFFDC0BA48, 0x0212BD1B2566DEF2,
+                0x84A57695FE98746D, 0x014BB630F7604B57,
+                0xA5CED43B7E3E9188, 0x419EA3BD35385E2D,
+                0xCF42894A5DCE35EA, 0x52064CAC828675B9,
+                0x818995CE7AA0E1B2, 0x7343EFEBD1940993,
+                0xA1EBFB4219491A1F, 0x1014EBE6C5F90BF8,
+                0xCA66FA129F9B60A6, 0xD41A26E077774EF6,
+                0xFD00B897478238D0, 0x8920B098955522B4,
+                0x9E20735E8CB16382, 0x55B46E5F5D5535B0,
+                0xC5A890362FDDBC62, 0xEB2189F734AA831D,
+                0xF712B443BBD52B7B, 0xA5E9EC7501D523E4,
+                0x9A6BB0AA55653B2D, 0x47B233C92125366E,
+                0xC1069CD4EABE89F8, 0x999EC0BB696E840A,
+                0xF148440A256E2C76, 0xC00670EA43CA250D,
+                0x96CD2A865764DBCA, 0x380406926A5E5728,
+                0xBC807527ED3E12BC, 0xC605083704F5ECF2,
+                0xEBA09271E88D976B, 0xF7864A44C633682E,
+                0x93445B8731587EA3, 0x7AB3EE6AFBE0211D,
+                0xB8157268FDAE9E4C, 0x5960EA05BAD82964,
+                0xE61ACF033D1A45DF, 0x6FB92487298E33BD,
+                0x8FD0C16206306BAB, 0xA5D3B6D479F8E056,
+                0xB3C4F1BA87BC8696, 0x8F48A4899877186C,
+                0xE0B62E2929ABA83C, 0x331ACDABFE94DE87,
+                0x8C71DCD9BA0B4925, 0x9FF0C08B7F1D0B14,
+                0xAF8E5410288E1B6F, 0x07ECF0AE5EE44DD9,
+                0xDB71E91432B1A24A, 0xC9E82CD9F69D6150,
+                0x892731AC9FAF056E, 0xBE311C083A225CD2,
+                0xAB70FE17C79AC6CA, 0x6DBD630A48AAF406,
+                0xD64D3D9DB981787D, 0x092CBBCCDAD5B108,
+                0x85F0468293F0EB4E, 0x25BBF56008C58EA5,
+                0xA76C582338ED2621, 0xAF2AF2B80AF6F24E,
+                0xD1476E2C07286FAA, 0x1AF5AF660DB4AEE1,
+                0x82CCA4DB847945CA, 0x50D98D9FC890ED4D,
+                0xA37FCE126597973C, 0xE50FF107BAB528A0,
+                0xCC5FC196FEFD7D0C, 0x1E53ED49A96272C8,
+                0xFF77B1FCBEBCDC4F, 0x25E8E89C13BB0F7A,
+                0x9FAACF3DF73609B1, 0x77B191618C54E9AC,
+                0xC795830D75038C1D, 0xD59DF5B9EF6A2417,
+                0xF97AE3D0D2446F25, 0x4B0573286B44AD1D,
+                0x9BECCE62836AC577, 0x4EE367F9430AEC32,
+                0xC2E801FB244576D5, 0x229C41F793CDA73F,
+                0xF3A20279ED56D48A, 0x6B43527578C1110F,
+                0x9845418C345644D6, 0x830A13896B78AAA9,
+                0xBE5691EF416BD60C, 0x23CC986BC656D553,
+                0xEDEC366B11C6CB8F, 0x2CBFBE86B7EC8AA8,
+                0x94B3A202EB1C3F39, 0x7BF7D71432F3D6A9,
+                0xB9E08A83A5E34F07, 0xDAF5CCD93FB0CC53,
+                0xE858AD248F5C22C9, 0xD1B3400F8F9CFF68,
+                0x91376C36D99995BE, 0x23100809B9C21FA1,
+                0xB58547448FFFFB2D, 0xABD40A0C2832A78A,
+                0xE2E69915B3FFF9F9, 0x16C90C8F323F516C,
+                0x8DD01FAD907FFC3B, 0xAE3DA7D97F6792E3,
+                0xB1442798F49FFB4A, 0x99CD11CFDF41779C,
+                0xDD95317F31C7FA1D, 0x40405643D711D583,
+                0x8A7D3EEF7F1CFC52, 0x482835EA666B2572,
+                0xAD1C8EAB5EE43B66, 0xDA3243650005EECF,
+                0xD863B256369D4A40, 0x90BED43E40076A82,
+                0x873E4F75E2224E68, 0x5A7744A6E804A291,
+                0xA90DE3535AAAE202, 0x711515D0A205CB36,
+                0xD3515C2831559A83, 0x0D5A5B44CA873E03,
+                0x8412D9991ED58091, 0xE858790AFE9486C2,
+                0xA5178FFF668AE0B6, 0x626E974DBE39A872,
+                0xCE5D73FF402D98E3, 0xFB0A3D212DC8128F,
+                0x80FA687F881C7F8E, 0x7CE66634BC9D0B99,
+                0xA139029F6A239F72, 0x1C1FFFC1EBC44E80,
+                0xC987434744AC874E, 0xA327FFB266B56220,
+                0xFBE9141915D7A922, 0x4BF1FF9F0062BAA8,
+                0x9D71AC8FADA6C9B5, 0x6F773FC3603DB4A9,
+                0xC4CE17B399107C22, 0xCB550FB4384D21D3,
+                0xF6019DA07F549B2B, 0x7E2A53A146606A48,
+                0x99C102844F94E0FB, 0x2EDA7444CBFC426D,
+                0xC0314325637A1939, 0xFA911155FEFB5308,
+                0xF03D93EEBC589F88, 0x793555AB7EBA27CA,
+                0x96267C7535B763B5, 0x4BC1558B2F3458DE,
+                0xBBB01B9283253CA2, 0x9EB1AAEDFB016F16,
+                0xEA9C227723EE8BCB, 0x465E15A979C1CADC,
+                0x92A1958A7675175F, 0x0BFACD89EC191EC9,
+                0xB749FAED14125D36, 0xCEF980EC671F667B,
+                0xE51C79A85916F484, 0x82B7E12780E7401A,
+                0x8F31CC0937AE58D2, 0xD1B2ECB8B0908810,
+                0xB2FE3F0B8599EF07, 0x861FA7E6DCB4AA15,
+                0xDFBDCECE67006AC9, 0x67A791E093E1D49A,
+                0x8BD6A141006042BD, 0xE0C8BB2C5C6D24E0,
+                0xAECC49914078536D, 0x58FAE9F773886E18,
+                0xDA7F5BF590966848, 0xAF39A475506A899E,
+                0x888F99797A5E012D, 0x6D8406C952429603,
+                0xAAB37FD7D8F58178, 0xC8E5087BA6D33B83,
+                0xD5605FCDCF32E1D6, 0xFB1E4A9A90880A64,
+                0x855C3BE0A17FCD26, 0x5CF2EEA09A55067F,
+                0xA6B34AD8C9DFC06F, 0xF42FAA48C0EA481E,
+                0xD0601D8EFC57B08B, 0xF13B94DAF124DA26,
+                0x823C12795DB6CE57, 0x76C53D08D6B70858,
+                0xA2CB1717B52481ED, 0x54768C4B0C64CA6E,
+                0xCB7DDCDDA26DA268, 0xA9942F5DCF7DFD09,
+                0xFE5D54150B090B02, 0xD3F93B35435D7C4C,
+                0x9EFA548D26E5A6E1, 0xC47BC5014A1A6DAF,
+                0xC6B8E9B0709F109A, 0x359AB6419CA1091B,
+                0xF867241C8CC6D4C0, 0xC30163D203C94B62,
+                0x9B407691D7FC44F8, 0x79E0DE63425DCF1D,
+                0xC21094364DFB5636, 0x985915FC12F542E4,
+                0xF294B943E17A2BC4, 0x3E6F5B7B17B2939D,
+                0x979CF3CA6CEC5B5A, 0xA705992CEECF9C42,
+                0xBD8430BD08277231, 0x50C6FF782A838353,
+                0xECE53CEC4A314EBD, 0xA4F8BF5635246428,
+                0x940F4613AE5ED136, 0x871B7795E136BE99,
+                0xB913179899F68584, 0x28E2557B59846E3F,
+                0xE757DD7EC07426E5, 0x331AEADA2FE589CF,
+                0x9096EA6F3848984F, 0x3FF0D2C85DEF7621,
+                0xB4BCA50B065ABE63, 0x0FED077A756B53A9,
+                0xE1EBCE4DC7F16DFB, 0xD3E8495912C62894,
+                0x8D3360F09CF6E4BD, 0x64712DD7ABBBD95C,
+                0xB080392CC4349DEC, 0xBD8D794D96AACFB3,
+                0xDCA04777F541C567, 0xECF0D7A0FC5583A0,
+                0x89E42CAAF9491B60, 0xF41686C49DB57244,
+                0xAC5D37D5B79B6239, 0x311C2875C522CED5,
+                0xD77485CB25823AC7, 0x7D633293366B828B,
+                0x86A8D39EF77164BC, 0xAE5DFF9C02033197,
+                0xA8530886B54DBDEB, 0xD9F57F830283FDFC,
+                0xD267CAA862A12D66, 0xD072DF63C324FD7B,
+                0x8380DEA93DA4BC60, 0x4247CB9E59F71E6D,
+                0xA46116538D0DEB78, 0x52D9BE85F074E608,
+                0xCD795BE870516656, 0x67902E276C921F8B,
+                0x806BD9714632DFF6, 0x00BA1CD8A3DB53B6,
+                0xA086CFCD97BF97F3, 0x80E8A40ECCD228A4,
+                0xC8A883C0FDAF7DF0, 0x6122CD128006B2CD,
+                0xFAD2A4B13D1B5D6C, 0x796B805720085F81,
+                0x9CC3A6EEC6311A63, 0xCBE3303674053BB0,
+                0xC3F490AA77BD60FC, 0xBEDBFC4411068A9C,
+                0xF4F1B4D515ACB93B, 0xEE92FB5515482D44,
+                0x991711052D8BF3C5, 0x751BDD152D4D1C4A,
+                0xBF5CD54678EEF0B6, 0xD262D45A78A0635D,
+                0xEF340A98172AACE4, 0x86FB897116C87C34,
+                0x9580869F0E7AAC0E, 0xD45D35E6AE3D4DA0,
+                0xBAE0A846D2195712, 0x8974836059CCA109,
+                0xE998D258869FACD7, 0x2BD1A438703FC94B,
+                0x91FF83775423CC06, 0x7B6306A34627DDCF,
+                0xB67F6455292CBF08, 0x1A3BC84C17B1D542,
+                0xE41F3D6A7377EECA, 0x20CABA5F1D9E4A93,
+                0x8E938662882AF53E, 0x547EB47B7282EE9C,
+                0xB23867FB2A35B28D, 0xE99E619A4F23AA43,
+                0xDEC681F9F4C31F31, 0x6405FA00E2EC94D4,
+                0x8B3C113C38F9F37E, 0xDE83BC408DD3DD04,
+                0xAE0B158B4738705E, 0x9624AB50B148D445,
+                0xD98DDAEE19068C76, 0x3BADD624DD9B0957,
+                0x87F8A8D4CFA417C9, 0xE54CA5D70A80E5D6,
+                0xA9F6D30A038D1DBC, 0x5E9FCF4CCD211F4C,
+                0xD47487CC8470652B, 0x7647C3200069671F,
+                0x84C8D4DFD2C63F3B, 0x29ECD9F40041E073,
+                0xA5FB0A17C777CF09, 0xF468107100525890,
+                0xCF79CC9DB955C2CC, 0x7182148D4066EEB4,
+                0x81AC1FE293D599BF, 0xC6F14CD848405530,
+                0xA21727DB38CB002F, 0xB8ADA00E5A506A7C,
+                0xCA9CF1D206FDC03B, 0xA6D90811F0E4851C,
+                0xFD442E4688BD304A, 0x908F4A166D1DA663,
+                0x9E4A9CEC15763E2E, 0x9A598E4E043287FE,
+                0xC5DD44271AD3CDBA, 0x40EFF1E1853F29FD,
+                0xF7549530E188C128, 0xD12BEE59E68EF47C,
+                0x9A94DD3E8CF578B9, 0x82BB74F8301958CE,
+                0xC13A148E3032D6E7, 0xE36A52363C1FAF01,
+                0xF18899B1BC3F8CA1, 0xDC44E6C3CB279AC1,
+                0x96F5600F15A7B7E5, 0x29AB103A5EF8C0B9,
+                0xBCB2B812DB11A5DE, 0x7415D448F6B6F0E7,
+                0xEBDF661791D60F56, 0x111B495B3464AD21,
+                0x936B9FCEBB25C995, 0xCAB10DD900BEEC34,
+                0xB84687C269EF3BFB, 0x3D5D514F40EEA742,
+                0xE65829B3046B0AFA, 0x0CB4A5A3112A5112,
+                0x8FF71A0FE2C2E6DC, 0x47F0E785EABA72AB,
+                0xB3F4E093DB73A093, 0x59ED216765690F56,
+                0xE0F218B8D25088B8, 0x306869C13EC3532C,
+                0x8C974F7383725573, 0x1E414218C73A13FB,
+                0xAFBD2350644EEACF, 0xE5D1929EF90898FA,
+                0xDBAC6C247D62A583, 0xDF45F746B74ABF39,
+                0x894BC396CE5DA772, 0x6B8BBA8C328EB783,
+                0xAB9EB47C81F5114F, 0x066EA92F3F326564,
+                0xD686619BA27255A2, 0xC80A537B0EFEFEBD,
+                0x8613FD0145877585, 0xBD06742CE95F5F36,
+                0xA798FC4196E952E7, 0x2C48113823B73704,
+                0xD17F3B51FCA3A7A0, 0xF75A15862CA504C5,
+                0x82EF85133DE648C4, 0x9A984D73DBE722FB,
+                0xA3AB66580D5FDAF5, 0xC13E60D0D2E0EBBA,
+                0xCC963FEE10B7D1B3, 0x318DF905079926A8,
+                0xFFBBCFE994E5C61F, 0xFDF17746497F7052,
+                0x9FD561F1FD0F9BD3, 0xFEB6EA8BEDEFA633,
+                0xC7CABA6E7C5382C8, 0xFE64A52EE96B8FC0,
+                0xF9BD690A1B68637B, 0x3DFDCE7AA3C673B0,
+                0x9C1661A651213E2D, 0x06BEA10CA65C084E,
+                0xC31BFA0FE5698DB8, 0x486E494FCFF30A62,
+                0xF3E2F893DEC3F126, 0x5A89DBA3C3EFCCFA,
+                0x986DDB5C6B3A76B7, 0xF89629465A75E01C,
+                0xBE89523386091465, 0xF6BBB397F1135823,
+                0xEE2BA6C0678B597F, 0x746AA07DED582E2C,
+                0x94DB483840B717EF, 0xA8C2A44EB4571CDC,
+                0xBA121A4650E4DDEB, 0x92F34D62616CE413,
+                0xE896A0D7E51E1566, 0x77B020BAF9C81D17,
+                0x915E2486EF32CD60, 0x0ACE1474DC1D122E,
+                0xB5B5ADA8AAFF80B8, 0x0D819992132456BA,
+                0xE3231912D5BF60E6, 0x10E1FFF697ED6C69,
+                0x8DF5EFABC5979C8F, 0xCA8D3FFA1EF463C1,
+                0xB1736B96B6FD83B3, 0xBD308FF8A6B17CB2,
+                0xDDD0467C64BCE4A0, 0xAC7CB3F6D05DDBDE,
+                0x8AA22C0DBEF60EE4, 0x6BCDF07A423AA96B,
+                0xAD4AB7112EB3929D, 0x86C16C98D2C953C6,
+                0xD89D64D57A607744, 0xE871C7BF077BA8B7,
+                0x87625F056C7C4A8B, 0x11471CD764AD4972,
+                0xA93AF6C6C79B5D2D, 0xD598E40D3DD89BCF,
+                0xD389B47879823479, 0x4AFF1D108D4EC2C3,
+                0x843610CB4BF160CB, 0xCEDF722A585139BA,
+                0xA54394FE1EEDB8FE, 0xC2974EB4EE658828,
+                0xCE947A3DA6A9273E, 0x733D226229FEEA32,
+                0x811CCC668829B887, 0x0806357D5A3F525F,
+                0xA163FF802A3426A8, 0xCA07C2DCB0CF26F7,
+                0xC9BCFF6034C13052, 0xFC89B393DD02F0B5,
+                0xFC2C3F3841F17C67, 0xBBAC2078D443ACE2,
+                0x9D9BA7832936EDC0, 0xD54B944B84AA4C0D,
+                0xC5029163F384A931, 0x0A9E795E65D4DF11,
+                0xF64335BCF065D37D, 0x4D4617B5FF4A16D5,
+                0x99EA0196163FA42E, 0x504BCED1BF8E4E45,
+                0xC06481FB9BCF8D39, 0xE45EC2862F71E1D6,
+                0xF07DA27A82C37088, 0x5D767327BB4E5A4C,
+                0x964E858C91BA2655, 0x3A6A07F8D510F86F,
+                0xBBE226EFB628AFEA, 0x890489F70A55368B,
+                0xEADAB0ABA3B2DBE5, 0x2B45AC74CCEA842E,
+                0x92C8AE6B464FC96F, 0x3B0B8BC90012929D,
+                0xB77ADA0617E3BBCB, 0x09CE6EBB40173744,
+                0xE55990879DDCAABD, 0xCC420A6A101D0515,
+                0x8F57FA54C2A9EAB6, 0x9FA946824A12232D,
+                0xB32DF8E9F3546564, 0x47939822DC96ABF9,
+                0xDFF9772470297EBD, 0x59787E2B93BC56F7,
+                0x8BFBEA76C619EF36, 0x57EB4EDB3C55B65A,
+                0xAEFAE51477A06B03, 0xEDE622920B6B23F1,
+                0xDAB99E59958885C4, 0xE95FAB368E45ECED,
+                0x88B402F7FD75539B, 0x11DBCB0218EBB414,
+                0xAAE103B5FCD2A881, 0xD652BDC29F26A119,
+                0xD59944A37C0752A2, 0x4BE76D3346F0495F,
+                0x857FCAE62D8493A5, 0x6F70A4400C562DDB,
+                0xA6DFBD9FB8E5B88E, 0xCB4CCD500F6BB952,
+                0xD097AD07A71F26B2, 0x7E2000A41346A7A7,
+                0x825ECC24C873782F, 0x8ED400668C0C28C8,
+                0xA2F67F2DFA90563B, 0x728900802F0F32FA,
+                0xCBB41EF979346BCA, 0x4F2B40A03AD2FFB9,
+                0xFEA126B7D78186BC, 0xE2F610C84987BFA8,
+                0x9F24B832E6B0F436, 0x0DD9CA7D2DF4D7C9,
+                0xC6EDE63FA05D3143, 0x91503D1C79720DBB,
+                0xF8A95FCF88747D94, 0x75A44C6397CE912A,
+                0x9B69DBE1B548CE7C, 0xC986AFBE3EE11ABA,
+                0xC24452DA229B021B, 0xFBE85BADCE996168,
+                0xF2D56790AB41C2A2, 0xFAE27299423FB9C3,
+                0x97C560BA6B0919A5, 0xDCCD879FC967D41A,
+                0xBDB6B8E905CB600F, 0x5400E987BBC1C920,
+                0xED246723473E3813, 0x290123E9AAB23B68,
+                0x9436C0760C86E30B, 0xF9A0B6720AAF6521,
+                0xB94470938FA89BCE, 0xF808E40E8D5B3E69,
+                0xE7958CB87392C2C2, 0xB60B1D1230B20E04,
+                0x90BD77F3483BB9B9, 0xB1C6F22B5E6F48C2,
+                0xB4ECD5F01A4AA828, 0x1E38AEB6360B1AF3,
+                0xE2280B6C20DD5232, 0x25C6DA63C38DE1B0,
+                0x8D590723948A535F, 0x579C487E5A38AD0E,
+                0xB0AF48EC79ACE837, 0x2D835A9DF0C6D851,
+                0xDCDB1B2798182244, 0xF8E431456CF88E65,
+                0x8A08F0F8BF0F156B, 0x1B8E9ECB641B58FF,
+                0xAC8B2D36EED2DAC5, 0xE272467E3D222F3F,
+                0xD7ADF884AA879177, 0x5B0ED81DCC6ABB0F,
+                0x86CCBB52EA94BAEA, 0x98E947129FC2B4E9,
+                0xA87FEA27A539E9A5, 0x3F2398D747B36224,
+                0xD29FE4B18E88640E, 0x8EEC7F0D19A03AAD,
+                0x83A3EEEEF9153E89, 0x1953CF68300424AC,
+                0xA48CEAAAB75A8E2B, 0x5FA8C3423C052DD7,
+                0xCDB02555653131B6, 0x3792F412CB06794D,
+                0x808E17555F3EBF11, 0xE2BBD88BBEE40BD0,
+                0xA0B19D2AB70E6ED6, 0x5B6ACEAEAE9D0EC4,
+                0xC8DE047564D20A8B, 0xF245825A5A445275,
+                0xFB158592BE068D2E, 0xEED6E2F0F0D56712,
+                0x9CED737BB6C4183D, 0x55464DD69685606B,
+                0xC428D05AA4751E4C, 0xAA97E14C3C26B886,
+                0xF53304714D9265DF, 0xD53DD99F4B3066A8,
+                0x993FE2C6D07B7FAB, 0xE546A8038EFE4029,
+                0xBF8FDB78849A5F96, 0xDE98520472BDD033,
+                0xEF73D256A5C0F77C, 0x963E66858F6D4440,
+                0x95A8637627989AAD, 0xDDE7001379A44AA8,
+                0xBB127C53B17EC159, 0x5560C018580D5D52,
+                0xE9D71B689DDE71AF, 0xAAB8F01E6E10B4A6,
+                0x9226712162AB070D, 0xCAB3961304CA70E8,
+                0xB6B00D69BB55C8D1, 0x3D607B97C5FD0D22,
+                0xE45C10C42A2B3B05, 0x8CB89A7DB77C506A,
+                0x8EB98A7A9A5B04E3, 0x77F3608E92ADB242,
+                0xB267ED1940F1C61C, 0x55F038B237591ED3,
+                0xDF01E85F912E37A3, 0x6B6C46DEC52F6688,
+                0x8B61313BBABCE2C6, 0x2323AC4B3B3DA015,
+                0xAE397D8AA96C1B77, 0xABEC975E0A0D081A,
+                0xD9C7DCED53C72255, 0x96E7BD358C904A21,
+                0x881CEA14545C7575, 0x7E50D64177DA2E54,
+                0xAA242499697392D2, 0xDDE50BD1D5D0B9E9,
+                0xD4AD2DBFC3D07787, 0x955E4EC64B44E864,
+                0x84EC3C97DA624AB4, 0xBD5AF13BEF0B113E,
+                0xA6274BBDD0FADD61, 0xECB1AD8AEACDD58E,
+                0xCFB11EAD453994BA, 0x67DE18EDA5814AF2,
+                0x81CEB32C4B43FCF4, 0x80EACF948770CED7,
+                0xA2425FF75E14FC31, 0xA1258379A94D028D,
+                0xCAD2F7F5359A3B3E, 0x096EE45813A04330,
+                0xFD87B5F28300CA0D, 0x8BCA9D6E188853FC,
+                0x9E74D1B791E07E48, 0x775EA264CF55347E,
+                0xC612062576589DDA, 0x95364AFE032A819E,
+                0xF79687AED3EEC551, 0x3A83DDBD83F52205,
+                0x9ABE14CD44753B52, 0xC4926A9672793543,
+                0xC16D9A0095928A27, 0x75B7053C0F178294,
+                0xF1C90080BAF72CB1, 0x5324C68B12DD6339,
+                0x971DA05074DA7BEE, 0xD3F6FC16EBCA5E04,
+                0xBCE5086492111AEA, 0x88F4BB1CA6BCF585,
+                0xEC1E4A7DB69561A5, 0x2B31E9E3D06C32E6,
+                0x9392EE8E921D5D07, 0x3AFF322E62439FD0,
+                0xB877AA3236A4B449, 0x09BEFEB9FAD487C3,
+                0xE69594BEC44DE15B, 0x4C2EBE687989A9B4,
+                0x901D7CF73AB0ACD9, 0x0F9D37014BF60A11,
+                0xB424DC35095CD80F, 0x538484C19EF38C95,
+                0xE12E13424BB40E13, 0x2865A5F206B06FBA,
+                0x8CBCCC096F5088CB, 0xF93F87B7442E45D4,
+                0xAFEBFF0BCB24AAFE, 0xF78F69A51539D749,
+                0xDBE6FECEBDEDD5BE, 0xB573440E5A884D1C,
+                0x89705F4136B4A597, 0x31680A88F8953031,
+                0xABCC77118461CEFC, 0xFDC20D2B36BA7C3E,
+                0xD6BF94D5E57A42BC, 0x3D32907604691B4D,
+                0x8637BD05AF6C69B5, 0xA63F9A49C2C1B110,
+                0xA7C5AC471B478423, 0x0FCF80DC33721D54,
+                0xD1B71758E219652B, 0xD3C36113404EA4A9,
+                0x83126E978D4FDF3B, 0x645A1CAC083126EA,
+                0xA3D70A3D70A3D70A, 0x3D70A3D70A3D70A4,
+                0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCD,
+                0x8000000000000000, 0x0000000000000000,
+                0xA000000000000000, 0x0000000000000000,
+                0xC800000000000000, 0x0000000000000000,
+                0xFA00000000000000, 0x0000000000000000,
+                0x9C40000000000000, 0x0000000000000000,
+                0xC350000000000000, 0x0000000000000000,
+                0xF424000000000000, 0x0000000000000000,
+                0x9896800000000000, 0x0000000000000000,
+                0xBEBC200000000000, 0x0000000000000000,
+                0xEE6B280000000000, 0x0000000000000000,
+                0x9502F90000000000, 0x0000000000000000,
+                0xBA43B74000000000, 0x0000000000000000,
+                0xE8D4A51000000000, 0x0000000000000000,
+                0x9184E72A00000000, 0x0000000000000000,
+                0xB5E620F480000000, 0x0000000000000000,
+                0xE35FA931A0000000, 0x0000000000000000,
+                0x8E1BC9BF04000000, 0x0000000000000000,
+                0xB1A2BC2EC5000000, 0x0000000000000000,
+                0xDE0B6B3A76400000, 0x0000000000000000,
+                0x8AC7230489E80000, 0x0000000000000000,
+                0xAD78EBC5AC620000, 0x0000000000000000,
+                0xD8D726B7177A8000, 0x0000000000000000,
+                0x878678326EAC9000, 0x0000000000000000,
+                0xA968163F0A57B400, 0x0000000000000000,
+                0xD3C21BCECCEDA100, 0x0000000000000000,
+                0x84595161401484A0, 0x0000000000000000,
+                0xA56FA5B99019A5C8, 0x0000000000000000,
+                0xCECB8F27F4200F3A, 0x0000000000000000,
+                0x813F3978F8940984, 0x4000000000000000,
+                0xA18F07D736B90BE5, 0x5000000000000000,
+                0xC9F2C9CD04674EDE, 0xA400000000000000,
+                0xFC6F7C4045812296, 0x4D00000000000000,
+                0x9DC5ADA82B70B59D, 0xF020000000000000,
+                0xC5371912364CE305, 0x6C28000000000000,
+                0xF684DF56C3E01BC6, 0xC732000000000000,
+                0x9A130B963A6C115C, 0x3C7F400000000000,
+                0xC097CE7BC90715B3, 0x4B9F100000000000,
+                0xF0BDC21ABB48DB20, 0x1E86D40000000000,
+                0x96769950B50D88F4, 0x1314448000000000,
+                0xBC143FA4E250EB31, 0x17D955A000000000,
+                0xEB194F8E1AE525FD, 0x5DCFAB0800000000,
+                0x92EFD1B8D0CF37BE, 0x5AA1CAE500000000,
+                0xB7ABC627050305AD, 0xF14A3D9E40000000,
+                0xE596B7B0C643C719, 0x6D9CCD05D0000000,
+                0x8F7E32CE7BEA5C6F, 0xE4820023A2000000,
+                0xB35DBF821AE4F38B, 0xDDA2802C8A800000,
+                0xE0352F62A19E306E, 0xD50B2037AD200000,
+                0x8C213D9DA502DE45, 0x4526F422CC340000,
+                0xAF298D050E4395D6, 0x9670B12B7F410000,
+                0xDAF3F04651D47B4C, 0x3C0CDD765F114000,
+                0x88D8762BF324CD0F, 0xA5880A69FB6AC800,
+                0xAB0E93B6EFEE0053, 0x8EEA0D047A457A00,
+                0xD5D238A4ABE98068, 0x72A4904598D6D880,
+                0x85A36366EB71F041, 0x47A6DA2B7F864750,
+                0xA70C3C40A64E6C51, 0x999090B65F67D924,
+                0xD0CF4B50CFE20765, 0xFFF4B4E3F741CF6D,
+                0x82818F1281ED449F, 0xBFF8F10E7A8921A4,
+                0xA321F2D7226895C7, 0xAFF72D52192B6A0D,
+                0xCBEA6F8CEB02BB39, 0x9BF4F8A69F764490,
+                0xFEE50B7025C36A08, 0x02F236D04753D5B4,
+                0x9F4F2726179A2245, 0x01D762422C946590,
+                0xC722F0EF9D80AAD6, 0x424D3AD2B7B97EF5,
+                0xF8EBAD2B84E0D58B, 0xD2E0898765A7DEB2,
+                0x9B934C3B330C8577, 0x63CC55F49F88EB2F,
+                0xC2781F49FFCFA6D5, 0x3CBF6B71C76B25FB,
+                0xF316271C7FC3908A, 0x8BEF464E3945EF7A,
+                0x97EDD871CFDA3A56, 0x97758BF0E3CBB5AC,
+                0xBDE94E8E43D0C8EC, 0x3D52EEED1CBEA317,
+                0xED63A231D4C4FB27, 0x4CA7AAA863EE4BDD,
+                0x945E455F24FB1CF8, 0x8FE8CAA93E74EF6A,
+                0xB975D6B6EE39E436, 0xB3E2FD538E122B44,
+                0xE7D34C64A9C85D44, 0x60DBBCA87196B616,
+                0x90E40FBEEA1D3A4A, 0xBC8955E946FE31CD,
+                0xB51D13AEA4A488DD, 0x6BABAB6398BDBE41,
+                0xE264589A4DCDAB14, 0xC696963C7EED2DD1,
+                0x8D7EB76070A08AEC, 0xFC1E1DE5CF543CA2,
+                0xB0DE65388CC8ADA8, 0x3B25A55F43294BCB,
+                0xDD15FE86AFFAD912, 0x49EF0EB713F39EBE,
+                0x8A2DBF142DFCC7AB, 0x6E3569326C784337,
+                0xACB92ED9397BF996, 0x49C2C37F07965404,
+                0xD7E77A8F87DAF7FB, 0xDC33745EC97BE906,
+                0x86F0AC99B4E8DAFD, 0x69A028BB3DED71A3,
+                0xA8ACD7C0222311BC, 0xC40832EA0D68CE0C,
+                0xD2D80DB02AABD62B, 0xF50A3FA490C30190,
+                0x83C7088E1AAB65DB, 0x792667C6DA79E0FA,
+                0xA4B8CAB1A1563F52, 0x577001B891185938,
+                0xCDE6FD5E09ABCF26, 0xED4C0226B55E6F86,
+                0x80B05E5AC60B6178, 0x544F8158315B05B4,
+                0xA0DC75F1778E39D6, 0x696361AE3DB1C721,
+                0xC913936DD571C84C, 0x03BC3A19CD1E38E9,
+                0xFB5878494ACE3A5F, 0x04AB48A04065C723,
+                0x9D174B2DCEC0E47B, 0x62EB0D64283F9C76,
+                0xC45D1DF942711D9A, 0x3BA5D0BD324F8394,
+                0xF5746577930D6500, 0xCA8F44EC7EE36479,
+                0x9968BF6ABBE85F20, 0x7E998B13CF4E1ECB,
+                0xBFC2EF456AE276E8, 0x9E3FEDD8C321A67E,
+                0xEFB3AB16C59B14A2, 0xC5CFE94EF3EA101E,
+                0x95D04AEE3B80ECE5, 0xBBA1F1D158724A12,
+                0xBB445DA9CA61281F, 0x2A8A6E45AE8EDC97,
+                0xEA1575143CF97226, 0xF52D09D71A3293BD,
+                0x924D692CA61BE758, 0x593C2626705F9C56,
+                0xB6E0C377CFA2E12E, 0x6F8B2FB00C77836C,
+                0xE498F455C38B997A, 0x0B6DFB9C0F956447,
+                0x8EDF98B59A373FEC, 0x4724BD4189BD5EAC,
+                0xB2977EE300C50FE7, 0x58EDEC91EC2CB657,
+                0xDF3D5E9BC0F653E1, 0x2F2967B66737E3ED,
+                0x8B865B215899F46C, 0xBD79E0D20082EE74,
+                0xAE67F1E9AEC07187, 0xECD8590680A3AA11,
+                0xDA01EE641A708DE9, 0xE80E6F4820CC9495,
+                0x884134FE908658B2, 0x3109058D147FDCDD,
+                0xAA51823E34A7EEDE, 0xBD4B46F0599FD415,
+                0xD4E5E2CDC1D1EA96, 0x6C9E18AC7007C91A,
+                0x850FADC09923329E, 0x03E2CF6BC604DDB0,
+                0xA6539930BF6BFF45, 0x84DB8346B786151C,
+                0xCFE87F7CEF46FF16, 0xE612641865679A63,
+                0x81F14FAE158C5F6E, 0x4FCB7E8F3F60C07E,
+                0xA26DA3999AEF7749, 0xE3BE5E330F38F09D,
+                0xCB090C8001AB551C, 0x5CADF5BFD3072CC5,
+                0xFDCB4FA002162A63, 0x73D9732FC7C8F7F6,
+                0x9E9F11C4014DDA7E, 0x2867E7FDDCDD9AFA,
+                0xC646D63501A1511D, 0xB281E1FD541501B8,
+                0xF7D88BC24209A565, 0x1F225A7CA91A4226,
+                0x9AE757596946075F, 0x3375788DE9B06958,
+                0xC1A12D2FC3978937, 0x0052D6B1641C83AE,
+                0xF209787BB47D6B84, 0xC0678C5DBD23A49A,
+                0x9745EB4D50CE6332, 0xF840B7BA963646E0,
+                0xBD176620A501FBFF, 0xB650E5A93BC3D898,
+                0xEC5D3FA8CE427AFF, 0xA3E51F138AB4CEBE,
+                0x93BA47C980E98CDF, 0xC66F336C36B10137,
+                0xB8A8D9BBE123F017, 0xB80B0047445D4184,
+                0xE6D3102AD96CEC1D, 0xA60DC059157491E5,
+                0x9043EA1AC7E41392, 0x87C89837AD68DB2F,
+                0xB454E4A179DD1877, 0x29BABE4598C311FB,
+                0xE16A1DC9D8545E94, 0xF4296DD6FEF3D67A,
+                0x8CE2529E2734BB1D, 0x1899E4A65F58660C,
+                0xB01AE745B101E9E4, 0x5EC05DCFF72E7F8F,
+                0xDC21A1171D42645D, 0x76707543F4FA1F73,
+                0x899504AE72497EBA, 0x6A06494A791C53A8,
+                0xABFA45DA0EDBDE69, 0x0487DB9D17636892,
+                0xD6F8D7509292D603, 0x45A9D2845D3C42B6,
+                0x865B86925B9BC5C2, 0x0B8A2392BA45A9B2,
+                0xA7F26836F282B732, 0x8E6CAC7768D7141E,
+                0xD1EF0244AF2364FF, 0x3207D795430CD926,
+                0x8335616AED761F1F, 0x7F44E6BD49E807B8,
+                0xA402B9C5A8D3A6E7, 0x5F16206C9C6209A6,
+                0xCD036837130890A1, 0x36DBA887C37A8C0F,
+                0x802221226BE55A64, 0xC2494954DA2C9789,
+                0xA02AA96B06DEB0FD, 0xF2DB9BAA10B7BD6C,
+                0xC83553C5C8965D3D, 0x6F92829494E5ACC7,
+                0xFA42A8B73ABBF48C, 0xCB772339BA1F17F9,
+                0x9C69A97284B578D7, 0xFF2A760414536EFB,
+                0xC38413CF25E2D70D, 0xFEF5138519684ABA,
+                0xF46518C2EF5B8CD1, 0x7EB258665FC25D69,
+                0x98BF2F79D5993802, 0xEF2F773FFBD97A61,
+                0xBEEEFB584AFF8603, 0xAAFB550FFACFD8FA,
+                0xEEAABA2E5DBF6784, 0x95BA2A53F983CF38,
+                0x952AB45CFA97A0B2, 0xDD945A747BF26183,
+                0xBA756174393D88DF, 0x94F971119AEEF9E4,
+                0xE912B9D1478CEB17, 0x7A37CD5601AAB85D,
+                0x91ABB422CCB812EE, 0xAC62E055C10AB33A,
+                0xB616A12B7FE617AA, 0x577B986B314D6009,
+                0xE39C49765FDF9D94, 0xED5A7E85FDA0B80B,
+                0x8E41ADE9FBEBC27D, 0x14588F13BE847307,
+                0xB1D219647AE6B31C, 0x596EB2D8AE258FC8,
+                0xDE469FBD99A05FE3, 0x6FCA5F8ED9AEF3BB,
+                0x8AEC23D680043BEE, 0x25DE7BB9480D5854,
+                0xADA72CCC20054AE9, 0xAF561AA79A10AE6A,
+                0xD910F7FF28069DA4, 0x1B2BA1518094DA04,
+                0x87AA9AFF79042286, 0x90FB44D2F05D0842,
+                0xA99541BF57452B28, 0x353A1607AC744A53,
+                0xD3FA922F2D1675F2, 0x42889B8997915CE8,
+                0x847C9B5D7C2E09B7, 0x69956135FEBADA11,
+                0xA59BC234DB398C25, 0x43FAB9837E699095,
+                0xCF02B2C21207EF2E, 0x94F967E45E03F4BB,
+                0x8161AFB94B44F57D, 0x1D1BE0EEBAC278F5,
+                0xA1BA1BA79E1632DC, 0x6462D92A69731732,
+                0xCA28A291859BBF93, 0x7D7B8F7503CFDCFE,
+                0xFCB2CB35E702AF78, 0x5CDA735244C3D43E,
+                0x9DEFBF01B061ADAB, 0x3A0888136AFA64A7,
+                0xC56BAEC21C7A1916, 0x088AAA1845B8FDD0,
+                0xF6C69A72A3989F5B, 0x8AAD549E57273D45,
+                0x9A3C2087A63F6399, 0x36AC54E2F678864B,
+                0xC0CB28A98FCF3C7F, 0x84576A1BB416A7DD,
+                0xF0FDF2D3F3C30B9F, 0x656D44A2A11C51D5,
+                0x969EB7C47859E743, 0x9F644AE5A4B1B325,
+                0xBC4665B596706114, 0x873D5D9F0DDE1FEE,
+                0xEB57FF22FC0C7959, 0xA90CB506D155A7EA,
+                0x9316FF75DD87CBD8, 0x09A7F12442D588F2,
+                0xB7DCBF5354E9BECE, 0x0C11ED6D538AEB2F,
+                0xE5D3EF282A242E81, 0x8F1668C8A86DA5FA,
+                0x8FA475791A569D10, 0xF96E017D694487BC,
+                0xB38D92D760EC4455, 0x37C981DCC395A9AC,
+                0xE070F78D3927556A, 0x85BBE253F47B1417,
+                0x8C469AB843B89562, 0x93956D7478CCEC8E,
+                0xAF58416654A6BABB, 0x387AC8D1970027B2,
+                0xDB2E51BFE9D0696A, 0x06997B05FCC0319E,
+                0x88FCF317F22241E2, 0x441FECE3BDF81F03,
+                0xAB3C2FDDEEAAD25A, 0xD527E81CAD7626C3,
+                0xD60B3BD56A5586F1, 0x8A71E223D8D3B074,
+                0x85C7056562757456, 0xF6872D5667844E49,
+                0xA738C6BEBB12D16C, 0xB428F8AC016561DB,
+                0xD106F86E69D785C7, 0xE13336D701BEBA52,
+                0x82A45B450226B39C, 0xECC0024661173473,
+                0xA34D721642B06084, 0x27F002D7F95D0190,
+                0xCC20CE9BD35C78A5, 0x31EC038DF7B441F4,
+                0xFF290242C83396CE, 0x7E67047175A15271,
+                0x9F79A169BD203E41, 0x0F0062C6E984D386,
+                0xC75809C42C684DD1, 0x52C07B78A3E60868,
+                0xF92E0C3537826145, 0xA7709A56CCDF8A82,
+                0x9BBCC7A142B17CCB, 0x88A66076400BB691,
+                0xC2ABF989935DDBFE, 0x6ACFF893D00EA435,
+                0xF356F7EBF83552FE, 0x0583F6B8C4124D43,
+                0x98165AF37B2153DE, 0xC3727A337A8B704A,
+                0xBE1BF1B059E9A8D6, 0x744F18C0592E4C5C,
+                0xEDA2EE1C7064130C, 0x1162DEF06F79DF73,
+                0x9485D4D1C63E8BE7, 0x8ADDCB5645AC2BA8,
+                0xB9A74A0637CE2EE1, 0x6D953E2BD7173692,
+                0xE8111C87C5C1BA99, 0xC8FA8DB6CCDD0437,
+                0x910AB1D4DB9914A0, 0x1D9C9892400A22A2,
+                0xB54D5E4A127F59C8, 0x2503BEB6D00CAB4B,
+                0xE2A0B5DC971F303A, 0x2E44AE64840FD61D,
+                0x8DA471A9DE737E24, 0x5CEAECFED289E5D2,
+                0xB10D8E1456105DAD, 0x7425A83E872C5F47,
+                0xDD50F1996B947518, 0xD12F124E28F77719,
+                0x8A5296FFE33CC92F, 0x82BD6B70D99AAA6F,
+                0xACE73CBFDC0BFB7B, 0x636CC64D1001550B,
+                0xD8210BEFD30EFA5A, 0x3C47F7E05401AA4E,
+                0x8714A775E3E95C78, 0x65ACFAEC34810A71,
+                0xA8D9D1535CE3B396, 0x7F1839A741A14D0D,
+                0xD31045A8341CA07C, 0x1EDE48111209A050,
+                0x83EA2B892091E44D, 0x934AED0AAB460432,
+                0xA4E4B66B68B65D60, 0xF81DA84D5617853F,
+                0xCE1DE40642E3F4B9, 0x36251260AB9D668E,
+                0x80D2AE83E9CE78F3, 0xC1D72B7C6B426019,
+                0xA1075A24E4421730, 0xB24CF65B8612F81F,
+                0xC94930AE1D529CFC, 0xDEE033F26797B627,
+                0xFB9B7CD9A4A7443C, 0x169840EF017DA3B1,
+                0x9D412E0806E88AA5, 0x8E1F289560EE864E,
+                0xC491798A08A2AD4E, 0xF1A6F2BAB92A27E2,
+                0xF5B5D7EC8ACB58A2, 0xAE10AF696774B1DB,
+                0x9991A6F3D6BF1765, 0xACCA6DA1E0A8EF29,
+                0xBFF610B0CC6EDD3F, 0x17FD090A58D32AF3,
+                0xEFF394DCFF8A948E, 0xDDFC4B4CEF07F5B0,
+                0x95F83D0A1FB69CD9, 0x4ABDAF101564F98E,
+                0xBB764C4CA7A4440F, 0x9D6D1AD41ABE37F1,
+                0xEA53DF5FD18D5513, 0x84C86189216DC5ED,
+                0x92746B9BE2F8552C, 0x32FD3CF5B4E49BB4,
+                0xB7118682DBB66A77, 0x3FBC8C33221DC2A1,
+                0xE4D5E82392A40515, 0x0FABAF3FEAA5334A,
+                0x8F05B1163BA6832D, 0x29CB4D87F2A7400E,
+                0xB2C71D5BCA9023F8, 0x743E20E9EF511012,
+                0xDF78E4B2BD342CF6, 0x914DA9246B255416,
+                0x8BAB8EEFB6409C1A, 0x1AD089B6C2F7548E,
+                0xAE9672ABA3D0C320, 0xA184AC2473B529B1,
+                0xDA3C0F568CC4F3E8, 0xC9E5D72D90A2741E,
+                0x8865899617FB1871, 0x7E2FA67C7A658892,
+                0xAA7EEBFB9DF9DE8D, 0xDDBB901B98FEEAB7,
+                0xD51EA6FA85785631, 0x552A74227F3EA565,
+                0x8533285C936B35DE, 0xD53A88958F87275F,
+                0xA67FF273B8460356, 0x8A892ABAF368F137,
+                0xD01FEF10A657842C, 0x2D2B7569B0432D85,
+                0x8213F56A67F6B29B, 0x9C3B29620E29FC73,
+                0xA298F2C501F45F42, 0x8349F3BA91B47B8F,
+                0xCB3F2F7642717713, 0x241C70A936219A73,
+                0xFE0EFB53D30DD4D7, 0xED238CD383AA0110,
+                0x9EC95D1463E8A506, 0xF4363804324A40AA,
+                0xC67BB4597CE2CE48, 0xB143C6053EDCD0D5,
+                0xF81AA16FDC1B81DA, 0xDD94B7868E94050A,
+                0x9B10A4E5E9913128, 0xCA7CF2B4191C8326,
+                0xC1D4CE1F63F57D72, 0xFD1C2F611F63A3F0,
+                0xF24A01A73CF2DCCF, 0xBC633B39673C8CEC,
+                0x976E41088617CA01, 0xD5BE0503E085D813,
+                0xBD49D14AA79DBC82, 0x4B2D8644D8A74E18,
+                0xEC9C459D51852BA2, 0xDDF8E7D60ED1219E,
+                0x93E1AB8252F33B45, 0xCABB90E5C942B503,
+                0xB8DA1662E7B00A17, 0x3D6A751F3B936243,
+                0xE7109BFBA19C0C9D, 0x0CC512670A783AD4,
+                0x906A617D450187E2, 0x27FB2B80668B24C5,
+                0xB484F9DC9641E9DA, 0xB1F9F660802DEDF6,
+                0xE1A63853BBD26451, 0x5E7873F8A0396973,
+                0x8D07E33455637EB2, 0xDB0B487B6423E1E8,
+                0xB049DC016ABC5E5F, 0x91CE1A9A3D2CDA62,
+                0xDC5C5301C56B75F7, 0x7641A140CC7810FB,
+                0x89B9B3E11B6329BA, 0xA9E904C87FCB0A9D,
+                0xAC2820D9623BF429, 0x546345FA9FBDCD44,
+                0xD732290FBACAF133, 0xA97C177947AD4095,
+                0x867F59A9D4BED6C0, 0x49ED8EABCCCC485D,
+                0xA81F301449EE8C70, 0x5C68F256BFFF5A74,
+                0xD226FC195C6A2F8C, 0x73832EEC6FFF3111,
+                0x83585D8FD9C25DB7, 0xC831FD53C5FF7EAB,
+                0xA42E74F3D032F525, 0xBA3E7CA8B77F5E55,
+                0xCD3A1230C43FB26F, 0x28CE1BD2E55F35EB,
+                0x80444B5E7AA7CF85, 0x7980D163CF5B81B3,
+                0xA0555E361951C366, 0xD7E105BCC332621F,
+                0xC86AB5C39FA63440, 0x8DD9472BF3FEFAA7,
+                0xFA856334878FC150, 0xB14F98F6F0FEB951,
+                0x9C935E00D4B9D8D2, 0x6ED1BF9A569F33D3,
+                0xC3B8358109E84F07, 0x0A862F80EC4700C8,
+                0xF4A642E14C6262C8, 0xCD27BB612758C0FA,
+                0x98E7E9CCCFBD7DBD, 0x8038D51CB897789C,
+                0xBF21E44003ACDD2C, 0xE0470A63E6BD56C3,
+                0xEEEA5D5004981478, 0x1858CCFCE06CAC74,
+                0x95527A5202DF0CCB, 0x0F37801E0C43EBC8,
+                0xBAA718E68396CFFD, 0xD30560258F54E6BA,
+                0xE950DF20247C83FD, 0x47C6B82EF32A2069,
+                0x91D28B7416CDD27E, 0x4CDC331D57FA5441,
+                0xB6472E511C81471D, 0xE0133FE4ADF8E952,
+                0xE3D8F9E563A198E5, 0x58180FDDD97723A6,
+                0x8E679C2F5E44FF8F, 0x570F09EAA7EA7648
+            };
+
+            if (mantissa == 0 || exponent < smallestPower) {
+                value = negative ? -0.0 : 0.0;
+                return true;
+            }
+            if (exponent > largestPower) {
+                value = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+                return true;
+            }
+            if (FLT_EVAL_METHOD == 0 && exponent >= -22 && exponent <= 22 && mantissa <= (uint64_t(1) << 53)) {
+                value = static_cast<double>(mantissa);
+                if (exponent < 0) {
+                    value /= exactPow10s[-exponent];
                 } else {
-                    ThrowSyntaxExcept("JSON Object elements must be separated by \',\'", jsonText, pos);
+                    value *= exactPow10s[exponent];
                 }
+                if (negative) {
+                    value = -value;
+                }
+                return true;
             }
-            if (pos >= jsonText.size()) {
-                ThrowSyntaxExcept("JSON Object must end with \'}\'", jsonText, beginPos);
+
+            auto binaryExponent = (((152170 + 65536) * exponent) >> 16) + 1024 + 63;
+            auto leadingZero = CountLeadingZero(mantissa);
+            mantissa <<= leadingZero;
+
+            auto index = static_cast<size_t>(exponent - smallestPower) * 2;
+            uint64_t lower = 0;
+            auto upper = MultiplyFull(mantissa, powersOfFive[index], lower);
+            if ((upper & 0x1FF) == 0x1FF && (lower + mantissa) < lower) {
+                uint64_t secondLower = 0;
+                auto secondUpper = MultiplyFull(mantissa, powersOfFive[index + 1], secondLower);
+                lower += secondUpper;
+                if (secondUpper > lower) {
+                    upper++;
+                }
+                if ((upper & 0x1FF) == 0x1FF && (lower + 1) == 0 && (secondLower + mantissa) < secondLower) {
+                    return false;
+                }
             }
 
-            Result<JSONObject> objectResult{};
-            objectResult.resultVal = JSONObject(std::move(data), std::move(order));
-            objectResult.endPos = pos + 1;
-            return objectResult;
+            auto upperBit = upper >> 63;
+            auto significand = upper >> (upperBit + 9);
+            leadingZero += static_cast<int>(1 ^ upperBit);
+            if (lower == 0 && (upper & 0x1FF) == 0 && (significand & 3) == 1) {
+                return false;
+            }
+            significand += (significand & 1);
+            significand >>= 1;
+            if (significand >= (uint64_t(1) << 53)) {
+                significand = uint64_t(1) << 52;
+                leadingZero--;
+            }
+            significand &= ~(uint64_t(1) << 52);
+
+            auto realExponent = binaryExponent - leadingZero;
+            if (realExponent < 1 || realExponent > 2046) {
+                return false;
+            }
+            auto bits = significand | (static_cast<uint64_t>(realExponent) << 52) | (static_cast<uint64_t>(negative) << 63);
+            std::memcpy(std::addressof(value), std::addressof(bits), sizeof(value));
+            return true;
         }
-    }
 
-    inline JSONItem::JSONItem() :
-        type_(ItemType::ITEM_NULL),
-        value_(ItemNull())
-    { }
+        // strtod with the decimal point of the current locale, for inputs ComputeDouble can not decide.
+        inline double ParseDoubleFallback(std::string_view numberText)
+        {
+            char buffer[128]{};
+            std::string longText{};
+            char* text = buffer;
+            if (numberText.size() < sizeof(buffer)) {
+                std::memcpy(buffer, numberText.data(), numberText.size());
+            } else {
+                longText.assign(numberText.data(), numberText.size());
+                text = longText.data();
+            }
 
-    inline JSONItem::JSONItem(ItemNull _null) :
-        type_(ItemType::ITEM_NULL),
-        value_(ItemNull())
-    {
-        (void)_null;
-    }
+            auto decimalPoint = std::localeconv()->decimal_point[0];
+            if (decimalPoint != '.') {
+                auto point = std::strchr(text, '.');
+                if (point != nullptr) {
+                    *point = decimalPoint;
+                }
+            }
+            return std::strtod(text, nullptr);
+        }
 
-    inline JSONItem::JSONItem(bool value) :
-        type_(ItemType::BOOLEAN),
-        value_(value)
-    { }
+        struct Number
+        {
+            bool isDouble;
+            int64_t integer;
+            double number;
+        };
 
-    inline JSONItem::JSONItem(int value) :
-        type_(ItemType::INTEGER),
-        value_(value)
-    { }
-
-    inline JSONItem::JSONItem(int64_t value) :
-        type_(ItemType::LONG),
-        value_(value)
-    { }
-
-    inline JSONItem::JSONItem(double value) :
-        type_(ItemType::DOUBLE),
-        value_(value)
-    { }
-
-    inline JSONItem::JSONItem(const char* value) :
-        type_(ItemType::STRING),
-        value_(std::string(value))
-    { }
-
-    inline JSONItem::JSONItem(const std::string &value) :
-        type_(ItemType::STRING),
-        value_(value)
-    { }
+        // Parses the number at beginPos and returns its end position, or npos if it is malformed.
+        // Integers that do not fit in int64_t and numbers with a fraction or an exponent are doubles.
+        inline size_t ParseNumber(std::string_view text, size_t beginPos, Number &number)
+        {
+            static const auto isDigit = [](char ch) -> bool {
+                return (ch >= '0' && ch <= '9');
+            };
 
-    inline JSONItem::JSONItem(const JSONArray &value) :
-        type_(ItemType::ARRAY),
-        value_(new JSONArray(value))
-    { }
+            auto data = text.data();
+            auto size = text.size();
+            auto pos = beginPos;
+            bool negative = false;
+            if (pos < size && (data[pos] == '-' || data[pos] == '+')) {
+                negative = (data[pos] == '-');
+                pos++;
+            }
 
-    inline JSONItem::JSONItem(const JSONObject &value) :
-        type_(ItemType::OBJECT),
-        value_(new JSONObject(value))
-    { }
+            uint64_t mantissa = 0;
+            auto integerPos = pos;
+            while (pos < size && data[pos] == '0') {
+                pos++;
+            }
+            auto significantPos = pos;
+            while ((pos + 8) <= size && IsEightDigits(LoadEightChars(data + pos))) {
+                mantissa = (mantissa * 100000000) + ParseEightDigits(LoadEightChars(data + pos));
+                pos += 8;
+            }
+            while (pos < size && isDigit(data[pos])) {
+                mantissa = (mantissa * 10) + (data[pos] - '0');
+                pos++;
+            }
+            if (pos == integerPos) {
+                return std::string_view::npos;
+            }
+            auto digitCount = pos - significantPos;
+
+            int64_t exponent = 0;
+            bool isDouble = false;
+            if (pos < size && data[pos] == '.') {
+                isDouble = true;
+                pos++;
+                auto fractionPos = pos;
+                if (digitCount == 0) {
+                    while (pos < size && data[pos] == '0') {
+                        pos++;
+                    }
+                }
+                significantPos = pos;
+                while ((pos + 8) <= size && IsEightDigits(LoadEightChars(data + pos))) {
+                    mantissa = (mantissa * 100000000) + ParseEightDigits(LoadEightChars(data + pos));
+                    pos += 8;
+                }
+                while (pos < size && isDigit(data[pos])) {
+                    mantissa = (mantissa * 10) + (data[pos] - '0');
+                    pos++;
+                }
+                digitCount += pos - significantPos;
+                exponent -= static_cast<int64_t>(pos - fractionPos);
+            }
+            if (pos < size && (data[pos] == 'e' || data[pos] == 'E')) {
+                isDouble = true;
+                pos++;
+                bool negativeExponent = false;
+                if (pos < size && (data[pos] == '-' || data[pos] == '+')) {
+                    negativeExponent = (data[pos] == '-');
+                    pos++;
+                }
+                auto exponentPos = pos;
+                int64_t exponentVal = 0;
+                while (pos < size && isDigit(data[pos])) {
+                    if (exponentVal < 0x10000000) {
+                        exponentVal = (exponentVal * 10) + (data[pos] - '0');
+                    }
+                    pos++;
+                }
+                if (pos == exponentPos) {
+                    return std::string_view::npos;
+                }
+                exponent += negativeExponent ? -exponentVal : exponentVal;
+            }
+            if (pos < size) {
+                switch (data[pos]) {
+                    case '-':
+                    case '+':
+                    case '.':
+                    case 'e':
+                    case 'E':
+                        return std::string_view::npos;
+                    default:
+                        break;
+                }
+            }
 
-    inline JSONItem::JSONItem(const JSONItem &other) : type_(other.type_), value_()
-    {
-        const auto &other_value = other.value_;
-        if (type_ == ItemType::ARRAY) {
-            const auto &jsonArray = *(std::get<JSONArray*>(other_value));
-            value_ = new JSONArray(jsonArray);
-        } else if (type_ == ItemType::OBJECT) {
-            const auto &jsonObject = *(std::get<JSONObject*>(other_value));
-            value_ = new JSONObject(jsonObject);
-        } else {
-            value_ = other_value;
+            if (digitCount <= 19) {
+                if (!isDouble) {
+                    if (!negative && mantissa <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                        number = {false, static_cast<int64_t>(mantissa), 0};
+                        return pos;
+                    } else if (negative && mantissa <= (uint64_t(1) << 63)) {
+                        number = {false, static_cast<int64_t>(uint64_t(0) - mantissa), 0};
+                        return pos;
+                    }
+                }
+                double value = 0;
+                if (ComputeDouble(mantissa, exponent, negative, value)) {
+                    number = {true, 0, value};
+                    return pos;
+                }
+            }
+            number = {true, 0, ParseDoubleFallback(text.substr(beginPos, (pos - beginPos)))};
+            return pos;
         }
     }
 
-    inline JSONItem::JSONItem(JSONItem &&other) noexcept : type_(other.type_), value_(std::move(other.value_)) 
+    // Serializes JSON items in a single pass, into a std::string, a FILE* or a callback sink.
+    // A std::string target holds unfinished output until flush() or destruction of the writer.
+    // A failed write to the FILE* stops further output and is thrown by flush(), the destructor 
+    // flushes without throwing, so call flush() to learn whether everything was written.
+    class JSONWriter
     {
-        other.type_ = ItemType::ITEM_NULL;
-        other.value_ = ItemValue();
-    }
+        public:
+            typedef std::function<void(const char*, size_t)> Sink;
+
+            inline JSONWriter(std::string &output);
+            inline JSONWriter(std::FILE* fp);
+            inline JSONWriter(const Sink &sink);
+            inline ~JSONWriter();
+
+            JSONWriter(const JSONWriter &other) = delete;
+            JSONWriter &operator=(const JSONWriter &other) = delete;
+
+            inline void write(const JSONItem &item);
+            inline void write(const JSONArray &array);
+            inline void write(const JSONObject &object);
+            inline void writeFormated(const JSONObject &object);
+            inline void writeNull();
+            inline void writeBoolean(bool value);
+            inline void writeInt(int value);
+            inline void writeLong(int64_t value);
+            inline void writeDouble(double value);
+            inline void writeString(std::string_view value);
+            inline void writeRaw(std::string_view text);
+            inline void flush();
+            inline size_t size() const noexcept;
 
-    inline JSONItem::~JSONItem()
-    {
-        if (type_ == ItemType::ARRAY) {
-            delete std::get<JSONArray*>(value_);
-        } else if (type_ == ItemType::OBJECT) {
-            delete std::get<JSONObject*>(value_);
-        }
-    }
+        private:
+            static constexpr size_t bufferSize = 4096;
+
+            std::string* output_;
+            std::FILE* fp_;
+            Sink sink_;
+            size_t base_;
+            size_t written_;
+            bool failed_;
+            char* cursor_;
+            char* end_;
+            char buffer_[bufferSize];
+
+            inline char* reserve_(size_t size);
+            inline void overflow_(size_t size);
+            inline void put_(char ch);
+            inline void put_(const char* data, size_t size);
+            inline void send_(const char* data, size_t size);
+            inline void writeScalar_(const JSONItem &item);
+            inline void writeTree_(const JSONArray* array, const JSONObject* object);
+    };
 
-    inline JSONItem &JSONItem::operator=(const JSONItem &other)
-    {
-        if (std::addressof(other) != this) {
-            clear();
-            type_ = other.type_;
-            const auto &other_value = other.value_;
-            if (type_ == ItemType::ARRAY) {
-                const auto &jsonArray = *(std::get<JSONArray*>(other_value));
-                value_ = new JSONArray(jsonArray);
-            } else if (type_ == ItemType::OBJECT) {
-                const auto &jsonObject = *(std::get<JSONObject*>(other_value));
-                value_ = new JSONObject(jsonObject);
-            } else {
-                value_ = other_value;
-            }
-        }
-        return *this;
-    }
+    inline JSONWriter::JSONWriter(std::string &output) :
+        output_(std::addressof(output)),
+        fp_(nullptr),
+        sink_(),
+        base_(output.size()),
+        written_(0),
+        failed_(false),
+        cursor_(output.data() + output.size()),
+        end_(output.data() + output.size())
+    { }
 
-    inline JSONItem &JSONItem::operator=(JSONItem &&other) noexcept
-    {
-        if (std::addressof(other) != this) {
-            clear();
-            type_ = other.type_;
-            value_ = std::move(other.value_);
+    inline JSONWriter::JSONWriter(std::FILE* fp) :
+        output_(nullptr),
+        fp_(fp),
+        sink_(),
+        base_(0),
+        written_(0),
+        failed_(false),
+        cursor_(buffer_),
+        end_(buffer_ + bufferSize)
+    { }
 
-            other.type_ = ItemType::ITEM_NULL;
-            other.value_ = ItemValue();
-        }
-        return *this;
-    }
+    inline JSONWriter::JSONWriter(const Sink &sink) :
+        output_(nullptr),
+        fp_(nullptr),
+        sink_(sink),
+        base_(0),
+        written_(0),
+        failed_(false),
+        cursor_(buffer_),
+        end_(buffer_ + bufferSize)
+    { }
 
-    inline bool JSONItem::operator==(const JSONItem &other) const
+    // A throwing sink or a failed write must not terminate the program from here.
+    inline JSONWriter::~JSONWriter()
     {
-        return (type_ == other.type_ && value_ == other.value_);
+        try {
+            flush();
+        } catch (...) { }
     }
 
-    inline bool JSONItem::operator!=(const JSONItem &other) const
+    inline void JSONWriter::write(const JSONItem &item)
     {
-        return (type_ != other.type_ || value_ != other.value_);
+        switch (item.type_) {
+            case JSONItem::ItemType::ARRAY:
+                writeTree_(std::get<JSONArray*>(item.value_), nullptr);
+                break;
+            case JSONItem::ItemType::OBJECT:
+                writeTree_(nullptr, std::get<JSONObject*>(item.value_));
+                break;
+            default:
+                writeScalar_(item);
+                break;
+        }
     }
 
-    inline JSONItem::operator bool() const
+    inline void JSONWriter::write(const JSONArray &array)
     {
-        return toBoolean();
+        writeTree_(std::addressof(array), nullptr);
     }
 
-    inline JSONItem::operator int() const
+    inline void JSONWriter::write(const JSONObject &object)
     {
-        return toInt();
+        writeTree_(nullptr, std::addressof(object));
     }
 
-    inline JSONItem::operator int64_t() const
+    inline void JSONWriter::writeFormated(const JSONObject &object)
     {
-        return toLong();
+        if (object.size() == 1) {
+            put_("{\n", 2);
+            writeString(object.begin()->key);
+            put_(": ", 2);
+            write(object.begin()->value);
+            put_("\n }", 3);
+        } else if (object.size() > 1) {
+            put_("{\n", 2);
+            for (auto iter = object.begin(); iter < object.end(); ++iter) {
+                if (iter != object.begin()) {
+                    put_(",\n", 2);
+                }
+                put_("  ", 2);
+                writeString(iter->key);
+                put_(": ", 2);
+                write(iter->value);
+            }
+            put_("\n}", 2);
+        } else {
+            put_("{ }", 3);
+        }
     }
 
-    inline JSONItem::operator double() const
+    inline void JSONWriter::writeNull()
     {
-        return toDouble();
+        put_("null", 4);
     }
 
-    inline JSONItem::operator std::string() const
+    inline void JSONWriter::writeBoolean(bool value)
     {
-        return toString();
+        if (value) {
+            put_("true", 4);
+        } else {
+            put_("false", 5);
+        }
     }
 
-    inline bool JSONItem::isNull() const
+    inline void JSONWriter::writeInt(int value)
     {
-        return (type_ == ItemType::ITEM_NULL);
+        auto pos = reserve_(32);
+        cursor_ += _JSON_Number_Utils::FormatInteger(pos, value);
     }
 
-    inline bool JSONItem::isBoolean() const
+    inline void JSONWriter::writeLong(int64_t value)
     {
-        return (type_ == ItemType::BOOLEAN);
+        auto pos = reserve_(32);
+        cursor_ += _JSON_Number_Utils::FormatInteger(pos, value);
     }
 
-    inline bool JSONItem::isInt() const
+    inline void JSONWriter::writeDouble(double value)
     {
-        return (type_ == ItemType::INTEGER);
+        auto pos = reserve_(32);
+        cursor_ += _JSON_Number_Utils::FormatDouble(pos, value);
     }
 
-    inline bool JSONItem::isLong() const
+    inline void JSONWriter::writeString(std::string_view value)
     {
-        return (type_ == ItemType::LONG);
+        static const auto escapeChars = []() -> std::array<char, 256> {
+            std::array<char, 256> escapeChars{};
+            escapeChars['\\'] = '\\';
+            escapeChars['\"'] = '\"';
+            escapeChars['\n'] = 'n';
+            escapeChars['\t'] = 't';
+            escapeChars['\r'] = 'r';
+            escapeChars['\f'] = 'f';
+            escapeChars['\a'] = 'a';
+            escapeChars['\b'] = 'b';
+            escapeChars['\v'] = 'v';
+            escapeChars['/'] = '/';
+            escapeChars['\0'] = 'u';
+            return escapeChars;
+        }();
+
+        put_('\"');
+        auto run = value.data();
+        auto end = value.data() + value.size();
+        for (auto iter = run; iter < end; ++iter) {
+            auto escapeChar = escapeChars[static_cast<uint8_t>(*iter)];
+            if (escapeChar != '\0') {
+                put_(run, (iter - run));
+                if (escapeChar == 'u') {
+                    put_("\\u0000", 6);
+                } else {
+                    char escapeText[2] = {'\\', escapeChar};
+                    put_(escapeText, 2);
+                }
+                run = iter + 1;
+            }
+        }
+        put_(run, (end - run));
+        put_('\"');
     }
 
-    inline bool JSONItem::isDouble() const
+    inline void JSONWriter::writeScalar_(const JSONItem &item)
     {
-        return (type_ == ItemType::DOUBLE);
+        switch (item.type_) {
+            case JSONItem::ItemType::ITEM_NULL:
+                writeNull();
+                break;
+            case JSONItem::ItemType::BOOLEAN:
+                writeBoolean(std::get<bool>(item.value_));
+                break;
+            case JSONItem::ItemType::INTEGER:
+                writeInt(std::get<int>(item.value_));
+                break;
+            case JSONItem::ItemType::LONG:
+                writeLong(std::get<int64_t>(item.value_));
+                break;
+            case JSONItem::ItemType::DOUBLE:
+                writeDouble(std::get<double>(item.value_));
+                break;
+            case JSONItem::ItemType::STRING:
+                writeString(std::get<std::string>(item.value_));
+                break;
+            default:
+                break;
+        }
     }
 
-    inline bool JSONItem::isString() const
+    // Open containers are tracked on an explicit stack instead of recursing, so that deep trees are safe
+    // to write. The stack starts on the call stack and moves to the heap when it fills up.
+    inline void JSONWriter::writeTree_(const JSONArray* array, const JSONObject* object)
     {
-        return (type_ == ItemType::STRING);
-    }
+        struct Frame
+        {
+            bool isObject;
+            const JSONItem* elements;
+            const JSONObject::JSONPair* members;
+            size_t pos;
+            size_t size;
+        };
 
-    inline bool JSONItem::isArray() const
-    {
-        return (type_ == ItemType::ARRAY);
+        static constexpr size_t inlineDepth = 32;
+
+        Frame inlineFrames[inlineDepth];
+        std::vector<Frame> heapFrames{};
+        auto frames = inlineFrames;
+        auto capacity = inlineDepth;
+        size_t depth = 0;
+        for (;;) {
+            if (depth == capacity) {
+                std::vector<Frame> grown(capacity * 2);
+                std::copy(frames, (frames + depth), grown.begin());
+                heapFrames.swap(grown);
+                frames = heapFrames.data();
+                capacity = heapFrames.size();
+            }
+            auto frame = frames + depth;
+            if (array != nullptr) {
+                put_('[');
+                *frame = {false, array->data().data(), nullptr, 0, array->size()};
+            } else {
+                put_('{');
+                *frame = {true, nullptr, object->members().data(), 0, object->size()};
+            }
+            depth++;
+
+            // Writes the innermost open container up to its next nested container, closing finished ones.
+            const JSONItem* child = nullptr;
+            while (child == nullptr && depth > 0) {
+                frame = frames + (depth - 1);
+                auto pos = frame->pos;
+                auto size = frame->size;
+                if (!frame->isObject) {
+                    auto elements = frame->elements;
+                    for (; child == nullptr && pos < size; pos++) {
+                        if (pos > 0) {
+                            put_(',');
+                        }
+                        const auto &element = elements[pos];
+                        if (element.type_ == JSONItem::ItemType::ARRAY || element.type_ == JSONItem::ItemType::OBJECT) {
+                            child = std::addressof(element);
+                        } else {
+                            writeScalar_(element);
+                        }
+                    }
+                } else {
+                    auto members = frame->members;
+                    for (; child == nullptr && pos < size; pos++) {
+                        if (pos > 0) {
+                            put_(',');
+                        }
+                        const auto &member = members[pos];
+                        writeString(member.key);
+                        put_(':');
+                        if (member.value.type_ == JSONItem::ItemType::ARRAY || member.value.type_ == JSONItem::ItemType::OBJECT) {
+                            child = std::addressof(member.value);
+                        } else {
+                            writeScalar_(member.value);
+                        }
+                    }
+                }
+                frame->pos = pos;
+                if (child == nullptr) {
+                    put_(frame->isObject ? '}' : ']');
+                    depth--;
+                }
+            }
+            if (child == nullptr) {
+                return;
+            }
+            array = (child->type_ == JSONItem::ItemType::ARRAY) ? std::get<JSONArray*>(child->value_) : nullptr;
+            object = (child->type_ == JSONItem::ItemType::OBJECT) ? std::get<JSONObject*>(child->value_) : nullptr;
+        }
     }
 
-    inline bool JSONItem::isObject() const
+    inline void JSONWriter::writeRaw(std::string_view text)
     {
-        return (type_ == ItemType::OBJECT);
+        put_(text.data(), text.size());
     }
 
-    inline bool JSONItem::toBoolean() const
+    inline void JSONWriter::flush()
     {
-        if (type_ != ItemType::BOOLEAN) {
-            throw JSONExcept("Item is not of boolean type");
+        if (output_ != nullptr) {
+            output_->resize(cursor_ - output_->data());
+            cursor_ = output_->data() + output_->size();
+            end_ = cursor_;
+        } else {
+            send_(buffer_, (cursor_ - buffer_));
+            cursor_ = buffer_;
+            if (fp_ != nullptr && !failed_ && std::fflush(fp_) != 0) {
+                failed_ = true;
+            }
+            if (failed_) {
+                throw JSONExcept("Failed to write file");
+            }
         }
-        return std::get<bool>(value_);
     }
 
-    inline int JSONItem::toInt() const
+    inline size_t JSONWriter::size() const noexcept
     {
-        if (type_ != ItemType::INTEGER) {
-            throw JSONExcept("Item is not of int type");
+        if (output_ != nullptr) {
+            return (cursor_ - output_->data() - base_);
         }
-        return std::get<int>(value_);
+        return (written_ + (cursor_ - buffer_));
     }
 
-    inline int64_t JSONItem::toLong() const
+    inline char* JSONWriter::reserve_(size_t size)
     {
-        if (type_ != ItemType::LONG) {
-            throw JSONExcept("Item is not of long type");
+        if (static_cast<size_t>(end_ - cursor_) < size) {
+            overflow_(size);
         }
-        return std::get<int64_t>(value_);
+        return cursor_;
     }
 
-    inline double JSONItem::toDouble() const
+    inline void JSONWriter::overflow_(size_t size)
     {
-        if (type_ != ItemType::DOUBLE) {
-            throw JSONExcept("Item is not of double type");
+        if (output_ != nullptr) {
+            auto length = static_cast<size_t>(cursor_ - output_->data());
+            output_->resize(std::max({(length + size), output_->capacity(), (output_->size() * 2), bufferSize}));
+            cursor_ = output_->data() + length;
+            end_ = output_->data() + output_->size();
+        } else {
+            send_(buffer_, (cursor_ - buffer_));
+            cursor_ = buffer_;
         }
-        return std::get<double>(value_);
     }
 
-    inline std::string JSONItem::toString() const
+    inline void JSONWriter::put_(char ch)
     {
-        if (type_ != ItemType::STRING) {
-            throw JSONExcept("Item is not of string type");
+        if (cursor_ == end_) {
+            overflow_(1);
         }
-        return std::get<std::string>(value_);
+        *(cursor_++) = ch;
     }
 
-    inline JSONArray JSONItem::toArray() const
+    inline void JSONWriter::put_(const char* data, size_t size)
     {
-        if (type_ != ItemType::ARRAY) {
-            throw JSONExcept("Item is not of array type");
+        if (static_cast<size_t>(end_ - cursor_) < size) {
+            overflow_(size);
+            if (static_cast<size_t>(end_ - cursor_) < size) {
+                send_(data, size);
+                return;
+            }
         }
-        return *(std::get<JSONArray*>(value_));
+        std::memcpy(cursor_, data, size);
+        cursor_ += size;
     }
 
-    inline JSONObject JSONItem::toObject() const
+    inline void JSONWriter::send_(const char* data, size_t size)
     {
-        if (type_ != ItemType::OBJECT) {
-            throw JSONExcept("Item is not of object type");
+        if (size == 0 || failed_) {
+            return;
         }
-        return *(std::get<JSONObject*>(value_));
+        if (fp_ != nullptr) {
+            if (std::fwrite(data, sizeof(char), size, fp_) != size) {
+                failed_ = true;
+                return;
+            }
+        } else if (sink_) {
+            sink_(data, size);
+        }
+        written_ += size;
     }
 
-    inline _JSON_String JSONItem::toRaw() const
+    namespace _JSON_Parse_Utils
     {
-        switch (type_) {
-            case ItemType::ITEM_NULL:
-                return "null";
-            case ItemType::BOOLEAN:
-                if (std::get<bool>(value_)) {
-                    return "true";
-                }
-                return "false";
-            case ItemType::INTEGER:
-                {
-                    char buffer[32]{};
-                    std::snprintf(buffer, sizeof(buffer), "%d", std::get<int>(value_));
-                    return buffer;
-                }
-            case ItemType::LONG:
-                {
-                    char buffer[32]{};
-                    std::snprintf(buffer, sizeof(buffer), ("%" PRId64) , std::get<int64_t>(value_));
-                    return buffer;
+        // Containers nested deeper than this are rejected by the parsers unless a caller asks for another limit.
+        constexpr size_t defaultMaxDepth = 512;
+
+        inline void ThrowSyntaxExcept(std::string_view message, std::string_view jsonText = "", size_t beginPos = 0) 
+        {
+            static const auto countLine = [](std::string_view jsonText, size_t beginPos) -> size_t {
+                if (beginPos > jsonText.size()) {
+                    return 0;
                 }
-            case ItemType::DOUBLE:
-                {
-                    char buffer[32]{};
-                    std::snprintf(buffer, sizeof(buffer), "%.8f", std::get<double>(value_));
-                    return buffer;
+
+                size_t count = 0;
+                for (size_t pos = 0; pos < beginPos; pos++) {
+                    if (jsonText[pos] == '\n') {
+                        count++;
+                    }
                 }
-            case ItemType::STRING:
-                return _StringToJSONRaw(std::get<std::string>(value_));
-            case ItemType::ARRAY:
-                return std::get<JSONArray*>(value_)->toRaw();
-            case ItemType::OBJECT:
-                return std::get<JSONObject*>(value_)->toRaw();
-            default:
-                break;
-        }
-        return {};
-    }
-
-    inline void JSONItem::clear()
-    {
-        if (type_ == ItemType::ARRAY) {
-            delete std::get<JSONArray*>(value_);
-        } else if (type_ == ItemType::OBJECT) {
-            delete std::get<JSONObject*>(value_);
-        }
-        type_ = ItemType::ITEM_NULL;
-        value_ = nullptr;
-    }
-
-    inline size_t JSONItem::size() const
-    {
-        switch (type_) {
-            case ItemType::STRING:
-                return std::get<std::string>(value_).size();
-            case ItemType::ARRAY:
-                return std::get<JSONArray*>(value_)->size();
-            case ItemType::OBJECT:
-                return std::get<JSONObject*>(value_)->size();
-            default:
-                break;
-        }
-        return 1;
-    }
+                return count;
+            };
 
-    inline size_t JSONItem::hash() const
-    {
-        switch (type_) {
-            case ItemType::ITEM_NULL:
-                break;
-            case ItemType::BOOLEAN:
-                {
-                    std::hash<bool> hashVal{};
-                    return hashVal(std::get<bool>(value_));
-                }
-            case ItemType::INTEGER:
-                {
-                    std::hash<int> hashVal{};
-                    return hashVal(std::get<int>(value_));
-                }
-            case ItemType::LONG:
-                {
-                    std::hash<int64_t> hashVal{};
-                    return hashVal(std::get<int64_t>(value_));
-                }
-            case ItemType::DOUBLE:
-                {
-                    std::hash<double> hashVal{};
-                    return hashVal(std::get<double>(value_));
-                }
-            case ItemType::STRING:
-                {
-                    std::hash<std::string> hashVal{};
-                    return hashVal(std::get<std::string>(value_));
-                }
-            case ItemType::ARRAY:
-                return std::get<JSONArray*>(value_)->hash();
-            case ItemType::OBJECT:
-                return std::get<JSONObject*>(value_)->hash();
-            default:
-                break;
+            if (jsonText.size() > 0) {
+                char except_msg[4096]{};
+                std::snprintf(except_msg, sizeof(except_msg), 
+                    "Invalid syntax on line %zu: %s", (countLine(jsonText, beginPos) + 1), message.data());
+                throw JSONExcept(except_msg);
+            }
+            throw JSONExcept(std::string("Invalid syntax: ") + message.data());
         }
-        return 0;
-    }
 
-    inline JSONItem::ItemType JSONItem::type() const
-    {
-        return type_;
-    }
+        template <typename _Ty>
+        struct Result 
+        {
+            _Ty resultVal;
+            size_t endPos;
 
-    inline JSONArray::JSONArray() : data_() { }
+            Result() : resultVal(), endPos(-1) { }
 
-    inline JSONArray::JSONArray(size_t init_size) : data_(init_size) { }
+            Result(const Result &other) : resultVal(other.resultVal), endPos(other.endPos) { }
 
-    inline JSONArray::JSONArray(size_t init_size, const JSONItem &init_value) : data_(init_size, init_value) { }
+            Result(Result &&other) noexcept : resultVal(std::move(other.resultVal)), endPos(other.endPos) { }
+        };
 
-    inline JSONArray::JSONArray(iterator begin_iter, iterator end_iter) : data_(begin_iter, end_iter) { }
+        inline size_t IgnoreBlank(std::string_view jsonText, size_t beginPos) noexcept
+        {
+            static const auto isBlankChar = [](char ch) -> bool {
+                switch (ch) {
+                    case ' ':
+                    case '\n':
+                    case '\t':
+                    case '\r':
+                    case '\f':
+                    case '\a':
+                    case '\b':
+                    case '\v':
+                        return true;
+                    default:
+                        break;
+                }
+                return false;
+            };
 
-    inline JSONArray::JSONArray(std::string_view jsonText) : data_()
-    {
-        auto arrayResult = _JSON_Parse_Utils::ParseJSONArray(jsonText, 0);
-        auto array = std::move(arrayResult.resultVal);
-        data_ = std::move(array.data_);
-    }
+            for (auto pos = beginPos; pos < jsonText.size(); pos++) {
+                if (!isBlankChar(jsonText[pos])) {
+                    return pos;
+                }
+            }
+            return std::string_view::npos;
+        }
 
-    inline JSONArray::JSONArray(const std::vector<JSONItem> &data) : data_(data) { }
+        // Past the end of the text reads as '\0', which matches no JSON token.
+        inline char CharAt(std::string_view jsonText, size_t pos) noexcept
+        {
+            return (pos < jsonText.size()) ? jsonText[pos] : '\0';
+        }
 
-    inline JSONArray::JSONArray(std::vector<JSONItem> &&data) noexcept : data_(data) { }
+        inline Result<JSONArray> ParseJSONArray(std::string_view jsonText, size_t beginPos, size_t maxDepth = defaultMaxDepth);
 
-    inline JSONArray::JSONArray(const JSONArray &other) : data_(other.data_) { }
+        inline Result<JSONObject> ParseJSONObject(std::string_view jsonText, size_t beginPos, size_t maxDepth = defaultMaxDepth);
 
-    inline JSONArray::JSONArray(JSONArray &&other) noexcept : data_(std::move(other.data_)) { }
+        inline Result<_JSON_String> ParseEscapeChar(std::string_view jsonText, size_t beginPos)
+        {
+            static const auto parseUnicode = [](std::string_view jsonText, size_t beginPos) -> _JSON_String
+            {
+                static constexpr int utf8bit_max = 0x7F;
+                static constexpr int utf16bit_max = 0x7FF;
+                static constexpr int utf24bit_max = 0xFFFF;
+                static constexpr int utf32bit_max = 0x10FFFF;
 
-    inline JSONArray::~JSONArray() { }
+                if (jsonText.size() >= (beginPos + 4)) {
+                    int unicodeVal = 0;
+                    for (auto pos = beginPos; pos < (beginPos + 4); pos++) {
+                        auto ch = jsonText[pos];
+                        if (ch >= '0' && ch <= '9') {
+                            unicodeVal = (unicodeVal << 4) | (ch - '0');
+                        } else if (ch >= 'a' && ch <= 'f') {
+                            unicodeVal = (unicodeVal << 4) | (ch - 'a' + 10);
+                        } else if (ch >= 'A' && ch <= 'F') {
+                            unicodeVal = (unicodeVal << 4) | (ch - 'A' + 10);
+                        } else {
+                            ThrowSyntaxExcept("faild to parse unicode escape char", jsonText, beginPos);
+                        }
+                    }
+                    if (unicodeVal <= utf8bit_max) {
+                        char unicodeChar[2]{};
+                        unicodeChar[0] = static_cast<char>(unicodeVal);
+                        return unicodeChar;
+                    } else if (unicodeVal <= utf16bit_max) {
+                        char unicodeChar[3]{};
+                        unicodeChar[0] = static_cast<char>(0xC0 | ((unicodeVal >> 6) & 0x1F));
+                        unicodeChar[1] = static_cast<char>(0x80 | (unicodeVal & 0x3F));
+                        return unicodeChar;
+                    } else if (unicodeVal <= utf24bit_max) {
+                        char unicodeChar[4]{};
+                        unicodeChar[0] = static_cast<char>(0xE0 | ((unicodeVal >> 12) & 0x0F));
+                        unicodeChar[1] = static_cast<char>(0x80 | ((unicodeVal >> 6) & 0x3F));
+                        unicodeChar[2] = static_cast<char>(0x80 | (unicodeVal & 0x3F));
+                        return unicodeChar;
+                    } else if (unicodeVal <= utf32bit_max) {
+                        char unicodeChar[5]{};
+                        unicodeChar[0] = static_cast<char>(0xF0 | ((unicodeVal >> 18) & 0x07));
+                        unicodeChar[1] = static_cast<char>(0x80 | ((unicodeVal >> 12) & 0x3F));
+                        unicodeChar[2] = static_cast<char>(0x80 | ((unicodeVal >> 6) & 0x3F));
+                        unicodeChar[3] = static_cast<char>(0x80 | (unicodeVal & 0x3F));
+                        return unicodeChar;
+                    }
+                }
 
-    inline JSONArray &JSONArray::operator=(const JSONArray &other)
-    {
-        if (std::addressof(other) != this) {
-            data_ = other.data_;
-        }
-        return *this;
-    }
+                ThrowSyntaxExcept("faild to parse unicode escape char", jsonText, beginPos);
+                return {};
+            };
 
-    inline JSONArray &JSONArray::operator=(JSONArray &&other) noexcept
-    {
-        if (std::addressof(other) != this) {
-            data_ = std::move(other.data_);
-        }
-        return *this;
-    }
+            if (jsonText[beginPos] != '\\') {
+                return {};
+            }
 
-    inline JSONArray &JSONArray::operator+=(const JSONArray &other)
-    {
-        if (std::addressof(other) != this) {
-            const auto &other_data = other.data_;
-            for (auto iter = other_data.begin(); iter < other_data.end(); ++iter) {
-                data_.emplace_back(*iter);
+            Result<_JSON_String> charResult{};
+            auto pos = beginPos + 1;
+            switch ((pos < jsonText.size()) ? jsonText[pos] : '\0') {
+                case 'n':
+                    charResult.resultVal.append('\n');
+                    pos++;
+                    break;
+                case 'r':
+                    charResult.resultVal.append('\r');
+                    pos++;
+                    break;
+                case 't':
+                    charResult.resultVal.append('\t');
+                    pos++;
+                    break;
+                case 'b':
+                    charResult.resultVal.append('\b');
+                    pos++;
+                    break;
+                case 'f':
+                    charResult.resultVal.append('\f');
+                    pos++;
+                    break;
+                case 'a':
+                    charResult.resultVal.append('\a');
+                    pos++;
+                    break;
+                case 'v':
+                    charResult.resultVal.append('\v');
+                    pos++;
+                    break;
+                case '/':
+                    charResult.resultVal.append('/');
+                    pos++;
+                    break;
+                case '\\':
+                    charResult.resultVal.append('\\');
+                    pos++;
+                    break;
+                case '\"':
+                    charResult.resultVal.append('\"');
+                    pos++;
+                    break;
+                case '\'':
+                    charResult.resultVal.append('\'');
+                    pos++;
+                    break;
+                case 'u':
+                    pos++;
+                    charResult.resultVal.append(parseUnicode(jsonText, pos).data());
+                    pos += 4;
+                    break;
+                default:
+                    ThrowSyntaxExcept("unknown escape char", jsonText, pos);
+                    break;
             }
+            charResult.endPos = pos;
+            return charResult;
         }
-        return *this;
-    }
 
-    inline JSONArray JSONArray::operator+(const JSONArray &other) const
-    {
-        auto merged_data = data_;
-        if (std::addressof(other) != this) {
-            const auto &other_data = other.data_;
-            for (auto iter = other_data.begin(); iter < other_data.end(); ++iter) {
-                merged_data.emplace_back(*iter);
+        inline Result<_JSON_String> ParseJSONString(std::string_view jsonText, size_t beginPos)
+        {
+            auto pos = IgnoreBlank(jsonText, beginPos);
+            if (pos == std::string_view::npos || jsonText[pos] != '\"') {
+                ThrowSyntaxExcept("JSON String must begin with \'\"\'", jsonText, beginPos);
             }
-        }
-        return JSONArray(merged_data);
-    }
+            pos++;
 
-    inline bool JSONArray::operator==(const JSONArray &other) const
-    {
-        return (data_ == other.data_);
-    }
+            Result<_JSON_String> stringResult{};
+            while (pos < jsonText.size()) {
+                if (jsonText[pos] == '\"') {
+                    break;
+                } else if (jsonText[pos] == '\\') {
+                    auto charResult = ParseEscapeChar(jsonText, pos);
+                    stringResult.resultVal.append(charResult.resultVal.data());
+                    pos = charResult.endPos;
+                } else {
+                    stringResult.resultVal.append(jsonText[pos]);
+                    pos++;
+                }
+            }
+            if (pos >= jsonText.size()) {
+                ThrowSyntaxExcept("JSON String must end with \'\"\'", jsonText, beginPos);
+            }
 
-    inline bool JSONArray::operator!=(const JSONArray &other) const
-    {
-        return (data_ != other.data_);
-    }
+            stringResult.endPos = pos + 1;
+            return stringResult;
+        }
 
-    inline JSONItem &JSONArray::operator[](size_t pos)
-    {
-        if (pos >= data_.size()) {
-            throw JSONExcept("Position out of bounds");
+        // Strings, numbers and literals are parsed into item, returns the position after the value. 
+        // A literal that does not match leaves item untouched and returns npos, the caller then 
+        // reports the missing separator.
+        inline size_t ParseJSONScalar(std::string_view jsonText, size_t beginPos, JSONItem &item)
+        {
+            static const auto compareText = 
+                [](std::string_view text, size_t beginPos, std::string_view cmpText) -> bool 
+            {
+                if ((beginPos + cmpText.size()) > text.size()) {
+                    return false;
+                }
+                return (std::memcmp(&text[beginPos], cmpText.data(), cmpText.size()) == 0);
+            };
+
+            auto endPos = std::string_view::npos;
+            auto pos = IgnoreBlank(jsonText, beginPos);
+            switch (CharAt(jsonText, pos)) {
+                case '\"':
+                    {
+                        auto stringResult = ParseJSONString(jsonText, pos);
+                        item = stringResult.resultVal.data();
+                        endPos = stringResult.endPos;
+                    }
+                    break;
+                case '-':
+                case '+':
+                case '0':
+                case '1':
+                case '2':
+                case '3':
+                case '4':
+                case '5':
+                case '6':
+                case '7':
+                case '8':
+                case '9':
+                    {
+                        _JSON_Number_Utils::Number number{};
+                        endPos = _JSON_Number_Utils::ParseNumber(jsonText, pos, number);
+                        if (endPos == std::string_view::npos) {
+                            ThrowSyntaxExcept("invalid JSON Number", jsonText, pos);
+                        }
+                        if (number.isDouble) {
+                            item = number.number;
+                        } else if (number.integer >= INT_MIN && number.integer <= INT_MAX) {
+                            item = static_cast<int>(number.integer);
+                        } else {
+                            item = number.integer;
+                        }
+                    }
+                    break;
+                case 'n':
+                    if (compareText(jsonText, pos, "null")) {
+                        item = JSONItem::ItemNull();
+                        endPos = pos + 4;
+                    }
+                    break;
+                case 't':
+                    if (compareText(jsonText, pos, "true")) {
+                        item = true;
+                        endPos = pos + 4;
+                    }
+                    break;
+                case 'f':
+                    if (compareText(jsonText, pos, "false")) {
+                        item = false;
+                        endPos = pos + 5;
+                    }
+                    break;
+                default:
+                    ThrowSyntaxExcept("unknown JSON Item", jsonText, pos);
+                    break;
+            }
+            return endPos;
         }
-        return data_.at(pos);
-    }
 
-    inline const JSONItem &JSONArray::at(size_t pos) const
-    {
-        if (pos >= data_.size()) {
-            throw JSONExcept("Position out of bounds");
+        // Open containers are kept on an explicit stack rather than the call stack, so hostile nesting 
+        // cannot exhaust small thread stacks, containers nested deeper than maxDepth are rejected.
+        // Values are parsed in place into the slot of the innermost open container.
+        // An unclosed outermost container is reported at rootPos, nested ones at their bracket. 
+        // Errors at the end of the text are reported at npos, which counts as the first line.
+        inline Result<JSONItem> ParseJSONTree(std::string_view jsonText, size_t beginPos, size_t rootPos, size_t maxDepth)
+        {
+            struct Frame
+            {
+                size_t beginPos;
+                bool isObject;
+                JSONItem* target;
+                std::vector<JSONItem> elements;
+                std::vector<JSONObject::JSONPair> members;
+            };
+
+            static const auto throwUnclosed = [](std::string_view jsonText, const Frame &frame) {
+                if (frame.isObject) {
+                    ThrowSyntaxExcept("JSON Object must end with \'}\'", jsonText, frame.beginPos);
+                }
+                ThrowSyntaxExcept("JSON Array must end with \']\'", jsonText, frame.beginPos);
+            };
+
+            // Adds the next element or member to frame, moves pos to its value and returns its slot.
+            static const auto nextSlot = [](std::string_view jsonText, size_t &pos, Frame &frame) -> JSONItem* {
+                if (!frame.isObject) {
+                    frame.elements.emplace_back();
+                    return std::addressof(frame.elements.back());
+                }
+
+                auto stringResult = ParseJSONString(jsonText, IgnoreBlank(jsonText, pos));
+                const auto &key = stringResult.resultVal;
+                frame.members.emplace_back();
+                auto &member = frame.members.back();
+                member.key = JSONKey(std::string_view(key.data(), key.length()));
+
+                pos = IgnoreBlank(jsonText, stringResult.endPos);
+                if (CharAt(jsonText, pos) != ':') {
+                    ThrowSyntaxExcept("key and value must be separated by \':\'", jsonText, pos);
+                }
+                pos++;
+                return std::addressof(member.value);
+            };
+
+            Result<JSONItem> itemResult{};
+            std::vector<Frame> stack{};
+            auto slot = std::addressof(itemResult.resultVal);
+            auto pos = beginPos;
+            for (;;) {
+                auto valuePos = IgnoreBlank(jsonText, pos);
+                auto ch = CharAt(jsonText, valuePos);
+                if (ch == '{' || ch == '[') {
+                    if (stack.size() >= maxDepth) {
+                        ThrowSyntaxExcept("JSON nesting exceeds the maximum depth", jsonText, valuePos);
+                    }
+                    auto isObject = (ch == '{');
+                    pos = IgnoreBlank(jsonText, (valuePos + 1));
+                    if (CharAt(jsonText, pos) != (isObject ? '}' : ']')) {
+                        stack.emplace_back();
+                        auto &frame = stack.back();
+                        frame.beginPos = (stack.size() == 1) ? rootPos : valuePos;
+                        frame.isObject = isObject;
+                        frame.target = slot;
+                        if (pos == std::string_view::npos) {
+                            throwUnclosed(jsonText, frame);
+                        }
+                        slot = nextSlot(jsonText, pos, frame);
+                        continue;
+                    }
+                    if (isObject) {
+                        *slot = JSONObject();
+                    } else {
+                        *slot = JSONArray();
+                    }
+                    pos++;
+                } else {
+                    pos = ParseJSONScalar(jsonText, valuePos, *slot);
+                }
+
+                // Closes the containers that end after the value.
+                for (;;) {
+                    if (stack.empty()) {
+                        itemResult.endPos = pos;
+                        return itemResult;
+                    }
+                    auto &frame = stack.back();
+                    pos = IgnoreBlank(jsonText, pos);
+                    ch = CharAt(jsonText, pos);
+                    if (ch == ',') {
+                        pos++;
+                        if (pos >= jsonText.size()) {
+                            throwUnclosed(jsonText, frame);
+                        }
+                        slot = nextSlot(jsonText, pos, frame);
+                        break;
+                    }
+                    if (ch != (frame.isObject ? '}' : ']')) {
+                        if (frame.isObject) {
+                            ThrowSyntaxExcept("JSON Object elements must be separated by \',\'", jsonText, pos);
+                        }
+                        ThrowSyntaxExcept("JSON Array elements must be separated by \',\'", jsonText, pos);
+                    }
+                    if (frame.isObject) {
+                        *frame.target = JSONObject(std::move(frame.members));
+                    } else {
+                        *frame.target = JSONArray(std::move(frame.elements));
+                    }
+                    stack.pop_back();
+                    pos++;
+                }
+            }
         }
-        return data_.at(pos);
-    }
 
-    inline JSONArray::iterator JSONArray::find(const JSONItem &item)
-    {
-        if (data_.begin() == data_.end()) {
-            return data_.end();
+        inline Result<JSONItem> ParseJSONItem(std::string_view jsonText, size_t beginPos, size_t maxDepth = defaultMaxDepth)
+        {
+            return ParseJSONTree(jsonText, beginPos, IgnoreBlank(jsonText, beginPos), maxDepth);
         }
-        return std::find(data_.begin(), data_.end(), item);
-    }
 
-    inline void JSONArray::add(const JSONItem &item)
-    {
-        data_.emplace_back(item);
-    }
+        inline Result<JSONArray> ParseJSONArray(std::string_view jsonText, size_t beginPos, size_t maxDepth)
+        {
+            auto pos = IgnoreBlank(jsonText, beginPos);
+            if (CharAt(jsonText, pos) != '[') {
+                ThrowSyntaxExcept("JSON Array must begin with \'[\'", jsonText, beginPos);
+            }
 
-    inline void JSONArray::remove(const JSONItem &item)
-    {
-        auto iter = std::find(data_.begin(), data_.end(), item);
-        if (iter == data_.end()) {
-            throw JSONExcept("Item not found");
+            auto itemResult = ParseJSONTree(jsonText, pos, beginPos, maxDepth);
+            Result<JSONArray> arrayResult{};
+            arrayResult.resultVal = itemResult.resultVal.takeArray();
+            arrayResult.endPos = itemResult.endPos;
+            return arrayResult;
         }
-        data_.erase(iter);
-    }
 
-    inline void JSONArray::resize(size_t new_size)
-    {
-        data_.resize(new_size);
-    }
+        inline Result<JSONObject> ParseJSONObject(std::string_view jsonText, size_t beginPos, size_t maxDepth)
+        {
+            auto pos = IgnoreBlank(jsonText, beginPos);
+            if (CharAt(jsonText, pos) != '{') {
+                ThrowSyntaxExcept("JSON Object must begin with \'{\'", jsonText, pos);
+            }
 
-    inline void JSONArray::clear()
-    {
-        data_.clear();
-    }
+            auto itemResult = ParseJSONTree(jsonText, pos, beginPos, maxDepth);
+            Result<JSONObject> objectResult{};
+            objectResult.resultVal = itemResult.resultVal.takeObject();
+            objectResult.endPos = itemResult.endPos;
+            return objectResult;
+        }
 
-    inline size_t JSONArray::size() const
-    {
-        return data_.size();
-    }
+        struct BlockMasks
+        {
+            uint64_t quote;
+            uint64_t backslash;
+            uint64_t blank;
+            uint64_t op;
+            uint64_t zero;
+        };
 
-    inline size_t JSONArray::hash() const
-    {
-        size_t hashVal = data_.size();
-        for (const auto &item : data_) {
-            hashVal ^= item.hash() + 2654435769 + (hashVal << 6) + (hashVal >> 2);
+        inline int CountTrailingZero(uint64_t val) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(val);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+            unsigned long idx = 0;
+            _BitScanForward64(std::addressof(idx), val);
+            return static_cast<int>(idx);
+#else
+            int idx = 0;
+            while ((val & 1) == 0) {
+                val >>= 1;
+                idx++;
+            }
+            return idx;
+#endif
         }
-        return hashVal;
-    }
 
-    inline bool JSONArray::empty() const
-    {
-        return (data_.begin() == data_.end());
-    }
+        inline uint64_t PrefixXor(uint64_t val) noexcept
+        {
+            val ^= val << 1;
+            val ^= val << 2;
+            val ^= val << 4;
+            val ^= val << 8;
+            val ^= val << 16;
+            val ^= val << 32;
+            return val;
+        }
 
-    inline _JSON_String JSONArray::toRaw() const
-    {
-        if (data_.begin() == data_.end()) {
-            return "[]";
-        } else if ((data_.begin() + 1) == data_.end()) {
-            _JSON_String jsonText("[");
-            jsonText.append(data_.front().toRaw().data());
-            jsonText.append(']');
-            return jsonText;
+        // Blank chars are the ones accepted by IgnoreBlank: ' ' and '\a' ~ '\r' (0x07 ~ 0x0D).
+#if defined(_CU_JSON_AVX2_)
+        inline void ClassifyBlock(const char* block, BlockMasks &masks) noexcept
+        {
+            const auto quoteChar = _mm256_set1_epi8('\"');
+            const auto backslashChar = _mm256_set1_epi8('\\');
+            const auto spaceChar = _mm256_set1_epi8(' ');
+            const auto controlBegin = _mm256_set1_epi8(0x07);
+            const auto controlRange = _mm256_set1_epi8(0x06);
+            const auto caseBit = _mm256_set1_epi8(0x20);
+            const auto braceBegin = _mm256_set1_epi8('{');
+            const auto braceEnd = _mm256_set1_epi8('}');
+            const auto colonChar = _mm256_set1_epi8(':');
+            const auto commaChar = _mm256_set1_epi8(',');
+            const auto zeroChar = _mm256_setzero_si256();
+
+            masks = BlockMasks{};
+            for (int offset = 0; offset < 64; offset += 32) {
+                auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + offset));
+                auto control = _mm256_sub_epi8(chunk, controlBegin);
+                auto blank = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, spaceChar), 
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(control, controlRange), control));
+                auto bracket = _mm256_or_si256(chunk, caseBit);
+                auto op = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(bracket, braceBegin), _mm256_cmpeq_epi8(bracket, braceEnd)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, colonChar), _mm256_cmpeq_epi8(chunk, commaChar)));
+                masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(
+                    _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quoteChar)))) << offset;
+                masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(
+                    _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslashChar)))) << offset;
+                masks.blank |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(blank))) << offset;
+                masks.op |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << offset;
+                masks.zero |= static_cast<uint64_t>(static_cast<uint32_t>(
+                    _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, zeroChar)))) << offset;
+            }
         }
-        _JSON_String jsonText("[");
-        for (auto iter = data_.begin(); iter < (data_.end() - 1); ++iter) {
-            jsonText.append((iter->toRaw()).data());
-            jsonText.append(',');
+#elif defined(_CU_JSON_SSE2_)
+        inline void ClassifyBlock(const char* block, BlockMasks &masks) noexcept
+        {
+            const auto quoteChar = _mm_set1_epi8('\"');
+            const auto backslashChar = _mm_set1_epi8('\\');
+            const auto spaceChar = _mm_set1_epi8(' ');
+            const auto controlBegin = _mm_set1_epi8(0x07);
+            const auto controlRange = _mm_set1_epi8(0x06);
+            const auto caseBit = _mm_set1_epi8(0x20);
+            const auto braceBegin = _mm_set1_epi8('{');
+            const auto braceEnd = _mm_set1_epi8('}');
+            const auto colonChar = _mm_set1_epi8(':');
+            const auto commaChar = _mm_set1_epi8(',');
+            const auto zeroChar = _mm_setzero_si128();
+
+            masks = BlockMasks{};
+            for (int offset = 0; offset < 64; offset += 16) {
+                auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + offset));
+                auto control = _mm_sub_epi8(chunk, controlBegin);
+                auto blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, spaceChar), 
+                    _mm_cmpeq_epi8(_mm_min_epu8(control, controlRange), control));
+                auto bracket = _mm_or_si128(chunk, caseBit);
+                auto op = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(bracket, braceBegin), _mm_cmpeq_epi8(bracket, braceEnd)),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, colonChar), _mm_cmpeq_epi8(chunk, commaChar)));
+                masks.quote |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quoteChar))) << offset;
+                masks.backslash |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslashChar))) << offset;
+                masks.blank |= static_cast<uint64_t>(_mm_movemask_epi8(blank)) << offset;
+                masks.op |= static_cast<uint64_t>(_mm_movemask_epi8(op)) << offset;
+                masks.zero |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zeroChar))) << offset;
+            }
         }
-        jsonText.append(data_.back().toRaw().data());
-        jsonText.append(']');
-        return jsonText;
-    }
-
-    inline std::string JSONArray::toString() const
-    {
-        return toRaw().data();
-    }
+#elif defined(_CU_JSON_NEON_)
+        inline void ClassifyBlock(const char* block, BlockMasks &masks) noexcept
+        {
+            static const auto toBitmask = [](uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) -> uint64_t {
+                static const uint8_t bitValues[16] = {
+                    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+                };
+                const auto bitMask = vld1q_u8(bitValues);
+                auto sum0 = vpaddq_u8(vandq_u8(m0, bitMask), vandq_u8(m1, bitMask));
+                auto sum1 = vpaddq_u8(vandq_u8(m2, bitMask), vandq_u8(m3, bitMask));
+                sum0 = vpaddq_u8(sum0, sum1);
+                sum0 = vpaddq_u8(sum0, sum0);
+                return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+            };
 
-    inline const std::vector<JSONItem> &JSONArray::data() const
-    {
-        return data_;
-    }
+            uint8x16_t quote[4], backslash[4], blank[4], op[4], zero[4];
+            for (int idx = 0; idx < 4; idx++) {
+                auto chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(block + idx * 16));
+                auto bracket = vorrq_u8(chunk, vdupq_n_u8(0x20));
+                quote[idx] = vceqq_u8(chunk, vdupq_n_u8('\"'));
+                backslash[idx] = vceqq_u8(chunk, vdupq_n_u8('\\'));
+                blank[idx] = vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(' ')), 
+                    vcleq_u8(vsubq_u8(chunk, vdupq_n_u8(0x07)), vdupq_n_u8(0x06)));
+                op[idx] = vorrq_u8(
+                    vorrq_u8(vceqq_u8(bracket, vdupq_n_u8('{')), vceqq_u8(bracket, vdupq_n_u8('}'))),
+                    vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(':')), vceqq_u8(chunk, vdupq_n_u8(','))));
+                zero[idx] = vceqq_u8(chunk, vdupq_n_u8(0));
+            }
+            masks.quote = toBitmask(quote[0], quote[1], quote[2], quote[3]);
+            masks.backslash = toBitmask(backslash[0], backslash[1], backslash[2], backslash[3]);
+            masks.blank = toBitmask(blank[0], blank[1], blank[2], blank[3]);
+            masks.op = toBitmask(op[0], op[1], op[2], op[3]);
+            masks.zero = toBitmask(zero[0], zero[1], zero[2], zero[3]);
+        }
+#else
+        inline void ClassifyBlock(const char* block, BlockMasks &masks) noexcept
+        {
+            masks = BlockMasks{};
+            for (int offset = 0; offset < 64; offset++) {
+                auto bit = static_cast<uint64_t>(1) << offset;
+                switch (block[offset]) {
+                    case '\"':
+                        masks.quote |= bit;
+                        break;
+                    case '\\':
+                        masks.backslash |= bit;
+                        break;
+                    case ' ':
+                    case '\n':
+                    case '\t':
+                    case '\r':
+                    case '\f':
+                    case '\a':
+                    case '\b':
+                    case '\v':
+                        masks.blank |= bit;
+                        break;
+                    case '{':
+                    case '}':
+                    case '[':
+                    case ']':
+                    case ':':
+                    case ',':
+                        masks.op |= bit;
+                        break;
+                    case '\0':
+                        masks.zero |= bit;
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+#endif
 
-    inline JSONItem &JSONArray::front()
-    {
-        return data_.front();
-    }
+        // Stage 1: positions of every structural char outside strings, every unescaped quote 
+        // and the first char of every number / literal.
+        class StructuralIndex
+        {
+            public:
+                StructuralIndex() : positions_(), size_(0), hasZero_(false) { }
 
-    inline JSONItem &JSONArray::back()
-    {
-        return data_.back();
-    }
+                void build(std::string_view jsonText)
+                {
+                    static constexpr size_t blockSize = 64;
 
-    inline const JSONItem &JSONArray::front() const
-    {
-        return data_.front();
-    }
+                    size_ = 0;
+                    hasZero_ = false;
+                    if (jsonText.size() >= std::numeric_limits<uint32_t>::max()) {
+                        return;
+                    }
 
-    inline const JSONItem &JSONArray::back() const
-    {
-        return data_.back();
-    }
+                    uint64_t prevInString = 0, prevScalar = 0, zero = 0;
+                    bool prevEscaped = false;
+                    for (size_t offset = 0; offset < jsonText.size(); offset += blockSize) {
+                        BlockMasks masks{};
+                        auto remaining = jsonText.size() - offset;
+                        if (remaining >= blockSize) {
+                            ClassifyBlock(jsonText.data() + offset, masks);
+                        } else {
+                            char block[blockSize]{};
+                            std::memset(block, ' ', sizeof(block));
+                            std::memcpy(block, jsonText.data() + offset, remaining);
+                            ClassifyBlock(block, masks);
+                        }
+                        zero |= masks.zero;
 
-    inline JSONArray::iterator JSONArray::begin()
-    {
-        return data_.begin();
-    }
+                        uint64_t escaped = 0, backslash = masks.backslash;
+                        if (prevEscaped) {
+                            escaped = 1;
+                            backslash &= ~static_cast<uint64_t>(1);
+                            prevEscaped = false;
+                        }
+                        while (backslash != 0) {
+                            auto bit = CountTrailingZero(backslash);
+                            if (bit == 63) {
+                                prevEscaped = true;
+                                break;
+                            }
+                            escaped |= static_cast<uint64_t>(2) << bit;
+                            backslash &= ~(static_cast<uint64_t>(3) << bit);
+                        }
 
-    inline JSONArray::iterator JSONArray::end()
-    {
-        return data_.end();
-    }
+                        auto quote = masks.quote & ~escaped;
+                        auto inString = PrefixXor(quote) ^ prevInString;
+                        prevInString = static_cast<uint64_t>(0) - (inString >> 63);
+                        auto scalar = ~(masks.blank | masks.op | quote | inString);
+                        auto scalarBegin = scalar & ~((scalar << 1) | prevScalar);
+                        prevScalar = scalar >> 63;
 
-    inline JSONArray::const_iterator JSONArray::begin() const
-    {
-        return data_.begin();
-    }
+                        auto tokens = (masks.op & ~inString) | quote | scalarBegin;
+                        if (positions_.size() < (size_ + blockSize)) {
+                            positions_.resize(std::max(positions_.size() * 2, (size_ + blockSize)));
+                        }
+                        auto dst = positions_.data() + size_;
+                        while (tokens != 0) {
+                            *dst = static_cast<uint32_t>(offset + CountTrailingZero(tokens));
+                            dst++;
+                            tokens &= tokens - 1;
+                        }
+                        size_ = dst - positions_.data();
+                    }
+                    hasZero_ = (zero != 0);
+                }
 
-    inline JSONArray::const_iterator JSONArray::end() const
-    {
-        return data_.end();
-    }
+                const uint32_t* data() const noexcept
+                {
+                    return positions_.data();
+                }
+
+                size_t size() const noexcept
+                {
+                    return size_;
+                }
 
-    inline JSONObject::JSONObject() : data_(), order_() { }
+                bool usable(std::string_view jsonText) const noexcept
+                {
+                    return (size_ > 0 && !hasZero_ && jsonText.size() < std::numeric_limits<uint32_t>::max());
+                }
 
-    inline JSONObject::JSONObject(std::string_view jsonText) : data_(), order_()
-    {
-        auto objectResult = _JSON_Parse_Utils::ParseJSONObject(jsonText, 0);
-        auto object = std::move(objectResult.resultVal);
-        data_ = std::move(object.data_);
-        order_ = std::move(object.order_);
+            private:
+                std::vector<uint32_t> positions_;
+                size_t size_;
+                bool hasZero_;
+        };
+
+        // Stage 2: walks the structural index instead of the text. Input is rejected here, with the
+        // message and position ParseJSONTree reports for it, positions are those of jsonText.
+        class IndexedCursor
+        {
+            public:
+                // The index was built from jsonText.substr(offset).
+                IndexedCursor(std::string_view jsonText, const StructuralIndex &index, size_t offset = 0) noexcept :
+                    jsonText_(jsonText),
+                    tokens_(index.data()),
+                    count_(index.size()),
+                    cursor_(0),
+                    offset_(offset),
+                    stray_(false),
+                    strayPos_(0)
+                { }
+
+                // Position of the next token, npos past the last one. After a scalar that is not
+                // followed by a separator, the position where the scalar stopped.
+                size_t peekPos() const noexcept
+                {
+                    if (stray_) {
+                        return strayPos_;
+                    }
+                    if (cursor_ >= count_) {
+                        return std::string_view::npos;
+                    }
+                    return tokens_[cursor_] + offset_;
+                }
+
+                char peekChar() const noexcept
+                {
+                    return CharAt(jsonText_, peekPos());
+                }
+
+                void skipToken() noexcept
+                {
+                    cursor_++;
+                }
+
+                size_t tell() const noexcept
+                {
+                    return cursor_;
+                }
+
+                void seek(size_t cursor) noexcept
+                {
+                    cursor_ = cursor;
+                }
+
+                // Returns the raw content if the string has no escape char, otherwise decodes it into buffer.
+                std::string_view parseString(std::string &buffer)
+                {
+                    auto quotePos = peekPos();
+                    cursor_++;
+                    auto endPos = peekPos();
+                    if (endPos == std::string_view::npos) {
+                        // Only an unterminated string is left without its closing quote.
+                        ParseJSONString(jsonText_, quotePos);
+                        ThrowSyntaxExcept("JSON String must end with \'\"\'", jsonText_, quotePos);
+                    }
+                    cursor_++;
+
+                    auto begin = jsonText_.data() + quotePos + 1;
+                    auto length = endPos - quotePos - 1;
+                    auto escape = reinterpret_cast<const char*>(std::memchr(begin, '\\', length));
+                    if (escape == nullptr) {
+                        return std::string_view(begin, length);
+                    }
+
+                    buffer.assign(begin, (escape - begin));
+                    auto pos = static_cast<size_t>(escape - jsonText_.data());
+                    while (pos < endPos) {
+                        if (jsonText_[pos] == '\\') {
+                            auto charResult = ParseEscapeChar(jsonText_, pos);
+                            buffer.append(charResult.resultVal.data());
+                            pos = charResult.endPos;
+                        } else {
+                            auto runBegin = jsonText_.data() + pos;
+                            auto runEnd = reinterpret_cast<const char*>(std::memchr(runBegin, '\\', (endPos - pos)));
+                            if (runEnd == nullptr) {
+                                runEnd = jsonText_.data() + endPos;
+                            }
+                            buffer.append(runBegin, (runEnd - runBegin));
+                            pos = runEnd - jsonText_.data();
+                        }
+                    }
+                    return buffer;
+                }
+
+                std::string_view parseKey(std::string &buffer)
+                {
+                    if (peekChar() != '\"') {
+                        ThrowSyntaxExcept("JSON String must begin with \'\"\'", jsonText_, peekPos());
+                    }
+                    return parseString(buffer);
+                }
+
+                void parseColon()
+                {
+                    if (peekChar() != ':') {
+                        ThrowSyntaxExcept("key and value must be separated by \':\'", jsonText_, peekPos());
+                    }
+                    cursor_++;
+                }
+
+                // Numbers and literals, anything else at the position is reported as an unknown item.
+                JSONItem parseScalar()
+                {
+                    auto pos = peekPos();
+                    cursor_++;
+                    JSONItem item{};
+                    auto endPos = ParseJSONScalar(jsonText_, pos, item);
+                    if (endPos == std::string_view::npos || isScalarChar_(endPos)) {
+                        stray_ = true;
+                        strayPos_ = endPos;
+                    }
+                    return item;
+                }
+
+            private:
+                std::string_view jsonText_;
+                const uint32_t* tokens_;
+                size_t count_;
+                size_t cursor_;
+                size_t offset_;
+                bool stray_;
+                size_t strayPos_;
+
+                bool isScalarChar_(size_t pos) const noexcept
+                {
+                    if (pos >= jsonText_.size()) {
+                        return false;
+                    }
+                    switch (jsonText_[pos]) {
+                        case ' ':
+                        case '\n':
+                        case '\t':
+                        case '\r':
+                        case '\f':
+                        case '\a':
+                        case '\b':
+                        case '\v':
+                        case '{':
+                        case '}':
+                        case '[':
+                        case ']':
+                        case ':':
+                        case ',':
+                        case '\"':
+                            return false;
+                        default:
+                            break;
+                    }
+                    return true;
+                }
+        };
+
+        class IndexedParser
+        {
+            public:
+                IndexedParser(std::string_view jsonText, const StructuralIndex &index,
+                    size_t maxDepth = defaultMaxDepth, size_t offset = 0) noexcept :
+                    jsonText_(jsonText),
+                    cursor_(jsonText, index, offset),
+                    maxDepth_(maxDepth),
+                    stack_()
+                { }
+
+                // Same results and errors as ParseJSONObject(jsonText, 0).
+                JSONObject parseObject()
+                {
+                    if (cursor_.peekChar() != '{') {
+                        ThrowSyntaxExcept("JSON Object must begin with \'{\'", jsonText_, cursor_.peekPos());
+                    }
+                    JSONItem item{};
+                    parseItem_(item, 0);
+                    return item.takeObject();
+                }
+
+                // Same results and errors as ParseJSONArray(jsonText, 0).
+                JSONArray parseArray()
+                {
+                    if (cursor_.peekChar() != '[') {
+                        ThrowSyntaxExcept("JSON Array must begin with \'[\'", jsonText_, 0);
+                    }
+                    JSONItem item{};
+                    parseItem_(item, 0);
+                    return item.takeArray();
+                }
+
+                // The item at the first token must be a container, returns the position after it.
+                size_t parseItem(JSONItem &item)
+                {
+                    return parseItem_(item, cursor_.peekPos());
+                }
+
+                // Parses count array elements, element idx begins at token elementTokens[idx]
+                // and must end right before the separator in front of elementTokens[idx + 1].
+                void parseElements(const uint32_t* elementTokens, size_t count, JSONItem* elements)
+                {
+                    cursor_.seek(elementTokens[0]);
+                    for (size_t idx = 0; idx < count; idx++) {
+                        parseItem_(elements[idx], cursor_.peekPos());
+                        auto ch = cursor_.peekChar();
+                        cursor_.skipToken();
+                        if ((ch != ',' && ch != ']') || cursor_.tell() != elementTokens[idx + 1]) {
+                            ThrowSyntaxExcept("JSON Array elements must be separated by \',\'", jsonText_, cursor_.peekPos());
+                        }
+                    }
+                }
+
+            private:
+                // An open container, its finished value is moved into target when it closes.
+                struct Frame_
+                {
+                    size_t beginPos;
+                    bool isObject;
+                    JSONItem* target;
+                    std::vector<JSONItem> elements;
+                    std::vector<JSONObject::JSONPair> members;
+                };
+
+                std::string_view jsonText_;
+                IndexedCursor cursor_;
+                size_t maxDepth_;
+                std::vector<Frame_> stack_;
+
+                std::string parseString_()
+                {
+                    std::string buffer{};
+                    auto str = cursor_.parseString(buffer);
+                    if (str.data() == buffer.data()) {
+                        return buffer;
+                    }
+                    return std::string(str);
+                }
+
+                void throwUnclosed_(const Frame_ &frame)
+                {
+                    if (frame.isObject) {
+                        ThrowSyntaxExcept("JSON Object must end with \'}\'", jsonText_, frame.beginPos);
+                    }
+                    ThrowSyntaxExcept("JSON Array must end with \']\'", jsonText_, frame.beginPos);
+                }
+
+                // Values are parsed in place into the slot of the innermost open container, the slot
+                // stays put while deeper containers are open since only the innermost one grows.
+                // Keys without escapes are interned straight from the text.
+                JSONItem* nextSlot_(Frame_ &frame)
+                {
+                    if (frame.isObject) {
+                        std::string buffer{};
+                        frame.members.emplace_back();
+                        auto &member = frame.members.back();
+                        member.key = JSONKey(cursor_.parseKey(buffer));
+                        cursor_.parseColon();
+                        return &member.value;
+                    }
+                    frame.elements.emplace_back();
+                    return &frame.elements.back();
+                }
+
+                // Mirrors ParseJSONTree token by token, the outermost container is reported at rootPos.
+                size_t parseItem_(JSONItem &item, size_t rootPos)
+                {
+                    stack_.clear();
+                    auto slot = &item;
+                    size_t endPos = 0;
+                    for (;;) {
+                        auto valuePos = cursor_.peekPos();
+                        auto ch = cursor_.peekChar();
+                        if (ch == '{' || ch == '[') {
+                            if (stack_.size() >= maxDepth_) {
+                                ThrowSyntaxExcept("JSON nesting exceeds the maximum depth", jsonText_, valuePos);
+                            }
+                            auto isObject = (ch == '{');
+                            cursor_.skipToken();
+                            auto pos = cursor_.peekPos();
+                            if (CharAt(jsonText_, pos) != (isObject ? '}' : ']')) {
+                                stack_.emplace_back();
+                                auto &frame = stack_.back();
+                                frame.beginPos = (stack_.size() == 1) ? rootPos : valuePos;
+                                frame.isObject = isObject;
+                                frame.target = slot;
+                                if (pos == std::string_view::npos) {
+                                    throwUnclosed_(frame);
+                                }
+                                slot = nextSlot_(frame);
+                                continue;
+                            }
+                            cursor_.skipToken();
+                            endPos = pos + 1;
+                            *slot = isObject ? JSONItem(JSONObject()) : JSONItem(JSONArray());
+                        } else if (ch == '\"') {
+                            *slot = parseString_();
+                        } else {
+                            *slot = cursor_.parseScalar();
+                        }
+
+                        for (;;) {
+                            if (stack_.empty()) {
+                                return endPos;
+                            }
+                            auto &frame = stack_.back();
+                            auto pos = cursor_.peekPos();
+                            auto next = cursor_.peekChar();
+                            if (next == ',') {
+                                cursor_.skipToken();
+                                if ((pos + 1) >= jsonText_.size()) {
+                                    throwUnclosed_(frame);
+                                }
+                                slot = nextSlot_(frame);
+                                break;
+                            }
+                            if (next != (frame.isObject ? '}' : ']')) {
+                                if (frame.isObject) {
+                                    ThrowSyntaxExcept("JSON Object elements must be separated by \',\'", jsonText_, pos);
+                                }
+                                ThrowSyntaxExcept("JSON Array elements must be separated by \',\'", jsonText_, pos);
+                            }
+                            cursor_.skipToken();
+                            endPos = pos + 1;
+                            if (frame.isObject) {
+                                *frame.target = JSONObject(std::move(frame.members));
+                            } else {
+                                *frame.target = JSONArray(std::move(frame.elements));
+                            }
+                            stack_.pop_back();
+                        }
+                    }
+                }
+        };
+
+        // The index is scratch state, kept by callers that parse repeatedly.
+        // Text the index cannot cover goes to the reference parser instead.
+        inline JSONObject ParseIndexedObject(std::string_view jsonText, StructuralIndex &index, size_t maxDepth = defaultMaxDepth)
+        {
+            index.build(jsonText);
+            if (index.usable(jsonText)) {
+                return IndexedParser(jsonText, index, maxDepth).parseObject();
+            }
+            return ParseJSONObject(jsonText, 0, maxDepth).resultVal;
+        }
+
+        inline JSONArray ParseIndexedArray(std::string_view jsonText, StructuralIndex &index, size_t maxDepth = defaultMaxDepth)
+        {
+            index.build(jsonText);
+            if (index.usable(jsonText)) {
+                return IndexedParser(jsonText, index, maxDepth).parseArray();
+            }
+            return ParseJSONArray(jsonText, 0, maxDepth).resultVal;
+        }
+
+        // endPos is where SkipJSONItem found the item to end, so the brackets in between are balanced
+        // and the index of that range alone gives the errors a parse of the whole text would.
+        inline JSONItem ParseIndexedItem(std::string_view jsonText, size_t beginPos, size_t endPos)
+        {
+            auto pos = IgnoreBlank(jsonText, beginPos);
+            if (pos != std::string_view::npos && pos < endPos && (jsonText[pos] == '{' || jsonText[pos] == '[')) {
+                auto itemText = jsonText.substr(pos, (endPos - pos));
+                StructuralIndex index{};
+                index.build(itemText);
+                if (index.usable(itemText)) {
+                    JSONItem item{};
+                    if (IndexedParser(jsonText, index, defaultMaxDepth, pos).parseItem(item) != endPos) {
+                        ThrowSyntaxExcept("unknown JSON Item", jsonText, pos);
+                    }
+                    return item;
+                }
+            }
+            auto itemResult = ParseJSONItem(jsonText, beginPos);
+            if (itemResult.endPos != endPos) {
+                ThrowSyntaxExcept("unknown JSON Item", jsonText, std::min(pos, jsonText.size()));
+            }
+            return std::move(itemResult.resultVal);
+        }
+
+        // Finds the end of the item at beginPos by quote and bracket matching only, 
+        // numbers / literals / escapes inside the skipped range are not validated.
+        inline size_t SkipJSONItem(std::string_view jsonText, size_t beginPos)
+        {
+            static const auto skipString = [](std::string_view jsonText, size_t beginPos) -> size_t {
+                auto pos = beginPos + 1;
+                while (pos < jsonText.size()) {
+                    auto quote = reinterpret_cast<const char*>(
+                        std::memchr((jsonText.data() + pos), '\"', (jsonText.size() - pos)));
+                    if (quote == nullptr) {
+                        break;
+                    }
+                    auto quotePos = static_cast<size_t>(quote - jsonText.data());
+                    size_t backslashes = 0;
+                    while ((quotePos - backslashes) > beginPos && jsonText[quotePos - backslashes - 1] == '\\') {
+                        backslashes++;
+                    }
+                    if ((backslashes % 2) == 0) {
+                        return quotePos + 1;
+                    }
+                    pos = quotePos + 1;
+                }
+                ThrowSyntaxExcept("JSON String must end with \'\"\'", jsonText, beginPos);
+                return std::string_view::npos;
+            };
+
+            auto pos = IgnoreBlank(jsonText, beginPos);
+            if (pos == std::string_view::npos) {
+                ThrowSyntaxExcept("unknown JSON Item", jsonText, beginPos);
+            }
+            switch (jsonText[pos]) {
+                case '\"':
+                    return skipString(jsonText, pos);
+                case '{':
+                case '[':
+                    {
+                        std::string brackets{};
+                        brackets.push_back(jsonText[pos]);
+                        auto itemPos = pos;
+                        pos++;
+                        while (pos < jsonText.size()) {
+                            switch (jsonText[pos]) {
+                                case '\"':
+                                    pos = skipString(jsonText, pos);
+                                    continue;
+                                case '{':
+                                case '[':
+                                    brackets.push_back(jsonText[pos]);
+                                    break;
+                                case '}':
+                                    if (brackets.back() != '{') {
+                                        ThrowSyntaxExcept("JSON Array must end with \']\'", jsonText, pos);
+                                    }
+                                    brackets.pop_back();
+                                    break;
+                                case ']':
+                                    if (brackets.back() != '[') {
+                                        ThrowSyntaxExcept("JSON Object must end with \'}\'", jsonText, pos);
+                                    }
+                                    brackets.pop_back();
+                                    break;
+                                default:
+                                    break;
+                            }
+                            pos++;
+                            if (brackets.empty()) {
+                                return pos;
+                            }
+                        }
+                        if (jsonText[itemPos] == '{') {
+                            ThrowSyntaxExcept("JSON Object must end with \'}\'", jsonText, itemPos);
+                        }
+                        ThrowSyntaxExcept("JSON Array must end with \']\'", jsonText, itemPos);
+                    }
+                    break;
+                case '}':
+                case ']':
+                case ',':
+                case ':':
+                    ThrowSyntaxExcept("unknown JSON Item", jsonText, pos);
+                    break;
+                default:
+                    while (pos < jsonText.size()) {
+                        switch (jsonText[pos]) {
+                            case ' ':
+                            case '\n':
+                            case '\t':
+                            case '\r':
+                            case '\f':
+                            case '\a':
+                            case '\b':
+                            case '\v':
+                            case ',':
+                            case '}':
+                            case ']':
+                                return pos;
+                            default:
+                                break;
+                        }
+                        pos++;
+                    }
+                    return pos;
+            }
+            return std::string_view::npos;
+        }
     }
 
-    inline JSONObject::JSONObject(const JSONObject &other) :
-        data_(other.data_),
-        order_(other.order_)
-    { }
+    inline JSONKey::JSONKey() noexcept : entry_(nullptr) { }
 
-    inline JSONObject::JSONObject(JSONObject &&other) noexcept :
-        data_(std::move(other.data_)),
-        order_(std::move(other.order_))
-    { }
+    // The empty key is not interned, it is the null entry.
+    inline JSONKey::JSONKey(std::string_view key) : entry_(nullptr)
+    {
+        if (!key.empty()) {
+            entry_ = _JSON_Key_Table::Instance().acquire(key, _JSON_Key_Table::Hash(key));
+        }
+    }
 
-    inline JSONObject::JSONObject(std::unordered_map<std::string, JSONItem> &&data, std::vector<std::string> &&order) noexcept :
-        data_(data),
-        order_(order)
-    { }
+    inline JSONKey::JSONKey(const JSONKey &other) noexcept : entry_(other.entry_)
+    {
+        if (entry_ != nullptr) {
+            _JSON_Key_Table::Instance().retain(entry_);
+        }
+    }
 
-    inline JSONObject::~JSONObject() { }
+    inline JSONKey::JSONKey(JSONKey &&other) noexcept : entry_(other.entry_)
+    {
+        other.entry_ = nullptr;
+    }
 
-    inline JSONObject &JSONObject::operator=(const JSONObject &other)
+    inline JSONKey::~JSONKey()
     {
-        if (std::addressof(other) != this) {
-            data_ = other.data_;
-            order_ = other.order_;
+        if (entry_ != nullptr) {
+            _JSON_Key_Table::Instance().release(entry_);
         }
-        return *this;
     }
 
-    inline JSONObject &JSONObject::operator=(JSONObject &&other) noexcept
+    inline JSONKey &JSONKey::operator=(const JSONKey &other) noexcept
     {
-        if (std::addressof(other) != this) {
-            data_ = std::move(other.data_);
-            order_ = std::move(other.order_);
+        if (other.entry_ != entry_) {
+            JSONKey copied(other);
+            std::swap(entry_, copied.entry_);
         }
         return *this;
     }
 
-    inline JSONObject &JSONObject::operator+=(const JSONObject &other)
+    inline JSONKey &JSONKey::operator=(JSONKey &&other) noexcept
     {
         if (std::addressof(other) != this) {
-            const auto &other_data = other.data_;
-            const auto &other_order = other.order_;
-            for (const auto &key : other_order) {
-                if (data_.count(key) == 0) {
-                    order_.emplace_back(key);
-                    data_.emplace(key, other_data.at(key));
-                } else {
-                    data_[key] = other_data.at(key);
-                }
-            }
+            std::swap(entry_, other.entry_);
         }
         return *this;
     }
 
-    inline JSONObject JSONObject::operator+(const JSONObject &other) const
+    inline bool JSONKey::operator==(const JSONKey &other) const noexcept
     {
-        std::unordered_map<std::string, JSONItem> merged_data(other.data_);
-        std::vector<std::string> merged_order(other.order_);
-        for (const auto &key : order_) {
-            if (merged_data.count(key) == 1) {
-                merged_data[key] = data_.at(key);
-            } else {
-                merged_order.emplace_back(key);
-                merged_data.emplace(key, data_.at(key));
-            }
-        }
-        return JSONObject(std::move(merged_data), std::move(merged_order));
+        return (entry_ == other.entry_);
     }
 
-    inline bool JSONObject::operator==(const JSONObject &other) const
+    inline bool JSONKey::operator!=(const JSONKey &other) const noexcept
     {
-        return (data_ == other.data_ && order_ == other.order_);
+        return (entry_ != other.entry_);
     }
 
-    inline bool JSONObject::operator!=(const JSONObject &other) const
+    inline bool JSONKey::operator==(std::string_view other) const noexcept
     {
-        return (data_ != other.data_ || order_ != other.order_);
+        return (view() == other);
     }
 
-    inline bool JSONObject::contains(const std::string &key) const
+    inline bool JSONKey::operator!=(std::string_view other) const noexcept
     {
-        return (data_.count(key) == 1);
+        return (view() != other);
     }
 
-    inline JSONItem &JSONObject::operator[](const std::string &key)
+    inline bool JSONKey::operator<(const JSONKey &other) const noexcept
     {
-        if (data_.count(key) == 0) {
-            order_.emplace_back(key);
-        }
-        return data_[key];
+        return (view() < other.view());
     }
 
-    inline const JSONItem &JSONObject::at(const std::string &key) const
+    inline JSONKey::operator const std::string &() const noexcept
     {
-        auto iter = data_.find(key);
-        if (iter == data_.end()) {
-            throw JSONExcept("Key not found");
-        }
-        return iter->second;
+        return str();
     }
 
-    inline void JSONObject::add(const std::string &key, const JSONItem &value)
+    inline JSONKey::operator std::string_view() const noexcept
     {
-        if (data_.count(key) == 0) {
-            order_.emplace_back(key);
-            data_.emplace(key, value);
-        } else {
-            data_[key] = value;
-        }
+        return view();
     }
 
-    inline void JSONObject::remove(const std::string &key)
+    inline char JSONKey::operator[](size_t pos) const noexcept
     {
-        auto iter = std::find(order_.begin(), order_.end(), key);
-        if (iter == order_.end()) {
-            throw JSONExcept("Key not found");
-        }
-        data_.erase(key);
-        order_.erase(iter);
+        return str()[pos];
     }
 
-    inline void JSONObject::clear()
+    inline const std::string &JSONKey::str() const noexcept
     {
-        data_.clear();
-        order_.clear();
+        static const std::string emptyKey{};
+        return (entry_ != nullptr) ? entry_->key : emptyKey;
     }
 
-    inline size_t JSONObject::size() const
+    inline std::string_view JSONKey::view() const noexcept
     {
-        return data_.size();
+        return str();
     }
 
-    inline size_t JSONObject::hash() const
+    inline const char* JSONKey::data() const noexcept
     {
-        size_t hashVal = data_.size();
-        for (auto iter = data_.begin(); iter != data_.end(); ++iter) {
-            hashVal ^= (iter->second).hash() + 2654435769 + (hashVal << 6) + (hashVal >> 2);
-        }
-        return hashVal;
+        return str().data();
     }
 
-    inline bool JSONObject::empty() const
+    inline const char* JSONKey::c_str() const noexcept
     {
-        return (data_.begin() == data_.end());
+        return str().c_str();
     }
 
-    inline _JSON_String JSONObject::toRaw() const
+    inline size_t JSONKey::size() const noexcept
     {
-        if (order_.size() == 1) {
-            _JSON_String jsonText("{");
-            jsonText.append(_StringToJSONRaw(order_.front()));
-            jsonText.append(':');
-            jsonText.append(data_.at(order_.front()).toRaw().data());
-            jsonText.append('}');
-            return jsonText;
-        } else if (order_.size() > 1) {
-            _JSON_String jsonText("{");
-            for (auto iter = order_.begin(); iter < (order_.end() - 1); ++iter) {
-                const auto &key = *iter;
-                jsonText.append(_StringToJSONRaw(key));
-                jsonText.append(':');
-                jsonText.append(data_.at(key).toRaw().data());
-                jsonText.append(',');
-            }
-            jsonText.append(_StringToJSONRaw(order_.back()));
-            jsonText.append(':');
-            jsonText.append(data_.at(order_.back()).toRaw().data());
-            jsonText.append('}');
-            return jsonText;
-        }
-        return "{}";
+        return (entry_ != nullptr) ? entry_->key.size() : 0;
     }
 
-    inline std::string JSONObject::toString() const
+    inline size_t JSONKey::length() const noexcept
     {
-        return toRaw().data();
+        return size();
     }
 
-    inline std::string JSONObject::toFormatedString() const
-    {
-        if (order_.size() == 1) {
-            _JSON_String jsonText("{\n");
-            jsonText.append(_StringToJSONRaw(order_.front()));
-            jsonText.append(": ");
-            jsonText.append(data_.at(order_.front()).toRaw().data());
-            jsonText.append("\n }");
-            return jsonText.data();
-        } else if (order_.size() > 1) {
-            _JSON_String jsonText("{\n");
-            for (auto iter = order_.begin(); iter < (order_.end() - 1); ++iter) {
-                const auto &key = *iter;
-                jsonText.append("  ");
-                jsonText.append(_StringToJSONRaw(key));
-                jsonText.append(": ");
-                jsonText.append(data_.at(key).toRaw().data());
-                jsonText.append(",\n");
-            }
-            jsonText.append("  ");
-            jsonText.append(_StringToJSONRaw(order_.back()));
-            jsonText.append(": ");
-            jsonText.append(data_.at(order_.back()).toRaw().data());
-            jsonText.append("\n}");
-            return jsonText.data();
-        }
-        return "{ }";
-    }
-
-    inline const std::unordered_map<std::string, JSONItem> &JSONObject::data() const
+    inline size_t JSONKey::hash() const noexcept
     {
-        return data_;
+        static const auto emptyHash = _JSON_Key_Table::Hash({});
+        return (entry_ != nullptr) ? entry_->hash : emptyHash;
     }
 
-    inline const std::vector<std::string> &JSONObject::order() const
+    inline bool JSONKey::empty() const noexcept
     {
-        return order_;
+        return (entry_ == nullptr);
     }
 
-    inline std::vector<JSONObject::JSONPair> JSONObject::toPairs() const
+    inline int JSONKey::compare(std::string_view other) const noexcept
     {
-        std::vector<JSONPair> pairs{};
-        pairs.resize(order_.size());
-        for (size_t pos = 0; pos < pairs.size(); pos++) {
-            pairs[pos].key = order_[pos];
-            pairs[pos].value = data_.at(pairs[pos].key);
-        }
-        return pairs;
+        return view().compare(other);
     }
 
-    namespace JSONBinary
+    inline std::string::const_iterator JSONKey::begin() const noexcept
     {
-        typedef uint32_t pos_t;
-        typedef int8_t byte_t;
+        return str().begin();
+    }
 
-        constexpr pos_t npos = static_cast<pos_t>(-1);
+    inline std::string::const_iterator JSONKey::end() const noexcept
+    {
+        return str().end();
+    }
 
-        inline void* _Move_Ptr(void* ptr, pos_t pos) noexcept
-        {
-            return reinterpret_cast<void*>(reinterpret_cast<byte_t*>(ptr) + pos);
-        }
+    inline std::string operator+(const JSONKey &lhs, const JSONKey &rhs)
+    {
+        return (lhs.str() + rhs.str());
+    }
 
-        inline const void* _Move_Ptr(const void* ptr, pos_t pos) noexcept
-        {
-            return reinterpret_cast<const void*>(reinterpret_cast<const byte_t*>(ptr) + pos);
-        }
+    inline std::string operator+(const JSONKey &lhs, std::string_view rhs)
+    {
+        std::string result(lhs.str());
+        result.append(rhs.data(), rhs.size());
+        return result;
+    }
+
+    inline std::string operator+(std::string_view lhs, const JSONKey &rhs)
+    {
+        std::string result(lhs);
+        result.append(rhs.str());
+        return result;
+    }
+
+    inline std::string operator+(const JSONKey &lhs, char rhs)
+    {
+        return (lhs.str() + rhs);
+    }
+
+    inline std::string operator+(char lhs, const JSONKey &rhs)
+    {
+        return (lhs + rhs.str());
+    }
+
+    inline bool operator==(std::string_view lhs, const JSONKey &rhs) noexcept
+    {
+        return (rhs == lhs);
+    }
+
+    inline bool operator!=(std::string_view lhs, const JSONKey &rhs) noexcept
+    {
+        return (rhs != lhs);
+    }
+
+    inline std::ostream &operator<<(std::ostream &stream, const JSONKey &key)
+    {
+        return (stream << key.str());
+    }
+
+    inline JSONItem::JSONItem() :
+        type_(ItemType::ITEM_NULL),
+        exposed_(false),
+        value_(ItemNull())
+    { }
+
+    inline JSONItem::JSONItem(ItemNull _null) :
+        type_(ItemType::ITEM_NULL),
+        exposed_(false),
+        value_(ItemNull())
+    {
+        (void)_null;
+    }
+
+    inline JSONItem::JSONItem(bool value) :
+        type_(ItemType::BOOLEAN),
+        exposed_(false),
+        value_(value)
+    { }
+
+    inline JSONItem::JSONItem(int value) :
+        type_(ItemType::INTEGER),
+        exposed_(false),
+        value_(value)
+    { }
+
+    inline JSONItem::JSONItem(int64_t value) :
+        type_(ItemType::LONG),
+        exposed_(false),
+        value_(value)
+    { }
+
+    inline JSONItem::JSONItem(double value) :
+        type_(ItemType::DOUBLE),
+        exposed_(false),
+        value_(value)
+    { }
+
+    inline JSONItem::JSONItem(const char* value) :
+        type_(ItemType::STRING),
+        exposed_(false),
+        value_(std::string(value))
+    { }
+
+    inline JSONItem::JSONItem(const std::string &value) :
+        type_(ItemType::STRING),
+        exposed_(false),
+        value_(value)
+    { }
+
+    inline JSONItem::JSONItem(std::string &&value) noexcept :
+        type_(ItemType::STRING),
+        exposed_(false),
+        value_(std::move(value))
+    { }
+
+    inline JSONItem::JSONItem(const JSONArray &value) :
+        type_(ItemType::ARRAY),
+        exposed_(false),
+        value_(new JSONArray(value))
+    { }
+
+    inline JSONItem::JSONItem(JSONArray &&value) :
+        type_(ItemType::ARRAY),
+        exposed_(false),
+        value_(new JSONArray(std::move(value)))
+    { }
+
+    inline JSONItem::JSONItem(const JSONObject &value) :
+        type_(ItemType::OBJECT),
+        exposed_(false),
+        value_(new JSONObject(value))
+    { }
+
+    inline JSONItem::JSONItem(JSONObject &&value) :
+        type_(ItemType::OBJECT),
+        exposed_(false),
+        value_(new JSONObject(std::move(value)))
+    { }
+
+    inline JSONItem::JSONItem(const JSONItem &other) : type_(other.type_), exposed_(false), value_()
+    {
+        const auto &other_value = other.value_;
+        if (type_ == ItemType::ARRAY) {
+            const auto &jsonArray = *(std::get<JSONArray*>(other_value));
+            value_ = new JSONArray(jsonArray);
+        } else if (type_ == ItemType::OBJECT) {
+            const auto &jsonObject = *(std::get<JSONObject*>(other_value));
+            value_ = new JSONObject(jsonObject);
+        } else {
+            value_ = other_value;
+        }
+    }
+
+    // Moving out of an item is a write to it, as it may sit in a tree.
+    inline JSONItem::JSONItem(JSONItem &&other) noexcept : 
+        type_(other.type_), 
+        exposed_(false), 
+        value_(std::move(other.value_)) 
+    {
+        _JSON_Hash_Generation::Advance();
+        other.type_ = ItemType::ITEM_NULL;
+        other.exposed_ = false;
+        other.value_ = ItemValue();
+    }
+
+    inline JSONItem::~JSONItem()
+    {
+        if (type_ == ItemType::ARRAY || type_ == ItemType::OBJECT) {
+            destroy_();
+        }
+    }
+
+    inline JSONItem &JSONItem::operator=(const JSONItem &other)
+    {
+        if (std::addressof(other) != this) {
+            clear();
+            type_ = other.type_;
+            const auto &other_value = other.value_;
+            if (type_ == ItemType::ARRAY) {
+                const auto &jsonArray = *(std::get<JSONArray*>(other_value));
+                value_ = new JSONArray(jsonArray);
+            } else if (type_ == ItemType::OBJECT) {
+                const auto &jsonObject = *(std::get<JSONObject*>(other_value));
+                value_ = new JSONObject(jsonObject);
+            } else {
+                value_ = other_value;
+            }
+        }
+        return *this;
+    }
+
+    inline JSONItem &JSONItem::operator=(JSONItem &&other) noexcept
+    {
+        if (std::addressof(other) != this) {
+            clear();
+            type_ = other.type_;
+            value_ = std::move(other.value_);
+
+            other.type_ = ItemType::ITEM_NULL;
+            other.exposed_ = false;
+            other.value_ = ItemValue();
+        }
+        return *this;
+    }
+
+    inline bool JSONItem::operator==(const JSONItem &other) const
+    {
+        if (type_ != other.type_) {
+            return false;
+        }
+        switch (type_) {
+            case ItemType::ARRAY:
+                return (*(std::get<JSONArray*>(value_)) == *(std::get<JSONArray*>(other.value_)));
+            case ItemType::OBJECT:
+                return (*(std::get<JSONObject*>(value_)) == *(std::get<JSONObject*>(other.value_)));
+            default:
+                break;
+        }
+        return (value_ == other.value_);
+    }
+
+    inline bool JSONItem::operator!=(const JSONItem &other) const
+    {
+        return !(*this == other);
+    }
+
+    inline JSONItem::operator bool() const
+    {
+        return toBoolean();
+    }
+
+    inline JSONItem::operator int() const
+    {
+        return toInt();
+    }
+
+    inline JSONItem::operator int64_t() const
+    {
+        return toLong();
+    }
+
+    inline JSONItem::operator double() const
+    {
+        return toDouble();
+    }
+
+    inline JSONItem::operator std::string() const
+    {
+        return toString();
+    }
+
+    inline bool JSONItem::isNull() const
+    {
+        return (type_ == ItemType::ITEM_NULL);
+    }
+
+    inline bool JSONItem::isBoolean() const
+    {
+        return (type_ == ItemType::BOOLEAN);
+    }
+
+    inline bool JSONItem::isInt() const
+    {
+        return (type_ == ItemType::INTEGER);
+    }
+
+    inline bool JSONItem::isLong() const
+    {
+        return (type_ == ItemType::LONG);
+    }
+
+    inline bool JSONItem::isDouble() const
+    {
+        return (type_ == ItemType::DOUBLE);
+    }
+
+    inline bool JSONItem::isString() const
+    {
+        return (type_ == ItemType::STRING);
+    }
+
+    inline bool JSONItem::isArray() const
+    {
+        return (type_ == ItemType::ARRAY);
+    }
+
+    inline bool JSONItem::isObject() const
+    {
+        return (type_ == ItemType::OBJECT);
+    }
+
+    inline bool JSONItem::toBoolean() const
+    {
+        if (type_ != ItemType::BOOLEAN) {
+            throw JSONExcept("Item is not of boolean type");
+        }
+        return std::get<bool>(value_);
+    }
+
+    inline int JSONItem::toInt() const
+    {
+        if (type_ != ItemType::INTEGER) {
+            throw JSONExcept("Item is not of int type");
+        }
+        return std::get<int>(value_);
+    }
+
+    inline int64_t JSONItem::toLong() const
+    {
+        if (type_ != ItemType::LONG) {
+            throw JSONExcept("Item is not of long type");
+        }
+        return std::get<int64_t>(value_);
+    }
+
+    inline double JSONItem::toDouble() const
+    {
+        if (type_ != ItemType::DOUBLE) {
+            throw JSONExcept("Item is not of double type");
+        }
+        return std::get<double>(value_);
+    }
+
+    inline std::string JSONItem::toString() const
+    {
+        if (type_ != ItemType::STRING) {
+            throw JSONExcept("Item is not of string type");
+        }
+        return std::get<std::string>(value_);
+    }
+
+    inline JSONArray JSONItem::toArray() const
+    {
+        if (type_ != ItemType::ARRAY) {
+            throw JSONExcept("Item is not of array type");
+        }
+        return *(std::get<JSONArray*>(value_));
+    }
+
+    inline JSONObject JSONItem::toObject() const
+    {
+        if (type_ != ItemType::OBJECT) {
+            throw JSONExcept("Item is not of object type");
+        }
+        return *(std::get<JSONObject*>(value_));
+    }
+
+    // References stay valid until the item is assigned to or destroyed.
+    inline const std::string &JSONItem::asString() const
+    {
+        if (type_ != ItemType::STRING) {
+            throw JSONExcept("Item is not of string type");
+        }
+        return std::get<std::string>(value_);
+    }
+
+    inline const JSONArray &JSONItem::asArray() const
+    {
+        if (type_ != ItemType::ARRAY) {
+            throw JSONExcept("Item is not of array type");
+        }
+        return *(std::get<JSONArray*>(value_));
+    }
+
+    inline const JSONObject &JSONItem::asObject() const
+    {
+        if (type_ != ItemType::OBJECT) {
+            throw JSONExcept("Item is not of object type");
+        }
+        return *(std::get<JSONObject*>(value_));
+    }
+
+    // Writes through the reference cannot advance the hash generation, so it is advanced once here 
+    // and no container holding the item memoises its hash until the string is replaced.
+    inline std::string &JSONItem::asString()
+    {
+        if (type_ != ItemType::STRING) {
+            throw JSONExcept("Item is not of string type");
+        }
+        if (!exposed_) {
+            exposed_ = true;
+            _JSON_Hash_Generation::Advance();
+        }
+        return std::get<std::string>(value_);
+    }
+
+    // The container may be written through the reference after it is moved into another one, 
+    // so it is exposed and the containers holding it check the hash generation.
+    inline JSONArray &JSONItem::asArray()
+    {
+        if (type_ != ItemType::ARRAY) {
+            throw JSONExcept("Item is not of array type");
+        }
+        auto array = std::get<JSONArray*>(value_);
+        array->expose_();
+        return *array;
+    }
+
+    inline JSONObject &JSONItem::asObject()
+    {
+        if (type_ != ItemType::OBJECT) {
+            throw JSONExcept("Item is not of object type");
+        }
+        auto object = std::get<JSONObject*>(value_);
+        object->expose_();
+        return *object;
+    }
+
+    // Moves the value out, the item keeps its type and is left empty.
+    inline std::string JSONItem::takeString()
+    {
+        if (type_ != ItemType::STRING) {
+            throw JSONExcept("Item is not of string type");
+        }
+        _JSON_Hash_Generation::Advance();
+        return std::move(std::get<std::string>(value_));
+    }
+
+    inline JSONArray JSONItem::takeArray()
+    {
+        if (type_ != ItemType::ARRAY) {
+            throw JSONExcept("Item is not of array type");
+        }
+        return std::move(*std::get<JSONArray*>(value_));
+    }
+
+    inline JSONObject JSONItem::takeObject()
+    {
+        if (type_ != ItemType::OBJECT) {
+            throw JSONExcept("Item is not of object type");
+        }
+        return std::move(*std::get<JSONObject*>(value_));
+    }
+
+    inline _JSON_String JSONItem::toRaw() const
+    {
+        _JSON_String raw{};
+        {
+            JSONWriter writer([&raw](const char* data, size_t size) { raw.append(data, size); });
+            writer.write(*this);
+            writer.flush();
+        }
+        return raw;
+    }
+
+    inline void JSONItem::clear()
+    {
+        _JSON_Hash_Generation::Advance();
+        if (type_ == ItemType::ARRAY || type_ == ItemType::OBJECT) {
+            destroy_();
+        }
+        type_ = ItemType::ITEM_NULL;
+        exposed_ = false;
+        value_ = nullptr;
+    }
+
+    // Containers are deleted recursively for the first levels only, deeper ones are deferred to a per-thread 
+    // list drained by the outermost call, so freeing a deep tree does not grow the stack once per level.
+    // A deferred container is only waiting to be deleted, its hash_ links it into the list, so deferring 
+    // never allocates.
+    inline void JSONItem::destroy_() noexcept
+    {
+        static constexpr size_t recursionDepth = 32;
+
+        thread_local size_t depth = 0;
+        thread_local JSONArray* deferredArrays = nullptr;
+        thread_local JSONObject* deferredObjects = nullptr;
+
+        if (depth >= recursionDepth) {
+            if (type_ == ItemType::ARRAY) {
+                auto array = std::get<JSONArray*>(value_);
+                array->hash_.store(reinterpret_cast<size_t>(deferredArrays), std::memory_order_relaxed);
+                deferredArrays = array;
+            } else {
+                auto object = std::get<JSONObject*>(value_);
+                object->hash_.store(reinterpret_cast<size_t>(deferredObjects), std::memory_order_relaxed);
+                deferredObjects = object;
+            }
+            type_ = ItemType::ITEM_NULL;
+            return;
+        }
+        depth++;
+        if (type_ == ItemType::ARRAY) {
+            delete std::get<JSONArray*>(value_);
+        } else {
+            delete std::get<JSONObject*>(value_);
+        }
+        type_ = ItemType::ITEM_NULL;
+        if (depth == 1) {
+            while (deferredArrays != nullptr || deferredObjects != nullptr) {
+                if (deferredArrays != nullptr) {
+                    auto array = deferredArrays;
+                    deferredArrays = reinterpret_cast<JSONArray*>(array->hash_.load(std::memory_order_relaxed));
+                    delete array;
+                } else {
+                    auto object = deferredObjects;
+                    deferredObjects = reinterpret_cast<JSONObject*>(object->hash_.load(std::memory_order_relaxed));
+                    delete object;
+                }
+            }
+        }
+        depth--;
+    }
+
+    inline size_t JSONItem::size() const
+    {
+        switch (type_) {
+            case ItemType::STRING:
+                return std::get<std::string>(value_).size();
+            case ItemType::ARRAY:
+                return std::get<JSONArray*>(value_)->size();
+            case ItemType::OBJECT:
+                return std::get<JSONObject*>(value_)->size();
+            default:
+                break;
+        }
+        return 1;
+    }
+
+    inline size_t JSONItem::hash() const
+    {
+        auto scope = HashScope_::CONTAINER;
+        return computeHash_(scope);
+    }
+
+    inline JSONItem::ItemType JSONItem::type() const
+    {
+        return type_;
+    }
+
+    // scope is widened to how long the hash of the item holds for the containers holding it.
+    inline size_t JSONItem::computeHash_(HashScope_ &scope) const
+    {
+        switch (type_) {
+            case ItemType::ITEM_NULL:
+                break;
+            case ItemType::BOOLEAN:
+                {
+                    std::hash<bool> hashVal{};
+                    return hashVal(std::get<bool>(value_));
+                }
+            case ItemType::INTEGER:
+                {
+                    std::hash<int> hashVal{};
+                    return hashVal(std::get<int>(value_));
+                }
+            case ItemType::LONG:
+                {
+                    std::hash<int64_t> hashVal{};
+                    return hashVal(std::get<int64_t>(value_));
+                }
+            case ItemType::DOUBLE:
+                {
+                    std::hash<double> hashVal{};
+                    return hashVal(std::get<double>(value_));
+                }
+            case ItemType::STRING:
+                {
+                    if (exposed_) {
+                        scope = HashScope_::NONE;
+                    }
+                    std::hash<std::string> hashVal{};
+                    return hashVal(std::get<std::string>(value_));
+                }
+            case ItemType::ARRAY:
+                return std::get<JSONArray*>(value_)->computeHash_(scope);
+            case ItemType::OBJECT:
+                return std::get<JSONObject*>(value_)->computeHash_(scope);
+            default:
+                break;
+        }
+        return 0;
+    }
+
+    inline JSONArray::JSONArray() : data_(), hash_(0), memoGeneration_(0), exposed_(false) { }
+
+    inline JSONArray::JSONArray(size_t init_size) : data_(init_size), hash_(0), memoGeneration_(0), exposed_(false) { }
+
+    inline JSONArray::JSONArray(size_t init_size, const JSONItem &init_value) : data_(init_size, init_value), hash_(0), memoGeneration_(0), exposed_(false) { }
+
+    inline JSONArray::JSONArray(iterator begin_iter, iterator end_iter) : data_(begin_iter, end_iter), hash_(0), memoGeneration_(0), exposed_(false) { }
+
+    inline JSONArray::JSONArray(std::string_view jsonText) : data_(), hash_(0), memoGeneration_(0), exposed_(false)
+    {
+        auto array = _JSON_Parse_Utils::ParseJSONArray(jsonText, 0).resultVal;
+        data_ = std::move(array.data_);
+    }
+
+    inline JSONArray::JSONArray(const std::vector<JSONItem> &data) : data_(data), hash_(0), memoGeneration_(0), exposed_(false) { }
+
+    // The elements are adopted, references into data must not be written through afterwards.
+    inline JSONArray::JSONArray(std::vector<JSONItem> &&data) noexcept : data_(std::move(data)), hash_(0), memoGeneration_(0), exposed_(false) { }
+
+    // A copy is not exposed, a hash that holds for other holds for it until it is modified.
+    inline JSONArray::JSONArray(const JSONArray &other) : data_(other.data_), hash_(0), memoGeneration_(0), exposed_(false)
+    {
+        size_t hashVal = 0;
+        auto scope = JSONItem::HashScope_::CONTAINER;
+        if (other.cachedHash_(hashVal, scope)) {
+            memoise_(hashVal, JSONItem::HashScope_::CONTAINER);
+        }
+    }
+
+    // References into other now point into the array, so it takes over whether other was exposed.
+    inline JSONArray::JSONArray(JSONArray &&other) noexcept : 
+        data_(std::move(other.data_)), 
+        hash_(other.hash_.load(std::memory_order_relaxed)), 
+        memoGeneration_(other.memoGeneration_.load(std::memory_order_relaxed)), 
+        exposed_(other.exposed_)
+    {
+        other.resetHash_();
+    }
+
+    inline JSONArray::~JSONArray() { }
+
+    // Assignment keeps an exposed array exposed, references into it or to it stay usable.
+    inline JSONArray &JSONArray::operator=(const JSONArray &other)
+    {
+        if (std::addressof(other) != this) {
+            resetHash_();
+            data_ = other.data_;
+            size_t hashVal = 0;
+            auto scope = (exposed_ ? JSONItem::HashScope_::GENERATION : JSONItem::HashScope_::CONTAINER);
+            if (other.cachedHash_(hashVal, scope)) {
+                memoise_(hashVal, scope);
+            }
+        }
+        return *this;
+    }
+
+    inline JSONArray &JSONArray::operator=(JSONArray &&other) noexcept
+    {
+        if (std::addressof(other) != this) {
+            resetHash_();
+            data_ = std::move(other.data_);
+            exposed_ = (exposed_ || other.exposed_);
+            size_t hashVal = 0;
+            auto scope = (exposed_ ? JSONItem::HashScope_::GENERATION : JSONItem::HashScope_::CONTAINER);
+            if (other.cachedHash_(hashVal, scope)) {
+                memoise_(hashVal, scope);
+            }
+            other.resetHash_();
+        }
+        return *this;
+    }
+
+    inline JSONArray &JSONArray::operator+=(const JSONArray &other)
+    {
+        resetHash_();
+        if (std::addressof(other) != this) {
+            const auto &other_data = other.data_;
+            for (auto iter = other_data.begin(); iter < other_data.end(); ++iter) {
+                data_.emplace_back(*iter);
+            }
+        }
+        return *this;
+    }
+
+    inline JSONArray &JSONArray::operator+=(JSONArray &&other)
+    {
+        resetHash_();
+        if (std::addressof(other) != this) {
+            if (data_.empty()) {
+                data_ = std::move(other.data_);
+                if (other.exposed_) {
+                    expose_();
+                }
+            } else {
+                data_.reserve(data_.size() + other.data_.size());
+                for (auto &item : other.data_) {
+                    data_.emplace_back(std::move(item));
+                }
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    inline JSONArray JSONArray::operator+(const JSONArray &other) const
+    {
+        auto merged_data = data_;
+        if (std::addressof(other) != this) {
+            const auto &other_data = other.data_;
+            for (auto iter = other_data.begin(); iter < other_data.end(); ++iter) {
+                merged_data.emplace_back(*iter);
+            }
+        }
+        return JSONArray(merged_data);
+    }
+
+    // Hashes memoised on both sides still hold, different ones settle the comparison.
+    inline bool JSONArray::operator==(const JSONArray &other) const
+    {
+        if (std::addressof(other) == this) {
+            return true;
+        }
+        if (data_.size() != other.data_.size()) {
+            return false;
+        }
+        size_t hashVal = 0, otherHashVal = 0;
+        auto scope = JSONItem::HashScope_::CONTAINER;
+        if (cachedHash_(hashVal, scope) && other.cachedHash_(otherHashVal, scope) && hashVal != otherHashVal) {
+            return false;
+        }
+        return (data_ == other.data_);
+    }
+
+    inline bool JSONArray::operator!=(const JSONArray &other) const
+    {
+        return !(*this == other);
+    }
+
+    inline JSONItem &JSONArray::operator[](size_t pos)
+    {
+        expose_();
+        if (pos >= data_.size()) {
+            throw JSONExcept("Position out of bounds");
+        }
+        return data_.at(pos);
+    }
+
+    inline const JSONItem &JSONArray::at(size_t pos) const
+    {
+        if (pos >= data_.size()) {
+            throw JSONExcept("Position out of bounds");
+        }
+        return data_.at(pos);
+    }
+
+    inline JSONArray::iterator JSONArray::find(const JSONItem &item)
+    {
+        expose_();
+        if (data_.begin() == data_.end()) {
+            return data_.end();
+        }
+        return std::find(data_.begin(), data_.end(), item);
+    }
+
+    inline void JSONArray::add(const JSONItem &item)
+    {
+        resetHash_();
+        data_.emplace_back(item);
+    }
+
+    inline void JSONArray::add(JSONItem &&item)
+    {
+        resetHash_();
+        data_.emplace_back(std::move(item));
+    }
+
+    template <typename ..._Args>
+    JSONItem &JSONArray::emplace(_Args &&...args)
+    {
+        expose_();
+        return data_.emplace_back(std::forward<_Args>(args)...);
+    }
+
+    inline void JSONArray::insert(size_t pos, const JSONItem &item)
+    {
+        if (pos > data_.size()) {
+            throw JSONExcept("Position out of bounds");
+        }
+        resetHash_();
+        data_.insert((data_.begin() + pos), item);
+    }
+
+    inline void JSONArray::insert(size_t pos, JSONItem &&item)
+    {
+        if (pos > data_.size()) {
+            throw JSONExcept("Position out of bounds");
+        }
+        resetHash_();
+        data_.insert((data_.begin() + pos), std::move(item));
+    }
+
+    inline void JSONArray::erase(size_t pos)
+    {
+        if (pos >= data_.size()) {
+            throw JSONExcept("Position out of bounds");
+        }
+        resetHash_();
+        data_.erase(data_.begin() + pos);
+    }
+
+    inline void JSONArray::remove(const JSONItem &item)
+    {
+        auto iter = std::find(data_.begin(), data_.end(), item);
+        if (iter == data_.end()) {
+            throw JSONExcept("Item not found");
+        }
+        resetHash_();
+        data_.erase(iter);
+    }
+
+    inline void JSONArray::resize(size_t new_size)
+    {
+        resetHash_();
+        data_.resize(new_size);
+    }
+
+    inline void JSONArray::clear()
+    {
+        resetHash_();
+        data_.clear();
+    }
+
+    inline size_t JSONArray::size() const
+    {
+        return data_.size();
+    }
+
+    // Memoised until the array is modified. Once the array or a container below it is exposed, 
+    // only until any JSON value is written, and not at all while a string below is exposed.
+    inline size_t JSONArray::hash() const
+    {
+        auto scope = JSONItem::HashScope_::CONTAINER;
+        return computeHash_(scope);
+    }
+
+    inline bool JSONArray::empty() const
+    {
+        return (data_.begin() == data_.end());
+    }
+
+    inline _JSON_String JSONArray::toRaw() const
+    {
+        _JSON_String raw{};
+        {
+            JSONWriter writer([&raw](const char* data, size_t size) { raw.append(data, size); });
+            writer.write(*this);
+            writer.flush();
+        }
+        return raw;
+    }
+
+    inline std::string JSONArray::toString() const
+    {
+        std::string jsonText{};
+        {
+            JSONWriter writer(jsonText);
+            writer.write(*this);
+        }
+        return jsonText;
+    }
+
+    inline const std::vector<JSONItem> &JSONArray::data() const
+    {
+        return data_;
+    }
+
+    inline JSONItem &JSONArray::front()
+    {
+        expose_();
+        return data_.front();
+    }
+
+    inline JSONItem &JSONArray::back()
+    {
+        expose_();
+        return data_.back();
+    }
+
+    inline const JSONItem &JSONArray::front() const
+    {
+        return data_.front();
+    }
+
+    inline const JSONItem &JSONArray::back() const
+    {
+        return data_.back();
+    }
+
+    inline JSONArray::iterator JSONArray::begin()
+    {
+        expose_();
+        return data_.begin();
+    }
+
+    inline JSONArray::iterator JSONArray::end()
+    {
+        expose_();
+        return data_.end();
+    }
+
+    inline JSONArray::const_iterator JSONArray::begin() const
+    {
+        return data_.begin();
+    }
+
+    inline JSONArray::const_iterator JSONArray::end() const
+    {
+        return data_.end();
+    }
+
+    inline size_t JSONArray::computeHash_(JSONItem::HashScope_ &scope) const
+    {
+        size_t hashVal = 0;
+        if (cachedHash_(hashVal, scope)) {
+            return hashVal;
+        }
+        auto itemsScope = (exposed_ ? JSONItem::HashScope_::GENERATION : JSONItem::HashScope_::CONTAINER);
+        hashVal = data_.size();
+        for (const auto &item : data_) {
+            hashVal ^= item.computeHash_(itemsScope) + 2654435769 + (hashVal << 6) + (hashVal >> 2);
+        }
+        // 0 is reserved by hash_.
+        hashVal = (hashVal == 0) ? 1 : hashVal;
+        memoise_(hashVal, itemsScope);
+        scope = std::max(scope, itemsScope);
+        return hashVal;
+    }
+
+    // Widens scope to how long the memoised hash holds, a hash memoised for a past generation is dropped.
+    inline bool JSONArray::cachedHash_(size_t &hashVal, JSONItem::HashScope_ &scope) const noexcept
+    {
+        hashVal = hash_.load(std::memory_order_acquire);
+        if (hashVal == 0) {
+            return false;
+        }
+        auto generation = memoGeneration_.load(std::memory_order_relaxed);
+        if (generation != 0) {
+            if (!_JSON_Hash_Generation::Current(generation)) {
+                return false;
+            }
+            scope = std::max(scope, JSONItem::HashScope_::GENERATION);
+        }
+        return true;
+    }
+
+    inline void JSONArray::memoise_(size_t hashVal, JSONItem::HashScope_ scope) const noexcept
+    {
+        if (scope == JSONItem::HashScope_::NONE) {
+            return;
+        }
+        auto generation = (scope == JSONItem::HashScope_::GENERATION) ? _JSON_Hash_Generation::Observe() : 0;
+        memoGeneration_.store(generation, std::memory_order_relaxed);
+        hash_.store(hashVal, std::memory_order_release);
+    }
+
+    inline void JSONArray::resetHash_() noexcept
+    {
+        hash_.store(0, std::memory_order_relaxed);
+        _JSON_Hash_Generation::Advance();
+    }
+
+    // A hash memoised until the array is modified now only holds for the current generation.
+    inline void JSONArray::expose_() noexcept
+    {
+        if (!exposed_) {
+            exposed_ = true;
+            if (hash_.load(std::memory_order_relaxed) != 0 && memoGeneration_.load(std::memory_order_relaxed) == 0) {
+                memoGeneration_.store(_JSON_Hash_Generation::Observe(), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline JSONObject::JSONObject() : members_(), index_(), hash_(0), memoGeneration_(0), exposed_(false) { }
+
+    inline JSONObject::JSONObject(std::string_view jsonText) : members_(), index_(), hash_(0), memoGeneration_(0), exposed_(false)
+    {
+        *this = _JSON_Parse_Utils::ParseJSONObject(jsonText, 0).resultVal;
+    }
+
+    // Memoised hashes are taken over like in JSONArray.
+    inline JSONObject::JSONObject(const JSONObject &other) : 
+        members_(other.members_), 
+        index_(other.index_), 
+        hash_(0), 
+        memoGeneration_(0), 
+        exposed_(false)
+    {
+        size_t hashVal = 0;
+        auto scope = JSONItem::HashScope_::CONTAINER;
+        if (other.cachedHash_(hashVal, scope)) {
+            memoise_(hashVal, JSONItem::HashScope_::CONTAINER);
+        }
+    }
+
+    inline JSONObject::JSONObject(JSONObject &&other) noexcept :
+        members_(std::move(other.members_)),
+        index_(std::move(other.index_)),
+        hash_(other.hash_.load(std::memory_order_relaxed)),
+        memoGeneration_(other.memoGeneration_.load(std::memory_order_relaxed)),
+        exposed_(other.exposed_)
+    {
+        other.modified_();
+    }
+
+    // The members are adopted like JSONArray(std::vector<JSONItem>&&) adopts its elements, 
+    // a key given more than once keeps its first value.
+    inline JSONObject::JSONObject(std::vector<JSONPair> &&members) : 
+        members_(std::move(members)), 
+        index_(), 
+        hash_(0), 
+        memoGeneration_(0), 
+        exposed_(false)
+    {
+        if (members_.size() > indexThreshold) {
+            buildIndex_();
+        } else {
+            for (size_t pos = 1; pos < members_.size(); pos++) {
+                for (size_t prev = 0; prev < pos; prev++) {
+                    if (members_[prev].key == members_[pos].key) {
+                        members_.erase(members_.begin() + pos);
+                        pos--;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    inline JSONObject::JSONObject(std::unordered_map<std::string, JSONItem> &&data, std::vector<std::string> &&order) :
+        members_(), 
+        index_(), 
+        hash_(0), 
+        memoGeneration_(0), 
+        exposed_(false)
+    {
+        members_.reserve(order.size());
+        for (auto &key : order) {
+            auto iter = data.find(key);
+            if (iter != data.end()) {
+                members_.push_back({JSONKey(key), std::move(iter->second)});
+                data.erase(iter);
+            }
+        }
+        if (members_.size() > indexThreshold) {
+            buildIndex_();
+        }
+    }
+
+    inline JSONObject::~JSONObject() { }
+
+    inline JSONObject &JSONObject::operator=(const JSONObject &other)
+    {
+        if (std::addressof(other) != this) {
+            modified_();
+            members_ = other.members_;
+            index_ = other.index_;
+            size_t hashVal = 0;
+            auto scope = (exposed_ ? JSONItem::HashScope_::GENERATION : JSONItem::HashScope_::CONTAINER);
+            if (other.cachedHash_(hashVal, scope)) {
+                memoise_(hashVal, scope);
+            }
+        }
+        return *this;
+    }
+
+    inline JSONObject &JSONObject::operator=(JSONObject &&other) noexcept
+    {
+        if (std::addressof(other) != this) {
+            modified_();
+            members_ = std::move(other.members_);
+            index_ = std::move(other.index_);
+            exposed_ = (exposed_ || other.exposed_);
+            size_t hashVal = 0;
+            auto scope = (exposed_ ? JSONItem::HashScope_::GENERATION : JSONItem::HashScope_::CONTAINER);
+            if (other.cachedHash_(hashVal, scope)) {
+                memoise_(hashVal, scope);
+            }
+            other.modified_();
+        }
+        return *this;
+    }
+
+    inline JSONObject &JSONObject::operator+=(const JSONObject &other)
+    {
+        modified_();
+        if (std::addressof(other) != this) {
+            for (const auto &member : other.members_) {
+                auto pos = findPos_(member.key);
+                if (pos == npos_) {
+                    members_.push_back(member);
+                    insertIndex_(members_.size() - 1);
+                } else {
+                    members_[pos].value = member.value;
+                }
+            }
+        }
+        return *this;
+    }
+
+    inline JSONObject &JSONObject::operator+=(JSONObject &&other)
+    {
+        if (std::addressof(other) != this) {
+            if (members_.empty()) {
+                *this = std::move(other);
+            } else {
+                for (auto &member : other.members_) {
+                    findOrInsert_(member.key) = std::move(member.value);
+                }
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    inline JSONObject JSONObject::operator+(const JSONObject &other) const
+    {
+        JSONObject merged(other);
+        for (const auto &member : members_) {
+            merged.findOrInsert_(member.key) = member.value;
+        }
+        return merged;
+    }
+
+    inline bool JSONObject::operator==(const JSONObject &other) const
+    {
+        if (std::addressof(other) == this) {
+            return true;
+        }
+        if (members_.size() != other.members_.size()) {
+            return false;
+        }
+        size_t hashVal = 0, otherHashVal = 0;
+        auto scope = JSONItem::HashScope_::CONTAINER;
+        if (cachedHash_(hashVal, scope) && other.cachedHash_(otherHashVal, scope) && hashVal != otherHashVal) {
+            return false;
+        }
+        for (size_t pos = 0; pos < members_.size(); pos++) {
+            if (members_[pos].key != other.members_[pos].key || members_[pos].value != other.members_[pos].value) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline bool JSONObject::operator!=(const JSONObject &other) const
+    {
+        return !(*this == other);
+    }
+
+    inline bool JSONObject::contains(const std::string &key) const
+    {
+        return (findPos_(key) != npos_);
+    }
+
+    inline bool JSONObject::contains(const JSONKey &key) const
+    {
+        return (findPos_(key) != npos_);
+    }
+
+    // Only inserting modifies the object, writes through the reference advance the hash generation.
+    inline JSONItem &JSONObject::operator[](const std::string &key)
+    {
+        expose_();
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            modified_();
+            return insert_(JSONKey(key));
+        }
+        return members_[pos].value;
+    }
+
+    inline JSONItem &JSONObject::operator[](const JSONKey &key)
+    {
+        expose_();
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            modified_();
+            return insert_(key);
+        }
+        return members_[pos].value;
+    }
+
+    inline const JSONItem &JSONObject::at(const std::string &key) const
+    {
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            throw JSONExcept("Key not found");
+        }
+        return members_[pos].value;
+    }
+
+    inline const JSONItem &JSONObject::at(const JSONKey &key) const
+    {
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            throw JSONExcept("Key not found");
+        }
+        return members_[pos].value;
+    }
+
+    inline void JSONObject::add(const std::string &key, const JSONItem &value)
+    {
+        findOrInsert_(key) = value;
+    }
+
+    inline void JSONObject::add(const std::string &key, JSONItem &&value)
+    {
+        findOrInsert_(key) = std::move(value);
+    }
+
+    inline void JSONObject::add(const JSONKey &key, const JSONItem &value)
+    {
+        findOrInsert_(key) = value;
+    }
+
+    inline void JSONObject::add(const JSONKey &key, JSONItem &&value)
+    {
+        findOrInsert_(key) = std::move(value);
+    }
+
+    // Like add(), an existing value is replaced.
+    template <typename ..._Args>
+    JSONItem &JSONObject::emplace(const std::string &key, _Args &&...args)
+    {
+        return ((*this)[key] = JSONItem(std::forward<_Args>(args)...));
+    }
+
+    template <typename ..._Args>
+    JSONItem &JSONObject::emplace(const JSONKey &key, _Args &&...args)
+    {
+        return ((*this)[key] = JSONItem(std::forward<_Args>(args)...));
+    }
+
+    // Later members shift down by one, the index is patched in place instead of rehashing every key.
+    inline void JSONObject::remove(const std::string &key)
+    {
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            throw JSONExcept("Key not found");
+        }
+        modified_();
+        eraseIndex_(pos);
+        members_.erase(members_.begin() + pos);
+    }
+
+    inline void JSONObject::remove(const JSONKey &key)
+    {
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            throw JSONExcept("Key not found");
+        }
+        modified_();
+        eraseIndex_(pos);
+        members_.erase(members_.begin() + pos);
+    }
+
+    inline void JSONObject::clear()
+    {
+        modified_();
+        members_.clear();
+        index_.clear();
+    }
+
+    inline size_t JSONObject::size() const
+    {
+        return members_.size();
+    }
+
+    // Memoised like JSONArray::hash(), keys and values are combined in member order so that equal 
+    // objects always hash equally.
+    inline size_t JSONObject::hash() const
+    {
+        auto scope = JSONItem::HashScope_::CONTAINER;
+        return computeHash_(scope);
+    }
+
+    inline bool JSONObject::empty() const
+    {
+        return members_.empty();
+    }
+
+    inline _JSON_String JSONObject::toRaw() const
+    {
+        _JSON_String raw{};
+        {
+            JSONWriter writer([&raw](const char* data, size_t size) { raw.append(data, size); });
+            writer.write(*this);
+            writer.flush();
+        }
+        return raw;
+    }
+
+    inline std::string JSONObject::toString() const
+    {
+        std::string jsonText{};
+        {
+            JSONWriter writer(jsonText);
+            writer.write(*this);
+        }
+        return jsonText;
+    }
+
+    inline std::string JSONObject::toFormatedString() const
+    {
+        std::string jsonText{};
+        {
+            JSONWriter writer(jsonText);
+            writer.writeFormated(*this);
+        }
+        return jsonText;
+    }
+
+    inline const JSONItem* JSONObject::find(std::string_view key) const
+    {
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            return nullptr;
+        }
+        return std::addressof(members_[pos].value);
+    }
+
+    inline const JSONItem* JSONObject::find(const JSONKey &key) const
+    {
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            return nullptr;
+        }
+        return std::addressof(members_[pos].value);
+    }
+
+    inline const std::vector<JSONObject::JSONPair> &JSONObject::members() const
+    {
+        return members_;
+    }
+
+    inline std::vector<JSONObject::JSONPair> JSONObject::toPairs() const
+    {
+        return members_;
+    }
+
+    inline JSONObject::const_iterator JSONObject::begin() const
+    {
+        return members_.begin();
+    }
+
+    inline JSONObject::const_iterator JSONObject::end() const
+    {
+        return members_.end();
+    }
+
+    inline std::unordered_map<std::string, JSONItem> JSONObject::data() const
+    {
+        std::unordered_map<std::string, JSONItem> data{};
+        data.reserve(members_.size());
+        for (const auto &member : members_) {
+            data.emplace(member.key.str(), member.value);
+        }
+        return data;
+    }
+
+    inline std::vector<std::string> JSONObject::order() const
+    {
+        std::vector<std::string> order{};
+        order.reserve(members_.size());
+        for (const auto &member : members_) {
+            order.emplace_back(member.key.str());
+        }
+        return order;
+    }
+
+    inline size_t JSONObject::findPos_(std::string_view key) const
+    {
+        if (index_.empty()) {
+            for (size_t pos = 0; pos < members_.size(); pos++) {
+                const auto &memberKey = members_[pos].key;
+                if (memberKey.size() == key.size() && std::memcmp(memberKey.data(), key.data(), key.size()) == 0) {
+                    return pos;
+                }
+            }
+            return npos_;
+        }
+        auto pos = index_[slot_(key, _JSON_Key_Table::Hash(key))];
+        return (pos == emptySlot_) ? npos_ : pos;
+    }
+
+    // Interned keys are equal only if they are the same entry, neither path touches the characters.
+    inline size_t JSONObject::findPos_(const JSONKey &key) const
+    {
+        if (index_.empty()) {
+            for (size_t pos = 0; pos < members_.size(); pos++) {
+                if (members_[pos].key == key) {
+                    return pos;
+                }
+            }
+            return npos_;
+        }
+        auto pos = index_[slot_(key)];
+        return (pos == emptySlot_) ? npos_ : pos;
+    }
+
+    // Slot holding key, or the empty slot where it would be inserted.
+    inline size_t JSONObject::slot_(std::string_view key, size_t hash) const
+    {
+        auto mask = index_.size() - 1;
+        auto slot = hash & mask;
+        while (index_[slot] != emptySlot_) {
+            const auto &memberKey = members_[index_[slot]].key;
+            if (memberKey.hash() == hash && memberKey == key) {
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    inline size_t JSONObject::slot_(const JSONKey &key) const
+    {
+        auto mask = index_.size() - 1;
+        auto slot = key.hash() & mask;
+        while (index_[slot] != emptySlot_ && members_[index_[slot]].key != key) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    inline size_t JSONObject::computeHash_(JSONItem::HashScope_ &scope) const
+    {
+        size_t hashVal = 0;
+        if (cachedHash_(hashVal, scope)) {
+            return hashVal;
+        }
+        auto valuesScope = (exposed_ ? JSONItem::HashScope_::GENERATION : JSONItem::HashScope_::CONTAINER);
+        hashVal = members_.size();
+        for (const auto &member : members_) {
+            hashVal ^= member.key.hash() + 2654435769 + (hashVal << 6) + (hashVal >> 2);
+            hashVal ^= member.value.computeHash_(valuesScope) + 2654435769 + (hashVal << 6) + (hashVal >> 2);
+        }
+        hashVal = (hashVal == 0) ? 1 : hashVal;
+        memoise_(hashVal, valuesScope);
+        scope = std::max(scope, valuesScope);
+        return hashVal;
+    }
+
+    inline bool JSONObject::cachedHash_(size_t &hashVal, JSONItem::HashScope_ &scope) const noexcept
+    {
+        hashVal = hash_.load(std::memory_order_acquire);
+        if (hashVal == 0) {
+            return false;
+        }
+        auto generation = memoGeneration_.load(std::memory_order_relaxed);
+        if (generation != 0) {
+            if (!_JSON_Hash_Generation::Current(generation)) {
+                return false;
+            }
+            scope = std::max(scope, JSONItem::HashScope_::GENERATION);
+        }
+        return true;
+    }
+
+    inline void JSONObject::memoise_(size_t hashVal, JSONItem::HashScope_ scope) const noexcept
+    {
+        if (scope == JSONItem::HashScope_::NONE) {
+            return;
+        }
+        auto generation = (scope == JSONItem::HashScope_::GENERATION) ? _JSON_Hash_Generation::Observe() : 0;
+        memoGeneration_.store(generation, std::memory_order_relaxed);
+        hash_.store(hashVal, std::memory_order_release);
+    }
+
+    // Unlike operator[], the reference is only used internally and does not expose the object.
+    inline JSONItem &JSONObject::findOrInsert_(const std::string &key)
+    {
+        modified_();
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            return insert_(JSONKey(key));
+        }
+        return members_[pos].value;
+    }
+
+    inline JSONItem &JSONObject::findOrInsert_(const JSONKey &key)
+    {
+        modified_();
+        auto pos = findPos_(key);
+        if (pos == npos_) {
+            return insert_(key);
+        }
+        return members_[pos].value;
+    }
+
+    inline JSONItem &JSONObject::insert_(const JSONKey &key)
+    {
+        members_.push_back({key, JSONItem()});
+        auto pos = members_.size() - 1;
+        insertIndex_(pos);
+        return members_[pos].value;
+    }
+
+    inline void JSONObject::insertIndex_(size_t pos)
+    {
+        if (index_.empty()) {
+            if (members_.size() > indexThreshold) {
+                buildIndex_();
+            }
+        } else if ((members_.size() * 2) > index_.size()) {
+            buildIndex_();
+        } else {
+            index_[slot_(members_[pos].key)] = static_cast<uint32_t>(pos);
+        }
+    }
+
+    inline void JSONObject::eraseIndex_(size_t pos)
+    {
+        if (index_.empty()) {
+            return;
+        }
+        if (members_.size() <= (indexThreshold / 2)) {
+            index_.clear();
+            return;
+        }
+        // Backward shift deletion keeps every probe chain intact without tombstones.
+        auto mask = index_.size() - 1;
+        auto hole = slot_(members_[pos].key);
+        auto next = (hole + 1) & mask;
+        while (index_[next] != emptySlot_) {
+            auto home = members_[index_[next]].key.hash() & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                index_[hole] = index_[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        index_[hole] = emptySlot_;
+        for (auto &slot : index_) {
+            if (slot != emptySlot_ && slot > pos) {
+                slot--;
+            }
+        }
+    }
+
+    // Also drops repeated keys, keeping the first.
+    inline void JSONObject::buildIndex_()
+    {
+        size_t capacity = 32;
+        while (capacity < (members_.size() * 2)) {
+            capacity *= 2;
+        }
+        index_.assign(capacity, emptySlot_);
+        size_t count = 0;
+        for (size_t pos = 0; pos < members_.size(); pos++) {
+            auto slot = slot_(members_[pos].key);
+            if (index_[slot] != emptySlot_) {
+                continue;
+            }
+            if (count != pos) {
+                members_[count] = std::move(members_[pos]);
+            }
+            index_[slot] = static_cast<uint32_t>(count++);
+        }
+        members_.resize(count);
+    }
+
+    inline void JSONObject::modified_() noexcept
+    {
+        hash_.store(0, std::memory_order_relaxed);
+        _JSON_Hash_Generation::Advance();
+    }
+
+    inline void JSONObject::expose_() noexcept
+    {
+        if (!exposed_) {
+            exposed_ = true;
+            if (hash_.load(std::memory_order_relaxed) != 0 && memoGeneration_.load(std::memory_order_relaxed) == 0) {
+                memoGeneration_.store(_JSON_Hash_Generation::Observe(), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    class _JSON_Arena
+    {
+        public:
+            _JSON_Arena() noexcept : head_(nullptr), cursor_(nullptr), end_(nullptr), nextSize_(minBlockSize_) { }
+
+            _JSON_Arena(const _JSON_Arena &other) = delete;
+
+            _JSON_Arena(_JSON_Arena &&other) noexcept :
+                head_(other.head_),
+                cursor_(other.cursor_),
+                end_(other.end_),
+                nextSize_(other.nextSize_)
+            {
+                other.head_ = nullptr;
+                other.cursor_ = nullptr;
+                other.end_ = nullptr;
+                other.nextSize_ = minBlockSize_;
+            }
+
+            ~_JSON_Arena() noexcept
+            {
+                release();
+            }
+
+            _JSON_Arena &operator=(const _JSON_Arena &other) = delete;
+
+            _JSON_Arena &operator=(_JSON_Arena &&other) noexcept
+            {
+                if (std::addressof(other) != this) {
+                    release();
+                    head_ = other.head_;
+                    cursor_ = other.cursor_;
+                    end_ = other.end_;
+                    nextSize_ = other.nextSize_;
+                    other.head_ = nullptr;
+                    other.cursor_ = nullptr;
+                    other.end_ = nullptr;
+                    other.nextSize_ = minBlockSize_;
+                }
+                return *this;
+            }
+
+            void* allocate(size_t size, size_t align)
+            {
+                auto ptr = alignPtr_(cursor_, align);
+                if (cursor_ == nullptr || ptr > end_ || static_cast<size_t>(end_ - ptr) < size) {
+                    addBlock_(size + align);
+                    ptr = alignPtr_(cursor_, align);
+                }
+                cursor_ = ptr + size;
+                return ptr;
+            }
+
+            template <typename _Ty>
+            _Ty* allocate(size_t count)
+            {
+                return reinterpret_cast<_Ty*>(allocate((sizeof(_Ty) * count), alignof(_Ty)));
+            }
+
+            const char* duplicate(std::string_view str)
+            {
+                auto dst = reinterpret_cast<char*>(allocate((str.size() + 1), 1));
+                std::memcpy(dst, str.data(), str.size());
+                dst[str.size()] = '\0';
+                return dst;
+            }
+
+            // Keeps a single block as large as everything allocated so far, so that refilling 
+            // the arena with a similar amount of data does not touch the heap again.
+            void reset()
+            {
+                if (head_ == nullptr) {
+                    return;
+                }
+                if (head_->next != nullptr) {
+                    auto total = capacity();
+                    release();
+                    nextSize_ = std::max(total, minBlockSize_);
+                    addBlock_(0);
+                    return;
+                }
+                cursor_ = reinterpret_cast<char*>(head_ + 1);
+                end_ = reinterpret_cast<char*>(head_) + head_->size;
+            }
+
+            void release() noexcept
+            {
+                auto block = head_;
+                while (block != nullptr) {
+                    auto next = block->next;
+                    std::free(block);
+                    block = next;
+                }
+                head_ = nullptr;
+                cursor_ = nullptr;
+                end_ = nullptr;
+                nextSize_ = minBlockSize_;
+            }
+
+            size_t capacity() const noexcept
+            {
+                size_t total = 0;
+                for (auto block = head_; block != nullptr; block = block->next) {
+                    total += block->size;
+                }
+                return total;
+            }
+
+        private:
+            struct Block
+            {
+                Block* next;
+                size_t size;
+            };
+
+            static constexpr size_t minBlockSize_ = 4096;
+            static constexpr size_t maxBlockSize_ = 64 * 1024 * 1024;
+
+            Block* head_;
+            char* cursor_;
+            char* end_;
+            size_t nextSize_;
+
+            static char* alignPtr_(char* ptr, size_t align) noexcept
+            {
+                auto addr = reinterpret_cast<uintptr_t>(ptr);
+                return reinterpret_cast<char*>((addr + align - 1) & ~static_cast<uintptr_t>(align - 1));
+            }
+
+            void addBlock_(size_t req_size)
+            {
+                auto size = std::max(nextSize_, (req_size + sizeof(Block)));
+                auto block = reinterpret_cast<Block*>(std::malloc(size));
+                if (block == nullptr) {
+                    throw std::bad_alloc();
+                }
+                block->next = head_;
+                block->size = size;
+                head_ = block;
+                cursor_ = reinterpret_cast<char*>(block + 1);
+                end_ = reinterpret_cast<char*>(block) + size;
+                nextSize_ = std::min((size * 2), std::max(maxBlockSize_, size));
+            }
+    };
+
+    struct _JSON_Member;
+
+    struct _JSON_Node
+    {
+        JSONItem::ItemType type;
+        uint8_t flags;
+        uint32_t size;
+        union
+        {
+            bool boolean;
+            int integer;
+            int64_t longInt;
+            double number;
+            const char* string;
+            _JSON_Node* elements;
+            _JSON_Member* members;
+        };
+    };
+
+    struct _JSON_Member
+    {
+        std::string_view key;
+        _JSON_Node value;
+    };
+
+    namespace _JSON_Document_Utils
+    {
+        // Objects larger than this get an open-addressing table of member indexes 
+        // stored right behind the members: [mask][slot]...[slot].
+        constexpr size_t objectIndexMinSize = 16;
+
+        // The string payload / member key points into the caller's JSON text instead of the arena.
+        constexpr uint8_t borrowedString = 0x01;
+        constexpr uint8_t borrowedKey = 0x02;
+
+        inline size_t HashKey(std::string_view key) noexcept
+        {
+            return std::hash<std::string_view>()(key);
+        }
+
+        inline _JSON_Node MakeArrayNode(_JSON_Arena &arena, const _JSON_Node* elements, size_t size)
+        {
+            _JSON_Node node{};
+            node.type = JSONItem::ItemType::ARRAY;
+            node.size = static_cast<uint32_t>(size);
+            node.elements = nullptr;
+            if (size > 0) {
+                node.elements = arena.allocate<_JSON_Node>(size);
+                std::memcpy(node.elements, elements, (sizeof(_JSON_Node) * size));
+            }
+            return node;
+        }
+
+        inline _JSON_Node MakeObjectNode(_JSON_Arena &arena, const _JSON_Member* members, size_t size)
+        {
+            _JSON_Node node{};
+            node.type = JSONItem::ItemType::OBJECT;
+            node.size = static_cast<uint32_t>(size);
+            node.members = nullptr;
+            if (size == 0) {
+                return node;
+            }
+            if (size <= objectIndexMinSize) {
+                node.members = arena.allocate<_JSON_Member>(size);
+                std::memcpy(node.members, members, (sizeof(_JSON_Member) * size));
+                return node;
+            }
+
+            size_t tableSize = 1;
+            while (tableSize < (size * 2)) {
+                tableSize <<= 1;
+            }
+            auto block = arena.allocate((sizeof(_JSON_Member) * size + sizeof(uint32_t) * (tableSize + 1)), 
+                alignof(_JSON_Member));
+            node.members = reinterpret_cast<_JSON_Member*>(block);
+            std::memcpy(node.members, members, (sizeof(_JSON_Member) * size));
+            auto table = reinterpret_cast<uint32_t*>(node.members + size);
+            table[0] = static_cast<uint32_t>(tableSize - 1);
+            auto slots = table + 1;
+            std::memset(slots, 0, (sizeof(uint32_t) * tableSize));
+            for (size_t idx = 0; idx < size; idx++) {
+                const auto &key = members[idx].key;
+                auto slot = HashKey(key) & table[0];
+                while (slots[slot] != 0 && node.members[slots[slot] - 1].key != key) {
+                    slot = (slot + 1) & table[0];
+                }
+                if (slots[slot] == 0) {
+                    slots[slot] = static_cast<uint32_t>(idx + 1);
+                }
+            }
+            return node;
+        }
+
+        inline const _JSON_Member* FindMember(const _JSON_Node &object, std::string_view key) noexcept
+        {
+            if (object.size <= objectIndexMinSize) {
+                for (auto member = object.members; member < (object.members + object.size); ++member) {
+                    if (member->key == key) {
+                        return member;
+                    }
+                }
+                return nullptr;
+            }
+
+            auto table = reinterpret_cast<const uint32_t*>(object.members + object.size);
+            auto slots = table + 1;
+            auto slot = HashKey(key) & table[0];
+            while (slots[slot] != 0) {
+                auto member = object.members + (slots[slot] - 1);
+                if (member->key == key) {
+                    return member;
+                }
+                slot = (slot + 1) & table[0];
+            }
+            return nullptr;
+        }
+
+        inline _JSON_Node ItemToNode(const JSONItem &item, _JSON_Arena &arena)
+        {
+            _JSON_Node node{};
+            node.type = item.type();
+            switch (item.type()) {
+                case JSONItem::ItemType::BOOLEAN:
+                    node.boolean = item.toBoolean();
+                    break;
+                case JSONItem::ItemType::INTEGER:
+                    node.integer = item.toInt();
+                    break;
+                case JSONItem::ItemType::LONG:
+                    node.longInt = item.toLong();
+                    break;
+                case JSONItem::ItemType::DOUBLE:
+                    node.number = item.toDouble();
+                    break;
+                case JSONItem::ItemType::STRING:
+                    {
+                        const auto &str = item.asString();
+                        node.size = static_cast<uint32_t>(str.size());
+                        node.string = arena.duplicate(str);
+                    }
+                    break;
+                case JSONItem::ItemType::ARRAY:
+                    {
+                        const auto &array = item.asArray();
+                        std::vector<_JSON_Node> elements{};
+                        elements.reserve(array.size());
+                        for (const auto &element : array) {
+                            elements.emplace_back(ItemToNode(element, arena));
+                        }
+                        node = MakeArrayNode(arena, elements.data(), elements.size());
+                    }
+                    break;
+                case JSONItem::ItemType::OBJECT:
+                    {
+                        const auto &object = item.asObject();
+                        std::vector<_JSON_Member> members{};
+                        members.reserve(object.size());
+                        for (const auto &[key, value] : object) {
+                            _JSON_Member member{};
+                            member.key = std::string_view(arena.duplicate(key), key.size());
+                            member.value = ItemToNode(value, arena);
+                            members.emplace_back(member);
+                        }
+                        node = MakeObjectNode(arena, members.data(), members.size());
+                    }
+                    break;
+                default:
+                    break;
+            }
+            return node;
+        }
+
+        inline JSONItem NodeToItem(const _JSON_Node &node)
+        {
+            switch (node.type) {
+                case JSONItem::ItemType::BOOLEAN:
+                    return node.boolean;
+                case JSONItem::ItemType::INTEGER:
+                    return node.integer;
+                case JSONItem::ItemType::LONG:
+                    return node.longInt;
+                case JSONItem::ItemType::DOUBLE:
+                    return node.number;
+                case JSONItem::ItemType::STRING:
+                    return std::string(node.string, node.size);
+                case JSONItem::ItemType::ARRAY:
+                    {
+                        std::vector<JSONItem> array{};
+                        array.reserve(node.size);
+                        for (auto element = node.elements; element < (node.elements + node.size); ++element) {
+                            array.emplace_back(NodeToItem(*element));
+                        }
+                        return JSONArray(std::move(array));
+                    }
+                case JSONItem::ItemType::OBJECT:
+                    {
+                        std::vector<JSONObject::JSONPair> members{};
+                        members.reserve(node.size);
+                        for (auto member = node.members; member < (node.members + node.size); ++member) {
+                            members.push_back({JSONKey(member->key), NodeToItem(member->value)});
+                        }
+                        return JSONObject(std::move(members));
+                    }
+                default:
+                    break;
+            }
+            return {};
+        }
+
+        // Open containers are kept on an explicit stack of (node, next child) frames, deep documents 
+        // are written without recursing.
+        inline void WriteNode(const _JSON_Node &root, JSONWriter &writer)
+        {
+            static const auto writeNode = [](const _JSON_Node &node, JSONWriter &writer) -> bool {
+                switch (node.type) {
+                    case JSONItem::ItemType::ITEM_NULL:
+                        writer.writeNull();
+                        break;
+                    case JSONItem::ItemType::BOOLEAN:
+                        writer.writeBoolean(node.boolean);
+                        break;
+                    case JSONItem::ItemType::INTEGER:
+                        writer.writeInt(node.integer);
+                        break;
+                    case JSONItem::ItemType::LONG:
+                        writer.writeLong(node.longInt);
+                        break;
+                    case JSONItem::ItemType::DOUBLE:
+                        writer.writeDouble(node.number);
+                        break;
+                    case JSONItem::ItemType::STRING:
+                        writer.writeString(std::string_view(node.string, node.size));
+                        break;
+                    case JSONItem::ItemType::ARRAY:
+                        writer.writeRaw("[");
+                        return true;
+                    case JSONItem::ItemType::OBJECT:
+                        writer.writeRaw("{");
+                        return true;
+                    default:
+                        break;
+                }
+                return false;
+            };
+
+            struct Frame
+            {
+                const _JSON_Node* node;
+                uint32_t pos;
+            };
+
+            static constexpr size_t inlineDepth = 32;
+
+            if (!writeNode(root, writer)) {
+                return;
+            }
+            Frame inlineFrames[inlineDepth];
+            std::vector<Frame> heapFrames{};
+            auto frames = inlineFrames;
+            auto capacity = inlineDepth;
+            size_t depth = 0;
+            auto node = std::addressof(root);
+            for (;;) {
+                if (depth == capacity) {
+                    std::vector<Frame> grown(capacity * 2);
+                    std::copy(frames, (frames + depth), grown.begin());
+                    heapFrames.swap(grown);
+                    frames = heapFrames.data();
+                    capacity = heapFrames.size();
+                }
+                frames[depth++] = {node, 0};
+
+                const _JSON_Node* child = nullptr;
+                while (child == nullptr && depth > 0) {
+                    auto frame = frames + (depth - 1);
+                    auto parent = frame->node;
+                    auto pos = frame->pos;
+                    auto size = parent->size;
+                    if (parent->type == JSONItem::ItemType::ARRAY) {
+                        for (; child == nullptr && pos < size; pos++) {
+                            if (pos > 0) {
+                                writer.writeRaw(",");
+                            }
+                            if (writeNode(parent->elements[pos], writer)) {
+                                child = parent->elements + pos;
+                            }
+                        }
+                    } else {
+                        for (; child == nullptr && pos < size; pos++) {
+                            if (pos > 0) {
+                                writer.writeRaw(",");
+                            }
+                            writer.writeString(parent->members[pos].key);
+                            writer.writeRaw(":");
+                            if (writeNode(parent->members[pos].value, writer)) {
+                                child = std::addressof(parent->members[pos].value);
+                            }
+                        }
+                    }
+                    frame->pos = pos;
+                    if (child == nullptr) {
+                        writer.writeRaw((parent->type == JSONItem::ItemType::OBJECT) ? "}" : "]");
+                        depth--;
+                    }
+                }
+                if (child == nullptr) {
+                    return;
+                }
+                node = child;
+            }
+        }
+
+        inline void DetachNode(_JSON_Node &node, _JSON_Arena &arena)
+        {
+            if ((node.flags & borrowedString) != 0) {
+                node.string = arena.duplicate(std::string_view(node.string, node.size));
+            }
+            node.flags &= ~borrowedString;
+            if (node.type == JSONItem::ItemType::ARRAY) {
+                for (auto element = node.elements; element < (node.elements + node.size); ++element) {
+                    DetachNode(*element, arena);
+                }
+            } else if (node.type == JSONItem::ItemType::OBJECT) {
+                for (auto member = node.members; member < (node.members + node.size); ++member) {
+                    if ((member->value.flags & borrowedKey) != 0) {
+                        member->key = std::string_view(arena.duplicate(member->key), member->key.size());
+                    }
+                    DetachNode(member->value, arena);
+                    member->value.flags &= ~borrowedKey;
+                }
+            }
+        }
+
+        class DocumentParser
+        {
+            public:
+                DocumentParser() : 
+                    index_(), frames_(), elements_(), members_(), buffer_(), jsonText_(), borrow_(false), maxDepth_(0) 
+                { }
+
+                _JSON_Node parse(std::string_view jsonText, _JSON_Arena &arena, bool borrow = false, 
+                    size_t maxDepth = _JSON_Parse_Utils::defaultMaxDepth)
+                {
+                    jsonText_ = jsonText;
+                    borrow_ = borrow;
+                    maxDepth_ = maxDepth;
+                    auto beginPos = _JSON_Parse_Utils::IgnoreBlank(jsonText, 0);
+                    if (beginPos == std::string_view::npos) {
+                        _JSON_Parse_Utils::ThrowSyntaxExcept("JSON text is empty");
+                    }
+
+                    index_.build(jsonText);
+                    if (index_.usable(jsonText)) {
+                        _JSON_Parse_Utils::IndexedCursor cursor(jsonText, index_);
+                        auto ch = cursor.peekChar();
+                        if (ch != '{' && ch != '[') {
+                            _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Object must begin with \'{\'", jsonText, beginPos);
+                        }
+                        return parseItem_(cursor, arena, beginPos);
+                    }
+
+                    if (jsonText[beginPos] == '[') {
+                        return ItemToNode(_JSON_Parse_Utils::ParseJSONArray(jsonText, beginPos, maxDepth).resultVal, arena);
+                    }
+                    return ItemToNode(_JSON_Parse_Utils::ParseJSONObject(jsonText, beginPos, maxDepth).resultVal, arena);
+                }
+
+            private:
+                // An open container, its children sit on elements_ / members_ from mark on.
+                struct Frame_
+                {
+                    size_t beginPos;
+                    bool isObject;
+                    bool borrowKey;
+                    size_t mark;
+                    _JSON_Member member;
+                };
+
+                _JSON_Parse_Utils::StructuralIndex index_;
+                std::vector<Frame_> frames_;
+                std::vector<_JSON_Node> elements_;
+                std::vector<_JSON_Member> members_;
+                std::string buffer_;
+                std::string_view jsonText_;
+                bool borrow_;
+                size_t maxDepth_;
+
+                bool borrowable_(std::string_view str) const noexcept
+                {
+                    return (borrow_ && str.data() >= jsonText_.data() && str.data() < (jsonText_.data() + jsonText_.size()));
+                }
+
+                void parseKey_(_JSON_Parse_Utils::IndexedCursor &cursor, _JSON_Arena &arena, Frame_ &frame)
+                {
+                    auto key = cursor.parseKey(buffer_);
+                    frame.borrowKey = borrowable_(key);
+                    if (frame.borrowKey) {
+                        frame.member.key = key;
+                    } else {
+                        frame.member.key = std::string_view(arena.duplicate(key), key.size());
+                    }
+                    cursor.parseColon();
+                }
+
+                void throwUnclosed_(const Frame_ &frame) const
+                {
+                    if (frame.isObject) {
+                        _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Object must end with \'}\'", jsonText_, frame.beginPos);
+                    }
+                    _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Array must end with \']\'", jsonText_, frame.beginPos);
+                }
+
+                // Iterative like IndexedParser, with the same errors as the reference parser.
+                _JSON_Node parseItem_(_JSON_Parse_Utils::IndexedCursor &cursor, _JSON_Arena &arena, size_t rootPos)
+                {
+                    // A parse that threw leaves its frames behind.
+                    frames_.clear();
+                    elements_.clear();
+                    members_.clear();
+                    for (;;) {
+                        _JSON_Node node{};
+                        auto valuePos = cursor.peekPos();
+                        auto ch = cursor.peekChar();
+                        if (ch == '{' || ch == '[') {
+                            if (frames_.size() >= maxDepth_) {
+                                _JSON_Parse_Utils::ThrowSyntaxExcept("JSON nesting exceeds the maximum depth", jsonText_, valuePos);
+                            }
+                            auto isObject = (ch == '{');
+                            cursor.skipToken();
+                            auto pos = cursor.peekPos();
+                            if (_JSON_Parse_Utils::CharAt(jsonText_, pos) != (isObject ? '}' : ']')) {
+                                frames_.push_back({(frames_.empty() ? rootPos : valuePos), isObject, false, 
+                                    (isObject ? members_.size() : elements_.size()), {}});
+                                if (pos == std::string_view::npos) {
+                                    throwUnclosed_(frames_.back());
+                                }
+                                if (isObject) {
+                                    parseKey_(cursor, arena, frames_.back());
+                                }
+                                continue;
+                            }
+                            cursor.skipToken();
+                            if (isObject) {
+                                node = MakeObjectNode(arena, (members_.data() + members_.size()), 0);
+                            } else {
+                                node = MakeArrayNode(arena, (elements_.data() + elements_.size()), 0);
+                            }
+                        } else if (ch == '\"') {
+                            auto str = cursor.parseString(buffer_);
+                            node.type = JSONItem::ItemType::STRING;
+                            node.size = static_cast<uint32_t>(str.size());
+                            if (borrowable_(str)) {
+                                node.flags |= borrowedString;
+                                node.string = str.data();
+                            } else {
+                                node.string = arena.duplicate(str);
+                            }
+                        } else {
+                            node = ItemToNode(cursor.parseScalar(), arena);
+                        }
+
+                        for (;;) {
+                            if (frames_.empty()) {
+                                return node;
+                            }
+                            auto &frame = frames_.back();
+                            if (frame.isObject) {
+                                frame.member.value = node;
+                                if (frame.borrowKey) {
+                                    frame.member.value.flags |= borrowedKey;
+                                }
+                                members_.emplace_back(frame.member);
+                            } else {
+                                elements_.emplace_back(node);
+                            }
+
+                            auto pos = cursor.peekPos();
+                            auto next = cursor.peekChar();
+                            if (next == ',') {
+                                cursor.skipToken();
+                                if ((pos + 1) >= jsonText_.size()) {
+                                    throwUnclosed_(frame);
+                                }
+                                if (frame.isObject) {
+                                    parseKey_(cursor, arena, frame);
+                                }
+                                break;
+                            }
+                            if (next != (frame.isObject ? '}' : ']')) {
+                                if (frame.isObject) {
+                                    _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Object elements must be separated by \',\'", jsonText_, pos);
+                                }
+                                _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Array elements must be separated by \',\'", jsonText_, pos);
+                            }
+                            cursor.skipToken();
+                            if (frame.isObject) {
+                                node = MakeObjectNode(arena, (members_.data() + frame.mark), (members_.size() - frame.mark));
+                                members_.resize(frame.mark);
+                            } else {
+                                node = MakeArrayNode(arena, (elements_.data() + frame.mark), (elements_.size() - frame.mark));
+                                elements_.resize(frame.mark);
+                            }
+                            frames_.pop_back();
+                        }
+                    }
+                }
+        };
+    }
+
+    class JSONParser;
+
+    class JSONDocument
+    {
+        public:
+            class Array;
+            class Object;
+
+            class Item
+            {
+                public:
+                    inline Item() noexcept;
+                    inline Item(const _JSON_Node* node) noexcept;
+
+                    inline bool isNull() const;
+                    inline bool isBoolean() const;
+                    inline bool isInt() const;
+                    inline bool isLong() const;
+                    inline bool isDouble() const;
+                    inline bool isString() const;
+                    inline bool isArray() const;
+                    inline bool isObject() const;
+
+                    inline bool toBoolean() const;
+                    inline int toInt() const;
+                    inline int64_t toLong() const;
+                    inline double toDouble() const;
+                    inline std::string toString() const;
+                    inline std::string_view toStringView() const;
+                    inline Array toArray() const;
+                    inline Object toObject() const;
+                    inline JSONItem toJSONItem() const;
+                    inline _JSON_String toRaw() const;
+
+                    inline size_t size() const;
+                    inline JSONItem::ItemType type() const;
+
+                private:
+                    friend class JSONDocument;
+
+                    const _JSON_Node* node_;
+            };
+
+            class Array
+            {
+                public:
+                    class const_iterator
+                    {
+                        public:
+                            typedef std::random_access_iterator_tag iterator_category;
+                            typedef Item value_type;
+                            typedef ptrdiff_t difference_type;
+                            typedef const Item* pointer;
+                            typedef Item reference;
+
+                            const_iterator(const _JSON_Node* node) noexcept : node_(node) { }
+
+                            Item operator*() const noexcept
+                            {
+                                return Item(node_);
+                            }
+
+                            const_iterator &operator++() noexcept
+                            {
+                                ++node_;
+                                return *this;
+                            }
+
+                            const_iterator operator++(int) noexcept
+                            {
+                                auto iter = *this;
+                                ++node_;
+                                return iter;
+                            }
+
+                            bool operator==(const const_iterator &other) const noexcept
+                            {
+                                return (node_ == other.node_);
+                            }
+
+                            bool operator!=(const const_iterator &other) const noexcept
+                            {
+                                return (node_ != other.node_);
+                            }
+
+                        private:
+                            const _JSON_Node* node_;
+                    };
+
+                    inline Array(const _JSON_Node* node) noexcept;
+
+                    inline Item operator[](size_t pos) const;
+
+                    inline Item at(size_t pos) const;
+                    inline size_t size() const;
+                    inline bool empty() const;
+                    inline JSONArray toJSONArray() const;
+                    inline _JSON_String toRaw() const;
+                    inline std::string toString() const;
+
+                    inline Item front() const;
+                    inline Item back() const;
+                    inline const_iterator begin() const;
+                    inline const_iterator end() const;
+
+                private:
+                    const _JSON_Node* node_;
+            };
+
+            class Object
+            {
+                public:
+                    struct JSONPair
+                    {
+                        std::string_view key;
+                        Item value;
+                    };
+
+                    class const_iterator
+                    {
+                        public:
+                            typedef std::random_access_iterator_tag iterator_category;
+                            typedef JSONPair value_type;
+                            typedef ptrdiff_t difference_type;
+                            typedef const JSONPair* pointer;
+                            typedef JSONPair reference;
+
+                            const_iterator(const _JSON_Member* member) noexcept : member_(member) { }
+
+                            JSONPair operator*() const noexcept
+                            {
+                                return {member_->key, Item(std::addressof(member_->value))};
+                            }
+
+                            const_iterator &operator++() noexcept
+                            {
+                                ++member_;
+                                return *this;
+                            }
+
+                            const_iterator operator++(int) noexcept
+                            {
+                                auto iter = *this;
+                                ++member_;
+                                return iter;
+                            }
+
+                            bool operator==(const const_iterator &other) const noexcept
+                            {
+                                return (member_ == other.member_);
+                            }
+
+                            bool operator!=(const const_iterator &other) const noexcept
+                            {
+                                return (member_ != other.member_);
+                            }
+
+                        private:
+                            const _JSON_Member* member_;
+                    };
+
+                    inline Object(const _JSON_Node* node) noexcept;
+
+                    inline Item operator[](std::string_view key) const;
+
+                    inline Item at(std::string_view key) const;
+                    inline bool contains(std::string_view key) const;
+                    inline size_t size() const;
+                    inline bool empty() const;
+                    inline JSONObject toJSONObject() const;
+                    inline _JSON_String toRaw() const;
+                    inline std::string toString() const;
+
+                    inline const_iterator begin() const;
+                    inline const_iterator end() const;
+
+                private:
+                    const _JSON_Node* node_;
+            };
+
+            // BORROW keeps unescaped strings and keys as views into the parsed text, 
+            // the text must then outlive the document or until detach() is called.
+            enum class ParseMode : uint8_t {COPY, BORROW};
+
+            inline JSONDocument();
+            inline JSONDocument(std::string_view jsonText, ParseMode mode = ParseMode::COPY);
+            inline JSONDocument(const JSONObject &object);
+            inline JSONDocument(const JSONArray &array);
+            inline JSONDocument(JSONDocument &&other) noexcept;
+            inline ~JSONDocument();
+
+            JSONDocument(const JSONDocument &other) = delete;
+            JSONDocument &operator=(const JSONDocument &other) = delete;
+            inline JSONDocument &operator=(JSONDocument &&other) noexcept;
+
+            inline void parse(std::string_view jsonText, ParseMode mode = ParseMode::COPY);
+            inline void assign(Item item, const JSONItem &value);
+            inline void detach();
+            inline void clear();
+            inline size_t capacity() const;
+            inline std::string toString() const;
+
+            inline Item root() const;
+            inline Object object() const;
+            inline Array array() const;
+
+        private:
+            friend class JSONParser;
+
+            _JSON_Arena arena_;
+            _JSON_Node root_;
+    };
+
+    inline JSONDocument::Item::Item() noexcept : node_(nullptr) { }
+
+    inline JSONDocument::Item::Item(const _JSON_Node* node) noexcept : node_(node) { }
+
+    inline bool JSONDocument::Item::isNull() const
+    {
+        return (type() == JSONItem::ItemType::ITEM_NULL);
+    }
+
+    inline bool JSONDocument::Item::isBoolean() const
+    {
+        return (type() == JSONItem::ItemType::BOOLEAN);
+    }
+
+    inline bool JSONDocument::Item::isInt() const
+    {
+        return (type() == JSONItem::ItemType::INTEGER);
+    }
+
+    inline bool JSONDocument::Item::isLong() const
+    {
+        return (type() == JSONItem::ItemType::LONG);
+    }
+
+    inline bool JSONDocument::Item::isDouble() const
+    {
+        return (type() == JSONItem::ItemType::DOUBLE);
+    }
+
+    inline bool JSONDocument::Item::isString() const
+    {
+        return (type() == JSONItem::ItemType::STRING);
+    }
+
+    inline bool JSONDocument::Item::isArray() const
+    {
+        return (type() == JSONItem::ItemType::ARRAY);
+    }
+
+    inline bool JSONDocument::Item::isObject() const
+    {
+        return (type() == JSONItem::ItemType::OBJECT);
+    }
+
+    inline bool JSONDocument::Item::toBoolean() const
+    {
+        if (type() != JSONItem::ItemType::BOOLEAN) {
+            throw JSONExcept("Item is not of boolean type");
+        }
+        return node_->boolean;
+    }
+
+    inline int JSONDocument::Item::toInt() const
+    {
+        if (type() != JSONItem::ItemType::INTEGER) {
+            throw JSONExcept("Item is not of int type");
+        }
+        return node_->integer;
+    }
+
+    inline int64_t JSONDocument::Item::toLong() const
+    {
+        if (type() != JSONItem::ItemType::LONG) {
+            throw JSONExcept("Item is not of long type");
+        }
+        return node_->longInt;
+    }
+
+    inline double JSONDocument::Item::toDouble() const
+    {
+        if (type() != JSONItem::ItemType::DOUBLE) {
+            throw JSONExcept("Item is not of double type");
+        }
+        return node_->number;
+    }
+
+    inline std::string JSONDocument::Item::toString() const
+    {
+        return std::string(toStringView());
+    }
+
+    inline std::string_view JSONDocument::Item::toStringView() const
+    {
+        if (type() != JSONItem::ItemType::STRING) {
+            throw JSONExcept("Item is not of string type");
+        }
+        return std::string_view(node_->string, node_->size);
+    }
+
+    inline JSONDocument::Array JSONDocument::Item::toArray() const
+    {
+        if (type() != JSONItem::ItemType::ARRAY) {
+            throw JSONExcept("Item is not of array type");
+        }
+        return Array(node_);
+    }
+
+    inline JSONDocument::Object JSONDocument::Item::toObject() const
+    {
+        if (type() != JSONItem::ItemType::OBJECT) {
+            throw JSONExcept("Item is not of object type");
+        }
+        return Object(node_);
+    }
+
+    inline JSONItem JSONDocument::Item::toJSONItem() const
+    {
+        if (node_ == nullptr) {
+            return {};
+        }
+        return _JSON_Document_Utils::NodeToItem(*node_);
+    }
+
+    inline _JSON_String JSONDocument::Item::toRaw() const
+    {
+        if (node_ == nullptr) {
+            return "null";
+        }
+        _JSON_String raw{};
+        {
+            JSONWriter writer([&raw](const char* data, size_t size) { raw.append(data, size); });
+            _JSON_Document_Utils::WriteNode(*node_, writer);
+            writer.flush();
+        }
+        return raw;
+    }
+
+    inline size_t JSONDocument::Item::size() const
+    {
+        switch (type()) {
+            case JSONItem::ItemType::STRING:
+            case JSONItem::ItemType::ARRAY:
+            case JSONItem::ItemType::OBJECT:
+                return node_->size;
+            default:
+                break;
+        }
+        return 1;
+    }
+
+    inline JSONItem::ItemType JSONDocument::Item::type() const
+    {
+        if (node_ == nullptr) {
+            return JSONItem::ItemType::ITEM_NULL;
+        }
+        return node_->type;
+    }
+
+    inline JSONDocument::Array::Array(const _JSON_Node* node) noexcept : node_(node) { }
+
+    inline JSONDocument::Item JSONDocument::Array::operator[](size_t pos) const
+    {
+        return at(pos);
+    }
+
+    inline JSONDocument::Item JSONDocument::Array::at(size_t pos) const
+    {
+        if (pos >= node_->size) {
+            throw JSONExcept("Position out of bounds");
+        }
+        return Item(node_->elements + pos);
+    }
+
+    inline size_t JSONDocument::Array::size() const
+    {
+        return node_->size;
+    }
+
+    inline bool JSONDocument::Array::empty() const
+    {
+        return (node_->size == 0);
+    }
+
+    inline JSONArray JSONDocument::Array::toJSONArray() const
+    {
+        return _JSON_Document_Utils::NodeToItem(*node_).takeArray();
+    }
+
+    inline _JSON_String JSONDocument::Array::toRaw() const
+    {
+        _JSON_String raw{};
+        {
+            JSONWriter writer([&raw](const char* data, size_t size) { raw.append(data, size); });
+            _JSON_Document_Utils::WriteNode(*node_, writer);
+            writer.flush();
+        }
+        return raw;
+    }
+
+    inline std::string JSONDocument::Array::toString() const
+    {
+        std::string jsonText{};
+        {
+            JSONWriter writer(jsonText);
+            _JSON_Document_Utils::WriteNode(*node_, writer);
+        }
+        return jsonText;
+    }
+
+    inline JSONDocument::Item JSONDocument::Array::front() const
+    {
+        return at(0);
+    }
+
+    inline JSONDocument::Item JSONDocument::Array::back() const
+    {
+        return at(node_->size - 1);
+    }
+
+    inline JSONDocument::Array::const_iterator JSONDocument::Array::begin() const
+    {
+        return const_iterator(node_->elements);
+    }
+
+    inline JSONDocument::Array::const_iterator JSONDocument::Array::end() const
+    {
+        return const_iterator(node_->elements + node_->size);
+    }
+
+    inline JSONDocument::Object::Object(const _JSON_Node* node) noexcept : node_(node) { }
+
+    inline JSONDocument::Item JSONDocument::Object::operator[](std::string_view key) const
+    {
+        return at(key);
+    }
+
+    inline JSONDocument::Item JSONDocument::Object::at(std::string_view key) const
+    {
+        auto member = _JSON_Document_Utils::FindMember(*node_, key);
+        if (member == nullptr) {
+            throw JSONExcept("Key not found");
+        }
+        return Item(std::addressof(member->value));
+    }
+
+    inline bool JSONDocument::Object::contains(std::string_view key) const
+    {
+        return (_JSON_Document_Utils::FindMember(*node_, key) != nullptr);
+    }
+
+    inline size_t JSONDocument::Object::size() const
+    {
+        return node_->size;
+    }
+
+    inline bool JSONDocument::Object::empty() const
+    {
+        return (node_->size == 0);
+    }
+
+    inline JSONObject JSONDocument::Object::toJSONObject() const
+    {
+        return _JSON_Document_Utils::NodeToItem(*node_).takeObject();
+    }
+
+    inline _JSON_String JSONDocument::Object::toRaw() const
+    {
+        _JSON_String raw{};
+        {
+            JSONWriter writer([&raw](const char* data, size_t size) { raw.append(data, size); });
+            _JSON_Document_Utils::WriteNode(*node_, writer);
+            writer.flush();
+        }
+        return raw;
+    }
+
+    inline std::string JSONDocument::Object::toString() const
+    {
+        std::string jsonText{};
+        {
+            JSONWriter writer(jsonText);
+            _JSON_Document_Utils::WriteNode(*node_, writer);
+        }
+        return jsonText;
+    }
+
+    inline JSONDocument::Object::const_iterator JSONDocument::Object::begin() const
+    {
+        return const_iterator(node_->members);
+    }
+
+    inline JSONDocument::Object::const_iterator JSONDocument::Object::end() const
+    {
+        return const_iterator(node_->members + node_->size);
+    }
+
+    inline JSONDocument::JSONDocument() : arena_(), root_()
+    {
+        root_.type = JSONItem::ItemType::OBJECT;
+    }
+
+    inline JSONDocument::JSONDocument(std::string_view jsonText, ParseMode mode) : arena_(), root_()
+    {
+        parse(jsonText, mode);
+    }
+
+    inline JSONDocument::JSONDocument(const JSONObject &object) : arena_(), root_()
+    {
+        root_ = _JSON_Document_Utils::ItemToNode(object, arena_);
+    }
+
+    inline JSONDocument::JSONDocument(const JSONArray &array) : arena_(), root_()
+    {
+        root_ = _JSON_Document_Utils::ItemToNode(array, arena_);
+    }
+
+    inline JSONDocument::JSONDocument(JSONDocument &&other) noexcept : 
+        arena_(std::move(other.arena_)), 
+        root_(other.root_)
+    {
+        other.root_ = _JSON_Node{};
+        other.root_.type = JSONItem::ItemType::OBJECT;
+    }
+
+    inline JSONDocument::~JSONDocument() { }
+
+    inline JSONDocument &JSONDocument::operator=(JSONDocument &&other) noexcept
+    {
+        if (std::addressof(other) != this) {
+            arena_ = std::move(other.arena_);
+            root_ = other.root_;
+            other.root_ = _JSON_Node{};
+            other.root_.type = JSONItem::ItemType::OBJECT;
+        }
+        return *this;
+    }
+
+    inline void JSONDocument::parse(std::string_view jsonText, ParseMode mode)
+    {
+        clear();
+        _JSON_Document_Utils::DocumentParser parser{};
+        root_ = parser.parse(jsonText, arena_, (mode == ParseMode::BORROW));
+    }
+
+    inline void JSONDocument::assign(Item item, const JSONItem &value)
+    {
+        auto node = const_cast<_JSON_Node*>(item.node_);
+        if (node == nullptr) {
+            throw JSONExcept("Item is not part of a document");
+        }
+        auto keyFlag = node->flags & _JSON_Document_Utils::borrowedKey;
+        *node = _JSON_Document_Utils::ItemToNode(value, arena_);
+        node->flags |= keyFlag;
+    }
+
+    inline void JSONDocument::detach()
+    {
+        _JSON_Document_Utils::DetachNode(root_, arena_);
+    }
+
+    inline void JSONDocument::clear()
+    {
+        arena_.release();
+        root_ = _JSON_Node{};
+        root_.type = JSONItem::ItemType::OBJECT;
+    }
+
+    inline size_t JSONDocument::capacity() const
+    {
+        return arena_.capacity();
+    }
+
+    inline std::string JSONDocument::toString() const
+    {
+        std::string jsonText{};
+        {
+            JSONWriter writer(jsonText);
+            _JSON_Document_Utils::WriteNode(root_, writer);
+        }
+        return jsonText;
+    }
+
+    inline JSONDocument::Item JSONDocument::root() const
+    {
+        return Item(std::addressof(root_));
+    }
+
+    inline JSONDocument::Object JSONDocument::object() const
+    {
+        return root().toObject();
+    }
+
+    inline JSONDocument::Array JSONDocument::array() const
+    {
+        return root().toArray();
+    }
+
+    // Parser state to keep per thread and reuse across documents. The structural index, the scratch stacks and 
+    // the arena blocks of the previous document are retained, so once warmed up, parsing messages of a similar 
+    // shape into a JSONDocument does not allocate. JSONObject / JSONArray results still own their storage, 
+    // parsing them only reuses the buffer of the structural index.
+    class JSONParser
+    {
+        public:
+            inline JSONParser();
+
+            JSONParser(const JSONParser &other) = delete;
+            JSONParser &operator=(const JSONParser &other) = delete;
+
+            // The returned document is overwritten by the next call.
+            inline const JSONDocument &parse(std::string_view jsonText, 
+                JSONDocument::ParseMode mode = JSONDocument::ParseMode::COPY);
+            inline void parse(std::string_view jsonText, JSONDocument &document, 
+                JSONDocument::ParseMode mode = JSONDocument::ParseMode::COPY);
+            inline JSONObject parseObject(std::string_view jsonText);
+            inline JSONArray parseArray(std::string_view jsonText);
+            inline const JSONDocument &document() const;
+            inline void release();
+
+            // Containers nested deeper than maxDepth are rejected with a JSONExcept, 512 by default.
+            inline void setMaxDepth(size_t maxDepth);
+            inline size_t maxDepth() const;
+
+        private:
+            _JSON_Document_Utils::DocumentParser documentParser_;
+            _JSON_Parse_Utils::StructuralIndex index_;
+            JSONDocument document_;
+            size_t maxDepth_;
+    };
+
+    inline JSONParser::JSONParser() : 
+        documentParser_(), 
+        index_(), 
+        document_(),
+        maxDepth_(_JSON_Parse_Utils::defaultMaxDepth)
+    { }
+
+    inline const JSONDocument &JSONParser::parse(std::string_view jsonText, JSONDocument::ParseMode mode)
+    {
+        parse(jsonText, document_, mode);
+        return document_;
+    }
+
+    // Unlike JSONDocument::parse, the arena of the document is reset instead of released.
+    inline void JSONParser::parse(std::string_view jsonText, JSONDocument &document, JSONDocument::ParseMode mode)
+    {
+        document.root_ = _JSON_Node{};
+        document.root_.type = JSONItem::ItemType::OBJECT;
+        document.arena_.reset();
+        document.root_ = documentParser_.parse(jsonText, document.arena_, (mode == JSONDocument::ParseMode::BORROW), maxDepth_);
+    }
+
+    inline JSONObject JSONParser::parseObject(std::string_view jsonText)
+    {
+        return _JSON_Parse_Utils::ParseIndexedObject(jsonText, index_, maxDepth_);
+    }
+
+    inline JSONArray JSONParser::parseArray(std::string_view jsonText)
+    {
+        return _JSON_Parse_Utils::ParseIndexedArray(jsonText, index_, maxDepth_);
+    }
+
+    inline const JSONDocument &JSONParser::document() const
+    {
+        return document_;
+    }
+
+    // Frees the retained buffers, the document is cleared.
+    inline void JSONParser::release()
+    {
+        document_.clear();
+        documentParser_ = _JSON_Document_Utils::DocumentParser();
+        index_ = _JSON_Parse_Utils::StructuralIndex();
+    }
+
+    inline void JSONParser::setMaxDepth(size_t maxDepth)
+    {
+        maxDepth_ = maxDepth;
+    }
+
+    inline size_t JSONParser::maxDepth() const
+    {
+        return maxDepth_;
+    }
+
+    class JSONLazyArray;
+
+    // Lazy views keep a reference to the JSON text, which must outlive them.
+    // Only the outer level is scanned on first access, values are parsed when they are accessed.
+    // The const members may be called from several threads, the scan and the parsed values are 
+    // published under a mutex of the view.
+    class JSONLazyObject
+    {
+        public:
+            inline JSONLazyObject();
+            inline JSONLazyObject(std::string_view jsonText);
+            inline JSONLazyObject(const JSONLazyObject &other);
+            inline JSONLazyObject(JSONLazyObject &&other) noexcept;
+            inline ~JSONLazyObject();
+
+            inline JSONLazyObject &operator=(const JSONLazyObject &other);
+            inline JSONLazyObject &operator=(JSONLazyObject &&other) noexcept;
+            inline const JSONItem &operator[](const std::string &key) const;
+
+            inline const JSONItem &at(const std::string &key) const;
+            inline bool contains(const std::string &key) const;
+            inline JSONLazyObject lazyObject(const std::string &key) const;
+            inline JSONLazyArray lazyArray(const std::string &key) const;
+            inline std::string_view raw(const std::string &key) const;
+            inline size_t size() const;
+            inline bool empty() const;
+            inline std::vector<std::string> order() const;
+            inline JSONObject toObject() const;
+
+        private:
+            friend class JSONLazyArray;
+
+            struct LazyMember
+            {
+                std::string key;
+                size_t beginPos;
+                size_t endPos;
+                std::shared_ptr<const JSONItem> item;
+            };
+
+            std::string_view jsonText_;
+            size_t beginPos_;
+            mutable std::vector<LazyMember> members_;
+            mutable std::unordered_map<std::string_view, size_t> index_;
+            mutable std::atomic<bool> scanned_;
+            mutable std::mutex mutex_;
+
+            inline JSONLazyObject(std::string_view jsonText, size_t beginPos);
+
+            inline void scan_() const;
+            inline void buildIndex_() const;
+            inline const LazyMember &find_(const std::string &key) const;
+    };
+
+    class JSONLazyArray
+    {
+        public:
+            inline JSONLazyArray();
+            inline JSONLazyArray(std::string_view jsonText);
+            inline JSONLazyArray(const JSONLazyArray &other);
+            inline JSONLazyArray(JSONLazyArray &&other) noexcept;
+            inline ~JSONLazyArray();
+
+            inline JSONLazyArray &operator=(const JSONLazyArray &other);
+            inline JSONLazyArray &operator=(JSONLazyArray &&other) noexcept;
+            inline const JSONItem &operator[](size_t pos) const;
+
+            inline const JSONItem &at(size_t pos) const;
+            inline JSONLazyObject lazyObject(size_t pos) const;
+            inline JSONLazyArray lazyArray(size_t pos) const;
+            inline std::string_view raw(size_t pos) const;
+            inline size_t size() const;
+            inline bool empty() const;
+            inline JSONArray toArray() const;
+
+        private:
+            friend class JSONLazyObject;
+
+            struct LazyElement
+            {
+                size_t beginPos;
+                size_t endPos;
+                std::shared_ptr<const JSONItem> item;
+            };
+
+            std::string_view jsonText_;
+            size_t beginPos_;
+            mutable std::vector<LazyElement> elements_;
+            mutable std::atomic<bool> scanned_;
+            mutable std::mutex mutex_;
+
+            inline JSONLazyArray(std::string_view jsonText, size_t beginPos);
+
+            inline void scan_() const;
+            inline const LazyElement &find_(size_t pos) const;
+    };
+
+    inline JSONLazyObject::JSONLazyObject() : 
+        jsonText_("{}"), 
+        beginPos_(0), 
+        members_(), 
+        index_(), 
+        scanned_(false), 
+        mutex_()
+    { }
+
+    inline JSONLazyObject::JSONLazyObject(std::string_view jsonText) : 
+        jsonText_(jsonText), 
+        beginPos_(0), 
+        members_(), 
+        index_(), 
+        scanned_(false), 
+        mutex_()
+    { }
+
+    inline JSONLazyObject::JSONLazyObject(std::string_view jsonText, size_t beginPos) : 
+        jsonText_(jsonText), 
+        beginPos_(beginPos), 
+        members_(), 
+        index_(), 
+        scanned_(false), 
+        mutex_()
+    { }
+
+    inline JSONLazyObject::JSONLazyObject(const JSONLazyObject &other) :
+        jsonText_(other.jsonText_),
+        beginPos_(other.beginPos_),
+        members_(),
+        index_(),
+        scanned_(false),
+        mutex_()
+    {
+        std::unique_lock<std::mutex> lock(other.mutex_);
+        if (other.scanned_.load(std::memory_order_relaxed)) {
+            members_ = other.members_;
+            buildIndex_();
+            scanned_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    inline JSONLazyObject::JSONLazyObject(JSONLazyObject &&other) noexcept :
+        jsonText_(other.jsonText_),
+        beginPos_(other.beginPos_),
+        members_(std::move(other.members_)),
+        index_(),
+        scanned_(other.scanned_.load(std::memory_order_relaxed)),
+        mutex_()
+    {
+        // The keys the index refers to stay in the moved buffer, so the index moves along without rebuilding.
+        index_.swap(other.index_);
+        other.scanned_.store(false, std::memory_order_relaxed);
+    }
+
+    inline JSONLazyObject::~JSONLazyObject() { }
+
+    inline JSONLazyObject &JSONLazyObject::operator=(const JSONLazyObject &other)
+    {
+        if (std::addressof(other) != this) {
+            std::unique_lock<std::mutex> lock(other.mutex_);
+            jsonText_ = other.jsonText_;
+            beginPos_ = other.beginPos_;
+            auto scanned = other.scanned_.load(std::memory_order_relaxed);
+            members_ = scanned ? other.members_ : std::vector<LazyMember>();
+            index_.clear();
+            if (scanned) {
+                buildIndex_();
+            }
+            scanned_.store(scanned, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    inline JSONLazyObject &JSONLazyObject::operator=(JSONLazyObject &&other) noexcept
+    {
+        if (std::addressof(other) != this) {
+            jsonText_ = other.jsonText_;
+            beginPos_ = other.beginPos_;
+            members_ = std::move(other.members_);
+            scanned_.store(other.scanned_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            index_.swap(other.index_);
+            other.index_.clear();
+            other.scanned_.store(false, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    inline const JSONItem &JSONLazyObject::operator[](const std::string &key) const
+    {
+        return at(key);
+    }
+
+    // The value is parsed outside the lock, when two threads parse it at once the first one stored is kept.
+    inline const JSONItem &JSONLazyObject::at(const std::string &key) const
+    {
+        auto &member = members_[std::addressof(find_(key)) - members_.data()];
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (member.item != nullptr) {
+                return *(member.item);
+            }
+        }
+        auto item = std::make_shared<const JSONItem>(
+            _JSON_Parse_Utils::ParseIndexedItem(jsonText_, member.beginPos, member.endPos));
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (member.item == nullptr) {
+            member.item = std::move(item);
+        }
+        return *(member.item);
+    }
+
+    inline bool JSONLazyObject::contains(const std::string &key) const
+    {
+        scan_();
+        if (index_.empty()) {
+            for (const auto &member : members_) {
+                if (member.key == key) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return (index_.count(key) == 1);
+    }
+
+    inline JSONLazyObject JSONLazyObject::lazyObject(const std::string &key) const
+    {
+        const auto &member = find_(key);
+        if (jsonText_[member.beginPos] != '{') {
+            throw JSONExcept("Item is not of object type");
+        }
+        return JSONLazyObject(jsonText_, member.beginPos);
+    }
+
+    inline JSONLazyArray JSONLazyObject::lazyArray(const std::string &key) const
+    {
+        const auto &member = find_(key);
+        if (jsonText_[member.beginPos] != '[') {
+            throw JSONExcept("Item is not of array type");
+        }
+        return JSONLazyArray(jsonText_, member.beginPos);
+    }
+
+    inline std::string_view JSONLazyObject::raw(const std::string &key) const
+    {
+        const auto &member = find_(key);
+        return jsonText_.substr(member.beginPos, (member.endPos - member.beginPos));
+    }
+
+    inline size_t JSONLazyObject::size() const
+    {
+        scan_();
+        return members_.size();
+    }
+
+    inline bool JSONLazyObject::empty() const
+    {
+        scan_();
+        return members_.empty();
+    }
+
+    inline std::vector<std::string> JSONLazyObject::order() const
+    {
+        scan_();
+        std::vector<std::string> order{};
+        order.reserve(members_.size());
+        for (const auto &member : members_) {
+            order.emplace_back(member.key);
+        }
+        return order;
+    }
+
+    inline JSONObject JSONLazyObject::toObject() const
+    {
+        scan_();
+        std::vector<JSONObject::JSONPair> members{};
+        members.reserve(members_.size());
+        for (const auto &member : members_) {
+            members.push_back({JSONKey(member.key), at(member.key)});
+        }
+        return JSONObject(std::move(members));
+    }
+
+    // The members are only read by other threads once scanned_ is published.
+    inline void JSONLazyObject::scan_() const
+    {
+        if (scanned_.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (scanned_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        members_.clear();
+        index_.clear();
+
+        auto pos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, beginPos_);
+        if (pos == std::string_view::npos || jsonText_[pos] != '{') {
+            _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Object must begin with \'{\'", jsonText_, beginPos_);
+        }
+        auto objectPos = pos;
+        pos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, (pos + 1));
+        if (pos != std::string_view::npos && jsonText_[pos] == '}') {
+            scanned_.store(true, std::memory_order_release);
+            return;
+        }
+        while (pos < jsonText_.size()) {
+            auto keyResult = _JSON_Parse_Utils::ParseJSONString(jsonText_, pos);
+            pos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, keyResult.endPos);
+            if (pos == std::string_view::npos || jsonText_[pos] != ':') {
+                _JSON_Parse_Utils::ThrowSyntaxExcept("key and value must be separated by \':\'", 
+                    jsonText_, std::min(pos, jsonText_.size()));
+            }
+            auto valuePos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, (pos + 1));
+            if (valuePos == std::string_view::npos) {
+                break;
+            }
+            auto valueEnd = _JSON_Parse_Utils::SkipJSONItem(jsonText_, valuePos);
+            members_.push_back({keyResult.resultVal.data(), valuePos, valueEnd, nullptr});
+
+            pos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, valueEnd);
+            if (pos == std::string_view::npos) {
+                break;
+            } else if (jsonText_[pos] == '}') {
+                buildIndex_();
+                scanned_.store(true, std::memory_order_release);
+                return;
+            } else if (jsonText_[pos] == ',') {
+                pos++;
+            } else {
+                _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Object elements must be separated by \',\'", jsonText_, pos);
+            }
+        }
+        _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Object must end with \'}\'", jsonText_, objectPos);
+    }
+
+    inline void JSONLazyObject::buildIndex_() const
+    {
+        static constexpr size_t indexMinSize = 16;
+
+        index_.clear();
+        if (members_.size() > indexMinSize) {
+            index_.reserve(members_.size());
+            for (size_t idx = 0; idx < members_.size(); idx++) {
+                index_.emplace(members_[idx].key, idx);
+            }
+        }
+    }
+
+    inline const JSONLazyObject::LazyMember &JSONLazyObject::find_(const std::string &key) const
+    {
+        scan_();
+        if (index_.empty()) {
+            for (const auto &member : members_) {
+                if (member.key == key) {
+                    return member;
+                }
+            }
+        } else {
+            auto iter = index_.find(key);
+            if (iter != index_.end()) {
+                return members_[iter->second];
+            }
+        }
+        throw JSONExcept("Key not found");
+    }
+
+    inline JSONLazyArray::JSONLazyArray() : jsonText_("[]"), beginPos_(0), elements_(), scanned_(false), mutex_() { }
+
+    inline JSONLazyArray::JSONLazyArray(std::string_view jsonText) : 
+        jsonText_(jsonText), 
+        beginPos_(0), 
+        elements_(), 
+        scanned_(false), 
+        mutex_()
+    { }
+
+    inline JSONLazyArray::JSONLazyArray(std::string_view jsonText, size_t beginPos) : 
+        jsonText_(jsonText), 
+        beginPos_(beginPos), 
+        elements_(), 
+        scanned_(false), 
+        mutex_()
+    { }
+
+    inline JSONLazyArray::JSONLazyArray(const JSONLazyArray &other) :
+        jsonText_(other.jsonText_),
+        beginPos_(other.beginPos_),
+        elements_(),
+        scanned_(false),
+        mutex_()
+    {
+        std::unique_lock<std::mutex> lock(other.mutex_);
+        if (other.scanned_.load(std::memory_order_relaxed)) {
+            elements_ = other.elements_;
+            scanned_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    inline JSONLazyArray::JSONLazyArray(JSONLazyArray &&other) noexcept :
+        jsonText_(other.jsonText_),
+        beginPos_(other.beginPos_),
+        elements_(std::move(other.elements_)),
+        scanned_(other.scanned_.load(std::memory_order_relaxed)),
+        mutex_()
+    {
+        other.scanned_.store(false, std::memory_order_relaxed);
+    }
+
+    inline JSONLazyArray::~JSONLazyArray() { }
+
+    inline JSONLazyArray &JSONLazyArray::operator=(const JSONLazyArray &other)
+    {
+        if (std::addressof(other) != this) {
+            std::unique_lock<std::mutex> lock(other.mutex_);
+            jsonText_ = other.jsonText_;
+            beginPos_ = other.beginPos_;
+            auto scanned = other.scanned_.load(std::memory_order_relaxed);
+            elements_ = scanned ? other.elements_ : std::vector<LazyElement>();
+            scanned_.store(scanned, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    inline JSONLazyArray &JSONLazyArray::operator=(JSONLazyArray &&other) noexcept
+    {
+        if (std::addressof(other) != this) {
+            jsonText_ = other.jsonText_;
+            beginPos_ = other.beginPos_;
+            elements_ = std::move(other.elements_);
+            scanned_.store(other.scanned_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other.scanned_.store(false, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    inline const JSONItem &JSONLazyArray::operator[](size_t pos) const
+    {
+        return at(pos);
+    }
+
+    // Parsed and published like JSONLazyObject::at().
+    inline const JSONItem &JSONLazyArray::at(size_t pos) const
+    {
+        find_(pos);
+        auto &element = elements_[pos];
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (element.item != nullptr) {
+                return *(element.item);
+            }
+        }
+        auto item = std::make_shared<const JSONItem>(
+            _JSON_Parse_Utils::ParseIndexedItem(jsonText_, element.beginPos, element.endPos));
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (element.item == nullptr) {
+            element.item = std::move(item);
+        }
+        return *(element.item);
+    }
+
+    inline JSONLazyObject JSONLazyArray::lazyObject(size_t pos) const
+    {
+        const auto &element = find_(pos);
+        if (jsonText_[element.beginPos] != '{') {
+            throw JSONExcept("Item is not of object type");
+        }
+        return JSONLazyObject(jsonText_, element.beginPos);
+    }
+
+    inline JSONLazyArray JSONLazyArray::lazyArray(size_t pos) const
+    {
+        const auto &element = find_(pos);
+        if (jsonText_[element.beginPos] != '[') {
+            throw JSONExcept("Item is not of array type");
+        }
+        return JSONLazyArray(jsonText_, element.beginPos);
+    }
+
+    inline std::string_view JSONLazyArray::raw(size_t pos) const
+    {
+        const auto &element = find_(pos);
+        return jsonText_.substr(element.beginPos, (element.endPos - element.beginPos));
+    }
+
+    inline size_t JSONLazyArray::size() const
+    {
+        scan_();
+        return elements_.size();
+    }
+
+    inline bool JSONLazyArray::empty() const
+    {
+        scan_();
+        return elements_.empty();
+    }
+
+    inline JSONArray JSONLazyArray::toArray() const
+    {
+        scan_();
+        std::vector<JSONItem> array{};
+        array.reserve(elements_.size());
+        for (size_t pos = 0; pos < elements_.size(); pos++) {
+            array.emplace_back(at(pos));
+        }
+        return JSONArray(std::move(array));
+    }
+
+    inline void JSONLazyArray::scan_() const
+    {
+        if (scanned_.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (scanned_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        elements_.clear();
+
+        auto pos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, beginPos_);
+        if (pos == std::string_view::npos || jsonText_[pos] != '[') {
+            _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Array must begin with \'[\'", jsonText_, beginPos_);
+        }
+        auto arrayPos = pos;
+        pos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, (pos + 1));
+        if (pos != std::string_view::npos && jsonText_[pos] == ']') {
+            scanned_.store(true, std::memory_order_release);
+            return;
+        }
+        while (pos < jsonText_.size()) {
+            auto valuePos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, pos);
+            if (valuePos == std::string_view::npos) {
+                break;
+            }
+            auto valueEnd = _JSON_Parse_Utils::SkipJSONItem(jsonText_, valuePos);
+            elements_.push_back({valuePos, valueEnd, nullptr});
+
+            pos = _JSON_Parse_Utils::IgnoreBlank(jsonText_, valueEnd);
+            if (pos == std::string_view::npos) {
+                break;
+            } else if (jsonText_[pos] == ']') {
+                scanned_.store(true, std::memory_order_release);
+                return;
+            } else if (jsonText_[pos] == ',') {
+                pos++;
+            } else {
+                _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Array elements must be separated by \',\'", jsonText_, pos);
+            }
+        }
+        _JSON_Parse_Utils::ThrowSyntaxExcept("JSON Array must end with \']\'", jsonText_, arrayPos);
+    }
+
+    inline const JSONLazyArray::LazyElement &JSONLazyArray::find_(size_t pos) const
+    {
+        scan_();
+        if (pos >= elements_.size()) {
+            throw JSONExcept("Position out of bounds");
+        }
+        return elements_[pos];
+    }
+
+    class JSONStreamHandler
+    {
+        public:
+            virtual ~JSONStreamHandler() { }
+
+            virtual void onStartObject() { }
+            virtual void onEndObject() { }
+            virtual void onStartArray() { }
+            virtual void onEndArray() { }
+            virtual void onKey(std::string_view) { }
+            virtual void onValue(const JSONItem &) { }
+            virtual void onEndDocument() { }
+
+            virtual void onString(std::string_view value)
+            {
+                onValue(JSONItem(std::string(value.data(), value.size())));
+            }
+    };
+
+    // Push parser for JSON texts that arrive in chunks, top-level items may follow each other
+    // (e.g. JSON Lines). Only a token split across chunks is buffered, up to maxTokenSize bytes.
+    class JSONStreamParser
+    {
+        public:
+            static constexpr size_t defaultMaxTokenSize = 16 * 1024 * 1024;
+
+            inline JSONStreamParser(JSONStreamHandler &handler, size_t maxTokenSize = defaultMaxTokenSize);
+            inline ~JSONStreamParser();
+
+            JSONStreamParser(const JSONStreamParser &other) = delete;
+            JSONStreamParser &operator=(const JSONStreamParser &other) = delete;
+
+            inline void feed(const char* data, size_t size);
+            inline void feed(std::string_view data);
+            inline void finish();
+            inline void reset();
+            inline size_t depth() const noexcept;
+            inline size_t line() const noexcept;
+
+        private:
+            enum class State : uint8_t {VALUE, ARRAY_FIRST, OBJECT_FIRST, KEY, COLON, NEXT, STRING, SCALAR};
+
+            JSONStreamHandler &handler_;
+            size_t maxTokenSize_;
+            State state_;
+            std::string containers_;
+            std::string token_;
+            std::string buffer_;
+            size_t tokenBegin_;
+            size_t line_;
+            bool isKey_;
+            bool escape_;
+            bool hasEscape_;
+
+            inline size_t structural_(const char* data, size_t pos);
+            inline size_t scanString_(const char* data, size_t size, size_t pos);
+            inline size_t scanScalar_(const char* data, size_t size, size_t pos);
+            inline void endString_(std::string_view rawText);
+            inline void endScalar_(std::string_view rawText);
+            inline void endItem_();
+            inline void bufferToken_(const char* data, size_t size);
+            inline void throwSyntax_(const char* message) const;
+    };
+
+    inline JSONStreamParser::JSONStreamParser(JSONStreamHandler &handler, size_t maxTokenSize) : 
+        handler_(handler),
+        maxTokenSize_(maxTokenSize),
+        state_(State::VALUE),
+        containers_(),
+        token_(),
+        buffer_(),
+        tokenBegin_(0),
+        line_(0),
+        isKey_(false),
+        escape_(false),
+        hasEscape_(false)
+    { }
+
+    inline JSONStreamParser::~JSONStreamParser() { }
+
+    inline void JSONStreamParser::feed(const char* data, size_t size)
+    {
+        size_t pos = 0;
+        tokenBegin_ = 0;
+        while (pos < size) {
+            switch (state_) {
+                case State::STRING:
+                    pos = scanString_(data, size, pos);
+                    break;
+                case State::SCALAR:
+                    pos = scanScalar_(data, size, pos);
+                    break;
+                default:
+                    switch (data[pos]) {
+                        case '\n':
+                            line_++;
+                            pos++;
+                            break;
+                        case ' ':
+                        case '\t':
+                        case '\r':
+                        case '\f':
+                        case '\a':
+                        case '\b':
+                        case '\v':
+                            pos++;
+                            break;
+                        default:
+                            pos = structural_(data, pos);
+                            break;
+                    }
+                    break;
+            }
+        }
+        if (state_ == State::STRING || state_ == State::SCALAR) {
+            bufferToken_((data + tokenBegin_), (size - tokenBegin_));
+        }
+    }
+
+    inline void JSONStreamParser::feed(std::string_view data)
+    {
+        feed(data.data(), data.size());
+    }
+
+    inline void JSONStreamParser::finish()
+    {
+        if (state_ == State::SCALAR) {
+            endScalar_(token_);
+        }
+        if (state_ == State::STRING) {
+            throwSyntax_("JSON String must end with \'\"\'");
+        }
+        if (!containers_.empty()) {
+            if (containers_.back() == '{') {
+                throwSyntax_("JSON Object must end with \'}\'");
+            }
+            throwSyntax_("JSON Array must end with \']\'");
+        }
+    }
+
+    inline void JSONStreamParser::reset()
+    {
+        state_ = State::VALUE;
+        containers_.clear();
+        token_.clear();
+        tokenBegin_ = 0;
+        line_ = 0;
+        isKey_ = false;
+        escape_ = false;
+        hasEscape_ = false;
+    }
+
+    inline size_t JSONStreamParser::depth() const noexcept
+    {
+        return containers_.size();
+    }
+
+    inline size_t JSONStreamParser::line() const noexcept
+    {
+        return (line_ + 1);
+    }
+
+    inline size_t JSONStreamParser::structural_(const char* data, size_t pos)
+    {
+        auto ch = data[pos];
+        switch (state_) {
+            case State::VALUE:
+            case State::ARRAY_FIRST:
+                switch (ch) {
+                    case '{':
+                        containers_.push_back('{');
+                        state_ = State::OBJECT_FIRST;
+                        handler_.onStartObject();
+                        break;
+                    case '[':
+                        containers_.push_back('[');
+                        state_ = State::ARRAY_FIRST;
+                        handler_.onStartArray();
+                        break;
+                    case '\"':
+                        state_ = State::STRING;
+                        tokenBegin_ = pos + 1;
+                        isKey_ = false;
+                        hasEscape_ = false;
+                        break;
+                    case ']':
+                        if (state_ != State::ARRAY_FIRST) {
+                            throwSyntax_("unknown JSON Item");
+                        }
+                        containers_.pop_back();
+                        handler_.onEndArray();
+                        endItem_();
+                        break;
+                    case '}':
+                    case ',':
+                    case ':':
+                        throwSyntax_("unknown JSON Item");
+                        break;
+                    default:
+                        state_ = State::SCALAR;
+                        tokenBegin_ = pos;
+                        break;
+                }
+                break;
+            case State::OBJECT_FIRST:
+            case State::KEY:
+                if (ch == '\"') {
+                    state_ = State::STRING;
+                    tokenBegin_ = pos + 1;
+                    isKey_ = true;
+                    hasEscape_ = false;
+                } else if (ch == '}' && state_ == State::OBJECT_FIRST) {
+                    containers_.pop_back();
+                    handler_.onEndObject();
+                    endItem_();
+                } else {
+                    throwSyntax_("JSON String must begin with \'\"\'");
+                }
+                break;
+            case State::COLON:
+                if (ch != ':') {
+                    throwSyntax_("key and value must be separated by \':\'");
+                }
+                state_ = State::VALUE;
+                break;
+            case State::NEXT:
+                if (containers_.back() == '{') {
+                    if (ch == ',') {
+                        state_ = State::KEY;
+                    } else if (ch == '}') {
+                        containers_.pop_back();
+                        handler_.onEndObject();
+                        endItem_();
+                    } else {
+                        throwSyntax_("JSON Object elements must be separated by \',\'");
+                    }
+                } else {
+                    if (ch == ',') {
+                        state_ = State::VALUE;
+                    } else if (ch == ']') {
+                        containers_.pop_back();
+                        handler_.onEndArray();
+                        endItem_();
+                    } else {
+                        throwSyntax_("JSON Array elements must be separated by \',\'");
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        return (pos + 1);
+    }
+
+    inline size_t JSONStreamParser::scanString_(const char* data, size_t size, size_t pos)
+    {
+        while (pos < size) {
+            auto ch = data[pos];
+            if (ch == '\n') {
+                line_++;
+            }
+            if (escape_) {
+                escape_ = false;
+            } else if (ch == '\\') {
+                escape_ = true;
+                hasEscape_ = true;
+            } else if (ch == '\"') {
+                if (token_.empty()) {
+                    endString_(std::string_view((data + tokenBegin_), (pos - tokenBegin_)));
+                } else {
+                    bufferToken_((data + tokenBegin_), (pos - tokenBegin_));
+                    endString_(token_);
+                }
+                return (pos + 1);
+            }
+            pos++;
+        }
+        return pos;
+    }
+
+    inline size_t JSONStreamParser::scanScalar_(const char* data, size_t size, size_t pos)
+    {
+        while (pos < size) {
+            switch (data[pos]) {
+                case ' ':
+                case '\n':
+                case '\t':
+                case '\r':
+                case '\f':
+                case '\a':
+                case '\b':
+                case '\v':
+                case ',':
+                case ']':
+                case '}':
+                    if (token_.empty()) {
+                        endScalar_(std::string_view((data + tokenBegin_), (pos - tokenBegin_)));
+                    } else {
+                        bufferToken_((data + tokenBegin_), (pos - tokenBegin_));
+                        endScalar_(token_);
+                    }
+                    return pos;
+                default:
+                    break;
+            }
+            pos++;
+        }
+        return pos;
+    }
+
+    inline void JSONStreamParser::endString_(std::string_view rawText)
+    {
+        if (rawText.size() > maxTokenSize_) {
+            throwSyntax_("JSON String exceeds the token size limit");
+        }
+
+        std::string_view text = rawText;
+        if (hasEscape_) {
+            buffer_.clear();
+            size_t pos = 0;
+            try {
+                while (pos < rawText.size()) {
+                    if (rawText[pos] == '\\') {
+                        auto charResult = _JSON_Parse_Utils::ParseEscapeChar(rawText, pos);
+                        buffer_.append(charResult.resultVal.data());
+                        pos = charResult.endPos;
+                    } else {
+                        buffer_.push_back(rawText[pos]);
+                        pos++;
+                    }
+                }
+            } catch (const JSONExcept &) {
+                throwSyntax_("faild to parse escape char in JSON String");
+            }
+            text = buffer_;
+        }
+        if (isKey_) {
+            handler_.onKey(text);
+            state_ = State::COLON;
+        } else {
+            handler_.onString(text);
+            endItem_();
+        }
+        token_.clear();
+    }
+
+    inline void JSONStreamParser::endScalar_(std::string_view rawText)
+    {
+        if (rawText.size() > maxTokenSize_) {
+            throwSyntax_("JSON Item exceeds the token size limit");
+        }
+
+        // ParseJSONItem expects the text to continue after the item.
+        buffer_.assign(rawText.data(), rawText.size());
+        buffer_.push_back(' ');
+        JSONItem value{};
+        bool isValid = false;
+        try {
+            auto itemResult = _JSON_Parse_Utils::ParseJSONItem(buffer_, 0);
+            if (itemResult.endPos == rawText.size()) {
+                value = std::move(itemResult.resultVal);
+                isValid = true;
+            }
+        } catch (const JSONExcept &) { }
+        if (!isValid) {
+            throwSyntax_("unknown JSON Item");
+        }
+        token_.clear();
+        handler_.onValue(value);
+        endItem_();
+    }
+
+    inline void JSONStreamParser::endItem_()
+    {
+        if (containers_.empty()) {
+            state_ = State::VALUE;
+            handler_.onEndDocument();
+        } else {
+            state_ = State::NEXT;
+        }
+    }
+
+    inline void JSONStreamParser::bufferToken_(const char* data, size_t size)
+    {
+        if ((token_.size() + size) > maxTokenSize_) {
+            throwSyntax_("JSON Item exceeds the token size limit");
+        }
+        token_.append(data, size);
+    }
+
+    inline void JSONStreamParser::throwSyntax_(const char* message) const
+    {
+        char except_msg[4096]{};
+        std::snprintf(except_msg, sizeof(except_msg), "Invalid syntax on line %zu: %s", line(), message);
+        throw JSONExcept(except_msg);
+    }
+
+    namespace JSONParallel
+    {
+        constexpr size_t minChunkSize = 64 * 1024;
+
+        // Splits a top-level JSON Array at its top-level commas and parses the elements on threadCount 
+        // threads (0 means one per hardware thread). Results and exceptions are the same as JSONArray(jsonText).
+        inline JSONArray ParseArray(std::string_view jsonText, size_t threadCount = 0)
+        {
+            if (threadCount == 0) {
+                threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            }
+            threadCount = std::min(threadCount, (jsonText.size() / minChunkSize));
+            if (threadCount <= 1) {
+                return JSONArray(jsonText);
+            }
+
+            _JSON_Parse_Utils::StructuralIndex index{};
+            index.build(jsonText);
+            const auto parseSerial = [&jsonText, &index]() -> JSONArray {
+                if (index.usable(jsonText)) {
+                    return _JSON_Parse_Utils::IndexedParser(jsonText, index).parseArray();
+                }
+                return _JSON_Parse_Utils::ParseJSONArray(jsonText, 0).resultVal;
+            };
+            if (!index.usable(jsonText)) {
+                return parseSerial();
+            }
+
+            auto tokens = index.data();
+            std::vector<uint32_t> elementTokens{};
+            size_t depth = 0;
+            for (size_t token = 0; token < index.size(); token++) {
+                switch (jsonText[tokens[token]]) {
+                    case '[':
+                    case '{':
+                        depth++;
+                        if (token == 0) {
+                            elementTokens.emplace_back(1);
+                        }
+                        break;
+                    case ']':
+                    case '}':
+                        depth--;
+                        break;
+                    case ',':
+                        if (depth == 1) {
+                            elementTokens.emplace_back(static_cast<uint32_t>(token + 1));
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                if (depth == 0) {
+                    elementTokens.emplace_back(static_cast<uint32_t>(token + 1));
+                    break;
+                }
+            }
+            if (depth != 0 || jsonText[tokens[0]] != '[' || elementTokens.size() < (threadCount + 1)) {
+                return parseSerial();
+            }
+
+            auto elementCount = elementTokens.size() - 1;
+            JSONArray array(elementCount);
+            auto elements = std::addressof(array.front());
+            std::atomic<bool> failed(false);
+            std::vector<std::thread> workers{};
+            size_t first = 0;
+            for (size_t idx = 0; idx < threadCount && first < elementCount; idx++) {
+                size_t last = elementCount;
+                if ((idx + 1) < threadCount) {
+                    auto chunkEnd = tokens[elementTokens[first]] + (jsonText.size() - tokens[elementTokens[first]]) / (threadCount - idx);
+                    auto iter = std::lower_bound(elementTokens.begin() + first + 1, elementTokens.end() - 1, chunkEnd,
+                        [tokens](uint32_t token, size_t pos) { return tokens[token] < pos; });
+                    last = iter - elementTokens.begin();
+                }
+                workers.emplace_back([&jsonText, &index, &elementTokens, &failed, elements, first, last]() {
+                    try {
+                        // The elements sit one level below the array.
+                        _JSON_Parse_Utils::IndexedParser(jsonText, index, (_JSON_Parse_Utils::defaultMaxDepth - 1)).parseElements(
+                            (elementTokens.data() + first), (last - first), (elements + first));
+                    } catch (...) {
+                        failed = true;
+                    }
+                });
+                first = last;
+            }
+            for (auto &worker : workers) {
+                worker.join();
+            }
+            // Only the serial parse knows which of the errors comes first in the text.
+            if (failed) {
+                return parseSerial();
+            }
+            return array;
+        }
+    }
+
+    // Read-only view of a whole file, memory-mapped where the platform supports it, read into memory otherwise.
+    class _JSON_Mapped_File
+    {
+        public:
+            _JSON_Mapped_File() noexcept : data_(nullptr), size_(0), mapped_(false), buffer_() { }
+
+            _JSON_Mapped_File(const _JSON_Mapped_File &other) = delete;
+
+            _JSON_Mapped_File(_JSON_Mapped_File &&other) noexcept :
+                data_(other.data_),
+                size_(other.size_),
+                mapped_(other.mapped_),
+                buffer_(std::move(other.buffer_))
+            {
+                if (!mapped_) {
+                    data_ = buffer_.data();
+                }
+                other.data_ = nullptr;
+                other.size_ = 0;
+                other.mapped_ = false;
+            }
+
+            ~_JSON_Mapped_File() noexcept
+            {
+                close();
+            }
+
+            _JSON_Mapped_File &operator=(const _JSON_Mapped_File &other) = delete;
+
+            // Sequential access hints read-ahead, random access suits lookups into large files.
+            bool open(const std::string &path, bool sequential = true)
+            {
+                close();
+#if defined(_CU_JSON_MMAP_)
+                auto fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    return false;
+                }
+                struct stat fileStat{};
+                if (::fstat(fd, std::addressof(fileStat)) != 0) {
+                    ::close(fd);
+                    return false;
+                }
+                size_ = static_cast<size_t>(fileStat.st_size);
+                if (size_ > 0) {
+                    auto addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (addr != MAP_FAILED) {
+                        ::madvise(addr, size_, (sequential ? MADV_SEQUENTIAL : MADV_RANDOM));
+                        data_ = reinterpret_cast<const char*>(addr);
+                        mapped_ = true;
+                    }
+                }
+                ::close(fd);
+                if (mapped_ || size_ == 0) {
+                    return true;
+                }
+#endif
+                auto fp = std::fopen(path.c_str(), "rb");
+                if (fp == nullptr) {
+                    size_ = 0;
+                    return false;
+                }
+                char block[4096]{};
+                size_t len = 0;
+                while ((len = std::fread(block, sizeof(char), sizeof(block), fp)) > 0) {
+                    buffer_.append(block, len);
+                }
+                std::fclose(fp);
+                data_ = buffer_.data();
+                size_ = buffer_.size();
+                return true;
+            }
+
+            void close() noexcept
+            {
+#if defined(_CU_JSON_MMAP_)
+                if (mapped_) {
+                    ::munmap(const_cast<char*>(data_), size_);
+                }
+#endif
+                data_ = nullptr;
+                size_ = 0;
+                mapped_ = false;
+                buffer_.clear();
+                buffer_.shrink_to_fit();
+            }
+
+            std::string_view view() const noexcept
+            {
+                if (data_ == nullptr) {
+                    return {};
+                }
+                return std::string_view(data_, size_);
+            }
+
+        private:
+            const char* data_;
+            size_t size_;
+            bool mapped_;
+            std::string buffer_;
+    };
+
+    namespace JSONLines
+    {
+        struct LineError
+        {
+            size_t line;
+            std::string message;
+        };
+
+        typedef std::function<void(size_t line, JSONObject &&object)> ObjectHandler;
+
+        constexpr size_t batchSize = 8 * 1024 * 1024;
+
+        inline void _ParseLines(std::string_view jsonText, const std::vector<size_t> &lines, 
+            std::vector<JSONObject> &objects, std::vector<std::string> &messages, size_t first, size_t last)
+        {
+            static constexpr std::string_view linePrefix = "Invalid syntax on line 1: ";
+
+            for (auto idx = first; idx < last; idx++) {
+                auto lineText = jsonText.substr(lines[idx * 3 + 1], (lines[idx * 3 + 2] - lines[idx * 3 + 1]));
+                try {
+                    objects[idx] = JSONObject(lineText);
+                } catch (const JSONExcept &e) {
+                    std::string_view message(e.what());
+                    if (message.substr(0, linePrefix.size()) == linePrefix) {
+                        message.remove_prefix(linePrefix.size());
+                        char prefix[64]{};
+                        std::snprintf(prefix, sizeof(prefix), "Invalid syntax on line %zu: ", lines[idx * 3]);
+                        messages[idx] = std::string(prefix) + std::string(message);
+                    } else {
+                        messages[idx] = message;
+                    }
+                }
+            }
+        }
+
+        // Splits jsonText into lines and parses each non-blank line as a JSONObject, batches of lines are parsed 
+        // on threadCount threads (0 means one per hardware thread) and handed to handler in line order.
+        // Lines that fail to parse are reported in errors instead.
+        inline void ParseObjects(std::string_view jsonText, const ObjectHandler &handler, 
+            std::vector<LineError> &errors, size_t threadCount = 0)
+        {
+            static const auto isBlankLine = [](std::string_view line) -> bool {
+                for (const auto &ch : line) {
+                    switch (ch) {
+                        case ' ':
+                        case '\t':
+                        case '\r':
+                        case '\f':
+                        case '\v':
+                            break;
+                        default:
+                            return false;
+                    }
+                }
+                return true;
+            };
+
+            if (threadCount == 0) {
+                threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            }
+
+            // Triples of line number, begin and end position.
+            std::vector<size_t> lines{};
+            std::vector<JSONObject> objects{};
+            std::vector<std::string> messages{};
+            size_t pos = 0, lineNumber = 0;
+            while (pos < jsonText.size()) {
+                auto batchBegin = pos;
+                lines.clear();
+                while (pos < jsonText.size() && (pos - batchBegin) < batchSize) {
+                    auto lineEnd = jsonText.size();
+                    auto newLine = std::memchr((jsonText.data() + pos), '\n', (jsonText.size() - pos));
+                    if (newLine != nullptr) {
+                        lineEnd = reinterpret_cast<const char*>(newLine) - jsonText.data();
+                    }
+                    lineNumber++;
+                    if (!isBlankLine(jsonText.substr(pos, (lineEnd - pos)))) {
+                        lines.insert(lines.end(), {lineNumber, pos, lineEnd});
+                    }
+                    pos = lineEnd + 1;
+                }
+
+                auto lineCount = lines.size() / 3;
+                objects.assign(lineCount, JSONObject());
+                messages.assign(lineCount, std::string());
+                auto workerCount = std::min(threadCount, ((pos - batchBegin) / (64 * 1024) + 1));
+                if (workerCount <= 1) {
+                    _ParseLines(jsonText, lines, objects, messages, 0, lineCount);
+                } else {
+                    std::vector<std::thread> workers{};
+                    for (size_t idx = 0; idx < workerCount; idx++) {
+                        auto first = lineCount * idx / workerCount;
+                        auto last = lineCount * (idx + 1) / workerCount;
+                        workers.emplace_back(_ParseLines, jsonText, std::cref(lines), 
+                            std::ref(objects), std::ref(messages), first, last);
+                    }
+                    for (auto &worker : workers) {
+                        worker.join();
+                    }
+                }
+
+                for (size_t idx = 0; idx < lineCount; idx++) {
+                    if (messages[idx].empty()) {
+                        handler(lines[idx * 3], std::move(objects[idx]));
+                    } else {
+                        errors.push_back({lines[idx * 3], std::move(messages[idx])});
+                    }
+                }
+            }
+        }
+
+        inline std::vector<JSONObject> ParseObjects(std::string_view jsonText, std::vector<LineError> &errors, size_t threadCount = 0)
+        {
+            std::vector<JSONObject> objects{};
+            ParseObjects(jsonText, [&objects](size_t, JSONObject &&object) {
+                objects.emplace_back(std::move(object));
+            }, errors, threadCount);
+            return objects;
+        }
+
+        inline void ReadObjects(const std::string &path, const ObjectHandler &handler, 
+            std::vector<LineError> &errors, size_t threadCount = 0)
+        {
+            _JSON_Mapped_File file{};
+            if (!file.open(path)) {
+                throw JSONExcept("Failed to open file");
+            }
+            ParseObjects(file.view(), handler, errors, threadCount);
+        }
+
+        inline std::vector<JSONObject> ReadObjects(const std::string &path, std::vector<LineError> &errors, size_t threadCount = 0)
+        {
+            std::vector<JSONObject> objects{};
+            ReadObjects(path, [&objects](size_t, JSONObject &&object) {
+                objects.emplace_back(std::move(object));
+            }, errors, threadCount);
+            return objects;
+        }
+
+        inline std::string ToString(const std::vector<JSONObject> &objects)
+        {
+            std::string jsonText{};
+            {
+                JSONWriter writer(jsonText);
+                for (const auto &object : objects) {
+                    writer.write(object);
+                    writer.writeRaw("\n");
+                }
+            }
+            return jsonText;
+        }
+
+        // Serializes all objects first, then hands them to the system in a single unbuffered write.
+        inline void WriteObjects(const std::string &path, const std::vector<JSONObject> &objects, bool append = false)
+        {
+            auto jsonText = ToString(objects);
+            auto fp = std::fopen(path.c_str(), (append ? "ab" : "wb"));
+            if (fp == nullptr) {
+                throw JSONExcept("Failed to open file");
+            }
+            std::setvbuf(fp, nullptr, _IONBF, 0);
+            auto len = std::fwrite(jsonText.data(), sizeof(char), jsonText.size(), fp);
+            std::fclose(fp);
+            if (len != jsonText.size()) {
+                throw JSONExcept("Failed to write file");
+            }
+        }
+    }
+
+    namespace JSONBinary
+    {
+        typedef uint32_t pos_t;
+        typedef int8_t byte_t;
+
+        constexpr pos_t npos = static_cast<pos_t>(-1);
+
+        inline void* _Move_Ptr(void* ptr, pos_t pos) noexcept
+        {
+            return reinterpret_cast<void*>(reinterpret_cast<byte_t*>(ptr) + pos);
+        }
+
+        inline const void* _Move_Ptr(const void* ptr, pos_t pos) noexcept
+        {
+            return reinterpret_cast<const void*>(reinterpret_cast<const byte_t*>(ptr) + pos);
+        }
 
         class _Binary_Container
         {
-            public:
-                _Binary_Container() noexcept : 
-                    block_(reinterpret_cast<byte_t*>(std::malloc(128))), 
-                    capacity_(128), 
-                    size_(0)
-                { }
+            public:
+                _Binary_Container() noexcept : 
+                    block_(reinterpret_cast<byte_t*>(std::malloc(128))), 
+                    capacity_(128), 
+                    size_(0)
+                { }
+
+                ~_Binary_Container() noexcept
+                {
+                    if (block_ != nullptr) {
+                        std::free(block_);
+                    }
+                }
+
+                void resize(pos_t req_capacity) noexcept
+                {
+                    auto new_block = reinterpret_cast<byte_t*>(std::realloc(block_, req_capacity));
+                    if (new_block != nullptr) {
+                        block_ = new_block;
+                        capacity_ = req_capacity;
+                    }
+                    if (size_ > capacity_) {
+                        size_ = capacity_;
+                    }
+                }
+
+                void add(const void* data, pos_t data_size) noexcept
+                {
+                    if ((size_ + data_size) > capacity_) {
+                        resize(size_ * 2 + data_size);
+                    }
+                    auto dst = _Move_Ptr(block_, size_);
+                    if (dst != nullptr && data != nullptr) {
+                        std::memcpy(dst, data, data_size);
+                        size_ += data_size;
+                    }
+                }
+
+                byte_t* data() noexcept
+                {
+                    return block_;
+                }
+
+                byte_t* dump() noexcept
+                {
+                    auto dump_data = block_;
+                    block_ = nullptr;
+                    capacity_ = 0;
+                    size_ = 0;
+                    return dump_data;
+                }
+
+                pos_t size() const noexcept
+                {
+                    return size_;
+                }
+
+            private:
+                byte_t* block_;
+                pos_t capacity_;
+                pos_t size_;
+        };
+
+        inline pos_t _GetBinarySize(const byte_t* binary) noexcept
+        {
+            return *reinterpret_cast<const pos_t*>(binary);
+        }
+
+        inline void _DeleteBinary(byte_t* binary) noexcept
+        {
+            if (binary != nullptr) {
+                std::free(binary);
+            }
+        }
+
+        // V2 Binary Structure: [magic "CUJB"][version][byte_order][reserved][binary_size][root_offset][value]...
+        // Value: [type][data], offsets are 64-bit and relative to the beginning of the binary.
+        //   STRING & key: [size][chars][\0]
+        //   ARRAY: [count][value_offset]...
+        //   OBJECT: [count][[key_offset][value_offset]]... sorted by key, [sorted_index]... in insertion order
+        constexpr char magic[4] = {'C', 'U', 'J', 'B'};
+        constexpr uint16_t version = 2;
+        constexpr uint16_t byteOrder = 0x0102;
+        constexpr size_t headerSize = 32;
+        // Element counts read from a binary reserve at most this many slots up front, 
+        // corrupted counts must not reserve memory the data does not back.
+        constexpr size_t reserveLimit = 64;
+
+        inline bool _IsBinaryV2(const void* binary, size_t size) noexcept
+        {
+            return (size >= headerSize && std::memcmp(binary, magic, sizeof(magic)) == 0);
+        }
+
+        class _Binary_Encoder
+        {
+            public:
+                _Binary_Encoder(std::string &binary) : binary_(binary) { }
+
+                template <typename _Ty>
+                void encode(const _Ty &value)
+                {
+                    auto begin = binary_.size();
+                    binary_.append(headerSize, '\0');
+                    auto root = put(value);
+                    auto size = static_cast<uint64_t>(binary_.size() - begin);
+                    auto header = binary_.data() + begin;
+                    std::memcpy(header, magic, sizeof(magic));
+                    std::memcpy((header + 4), std::addressof(version), sizeof(version));
+                    std::memcpy((header + 6), std::addressof(byteOrder), sizeof(byteOrder));
+                    std::memcpy((header + 16), std::addressof(size), sizeof(size));
+                    std::memcpy((header + 24), std::addressof(root), sizeof(root));
+                }
+
+                uint64_t put(const JSONItem &item)
+                {
+                    switch (item.type_) {
+                        case JSONItem::ItemType::BOOLEAN:
+                            return putScalar_(item.type_, static_cast<uint8_t>(std::get<bool>(item.value_)));
+                        case JSONItem::ItemType::INTEGER:
+                            return putScalar_(item.type_, static_cast<int32_t>(std::get<int>(item.value_)));
+                        case JSONItem::ItemType::LONG:
+                            return putScalar_(item.type_, std::get<int64_t>(item.value_));
+                        case JSONItem::ItemType::DOUBLE:
+                            return putScalar_(item.type_, std::get<double>(item.value_));
+                        case JSONItem::ItemType::STRING:
+                            return putString_(item.type_, std::get<std::string>(item.value_));
+                        case JSONItem::ItemType::ARRAY:
+                            return put(*(std::get<JSONArray*>(item.value_)));
+                        case JSONItem::ItemType::OBJECT:
+                            return put(*(std::get<JSONObject*>(item.value_)));
+                        default:
+                            break;
+                    }
+                    auto offset = tell_();
+                    binary_.push_back(static_cast<char>(JSONItem::ItemType::ITEM_NULL));
+                    return offset;
+                }
+
+                uint64_t put(const JSONArray &array)
+                {
+                    std::vector<uint64_t> offsets{};
+                    offsets.reserve(array.size());
+                    for (const auto &item : array) {
+                        offsets.emplace_back(put(item));
+                    }
+                    auto offset = tell_();
+                    binary_.push_back(static_cast<char>(JSONItem::ItemType::ARRAY));
+                    putValue_(static_cast<uint64_t>(offsets.size()));
+                    binary_.append(reinterpret_cast<const char*>(offsets.data()), (offsets.size() * sizeof(uint64_t)));
+                    return offset;
+                }
+
+                uint64_t put(const JSONObject &object)
+                {
+                    struct Entry
+                    {
+                        std::string_view key;
+                        uint64_t keyOffset;
+                        uint64_t valueOffset;
+                    };
+
+                    std::vector<Entry> entries{};
+                    entries.reserve(object.size());
+                    for (const auto &[key, value] : object) {
+                        auto keyOffset = tell_();
+                        putValue_(static_cast<uint64_t>(key.size()));
+                        binary_.append(key.data(), key.size());
+                        binary_.push_back('\0');
+                        auto valueOffset = put(value);
+                        entries.push_back({key, keyOffset, valueOffset});
+                    }
+                    std::vector<size_t> sorted(entries.size(), 0);
+                    for (size_t idx = 0; idx < sorted.size(); idx++) {
+                        sorted[idx] = idx;
+                    }
+                    std::stable_sort(sorted.begin(), sorted.end(), [&entries](size_t lhs, size_t rhs) {
+                        return (entries[lhs].key < entries[rhs].key);
+                    });
+                    // A key repeated in the order only keeps its first position.
+                    sorted.erase(std::unique(sorted.begin(), sorted.end(), [&entries](size_t lhs, size_t rhs) {
+                        return (entries[lhs].key == entries[rhs].key);
+                    }), sorted.end());
+                    auto count = sorted.size();
+                    std::vector<uint64_t> table(count * 3, 0);
+                    for (size_t idx = 0; idx < count; idx++) {
+                        const auto &entry = entries[sorted[idx]];
+                        table[idx * 2] = entry.keyOffset;
+                        table[idx * 2 + 1] = entry.valueOffset;
+                    }
+                    if (count == entries.size()) {
+                        for (size_t idx = 0; idx < count; idx++) {
+                            table[count * 2 + sorted[idx]] = idx;
+                        }
+                    } else {
+                        std::vector<size_t> positions(sorted);
+                        std::sort(positions.begin(), positions.end());
+                        for (size_t idx = 0; idx < count; idx++) {
+                            auto pos = std::lower_bound(positions.begin(), positions.end(), sorted[idx]) - positions.begin();
+                            table[count * 2 + pos] = idx;
+                        }
+                    }
+                    auto offset = tell_();
+                    binary_.push_back(static_cast<char>(JSONItem::ItemType::OBJECT));
+                    putValue_(static_cast<uint64_t>(count));
+                    binary_.append(reinterpret_cast<const char*>(table.data()), (table.size() * sizeof(uint64_t)));
+                    return offset;
+                }
+
+            private:
+                std::string &binary_;
+
+                uint64_t tell_() const noexcept
+                {
+                    return static_cast<uint64_t>(binary_.size());
+                }
+
+                template <typename _Ty>
+                void putValue_(const _Ty &value)
+                {
+                    binary_.append(reinterpret_cast<const char*>(std::addressof(value)), sizeof(value));
+                }
+
+                template <typename _Ty>
+                uint64_t putScalar_(JSONItem::ItemType type, const _Ty &value)
+                {
+                    auto offset = tell_();
+                    binary_.push_back(static_cast<char>(type));
+                    putValue_(value);
+                    return offset;
+                }
+
+                uint64_t putString_(JSONItem::ItemType type, const std::string &value)
+                {
+                    auto offset = tell_();
+                    binary_.push_back(static_cast<char>(type));
+                    putValue_(static_cast<uint64_t>(value.size()));
+                    binary_.append(value.data(), value.size());
+                    binary_.push_back('\0');
+                    return offset;
+                }
+        };
+
+        // Read-only view of a value inside a V2 binary, which must outlive the view.
+        // Keys are looked up by binary search on the sorted key table, no JSONObject is built.
+        class Item
+        {
+            public:
+                struct JSONPair;
+
+                class const_iterator;
+
+                Item() noexcept : binary_(nullptr), size_(0), offset_(0) { }
+
+                Item(const char* binary, uint64_t size, uint64_t offset) : binary_(binary), size_(size), offset_(offset)
+                {
+                    if (offset_ >= size_) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                }
+
+                Item operator[](std::string_view key) const
+                {
+                    return at(key);
+                }
+
+                Item operator[](size_t pos) const
+                {
+                    return at(pos);
+                }
+
+                bool isNull() const
+                {
+                    return (type() == JSONItem::ItemType::ITEM_NULL);
+                }
+
+                bool isBoolean() const
+                {
+                    return (type() == JSONItem::ItemType::BOOLEAN);
+                }
+
+                bool isInt() const
+                {
+                    return (type() == JSONItem::ItemType::INTEGER);
+                }
+
+                bool isLong() const
+                {
+                    return (type() == JSONItem::ItemType::LONG);
+                }
+
+                bool isDouble() const
+                {
+                    return (type() == JSONItem::ItemType::DOUBLE);
+                }
+
+                bool isString() const
+                {
+                    return (type() == JSONItem::ItemType::STRING);
+                }
+
+                bool isArray() const
+                {
+                    return (type() == JSONItem::ItemType::ARRAY);
+                }
+
+                bool isObject() const
+                {
+                    return (type() == JSONItem::ItemType::OBJECT);
+                }
+
+                bool toBoolean() const
+                {
+                    if (type() != JSONItem::ItemType::BOOLEAN) {
+                        throw JSONExcept("Item is not of boolean type");
+                    }
+                    return (read_<uint8_t>(offset_ + 1) != 0);
+                }
+
+                int toInt() const
+                {
+                    if (type() != JSONItem::ItemType::INTEGER) {
+                        throw JSONExcept("Item is not of int type");
+                    }
+                    return static_cast<int>(read_<int32_t>(offset_ + 1));
+                }
+
+                int64_t toLong() const
+                {
+                    if (type() != JSONItem::ItemType::LONG) {
+                        throw JSONExcept("Item is not of long type");
+                    }
+                    return read_<int64_t>(offset_ + 1);
+                }
+
+                double toDouble() const
+                {
+                    if (type() != JSONItem::ItemType::DOUBLE) {
+                        throw JSONExcept("Item is not of double type");
+                    }
+                    return read_<double>(offset_ + 1);
+                }
+
+                std::string toString() const
+                {
+                    return std::string(toStringView());
+                }
+
+                std::string_view toStringView() const
+                {
+                    if (type() != JSONItem::ItemType::STRING) {
+                        throw JSONExcept("Item is not of string type");
+                    }
+                    return readString_(offset_ + 1);
+                }
+
+                Item at(std::string_view key) const
+                {
+                    auto pos = find_(key);
+                    if (pos == npos_) {
+                        throw JSONExcept("Key not found");
+                    }
+                    return child_(read_<uint64_t>(offset_ + 1 + sizeof(uint64_t) * (pos * 2 + 2)));
+                }
+
+                Item at(size_t pos) const
+                {
+                    if (type() != JSONItem::ItemType::ARRAY) {
+                        throw JSONExcept("Item is not of array type");
+                    }
+                    if (pos >= size()) {
+                        throw JSONExcept("Position out of bounds");
+                    }
+                    return child_(read_<uint64_t>(offset_ + 1 + sizeof(uint64_t) * (pos + 1)));
+                }
+
+                bool contains(std::string_view key) const
+                {
+                    return (find_(key) != npos_);
+                }
+
+                // Key and value of the object member at pos in insertion order.
+                std::pair<std::string_view, Item> member(size_t pos) const
+                {
+                    if (type() != JSONItem::ItemType::OBJECT) {
+                        throw JSONExcept("Item is not of object type");
+                    }
+                    auto count = size();
+                    if (pos >= count) {
+                        throw JSONExcept("Position out of bounds");
+                    }
+                    auto table = offset_ + 1 + sizeof(uint64_t);
+                    auto sorted = read_<uint64_t>(table + sizeof(uint64_t) * (count * 2 + pos));
+                    if (sorted >= count) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    auto key = readString_(read_<uint64_t>(table + sizeof(uint64_t) * (sorted * 2)));
+                    auto value = read_<uint64_t>(table + sizeof(uint64_t) * (sorted * 2 + 1));
+                    return std::make_pair(key, child_(value));
+                }
+
+                size_t size() const
+                {
+                    uint64_t width = 0;
+                    switch (type()) {
+                        case JSONItem::ItemType::STRING:
+                            width = sizeof(char);
+                            break;
+                        case JSONItem::ItemType::ARRAY:
+                            width = sizeof(uint64_t);
+                            break;
+                        case JSONItem::ItemType::OBJECT:
+                            width = sizeof(uint64_t) * 3;
+                            break;
+                        default:
+                            return 0;
+                    }
+                    auto count = read_<uint64_t>(offset_ + 1);
+                    if (count > (size_ - offset_ - 1 - sizeof(uint64_t)) / width) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    return static_cast<size_t>(count);
+                }
+
+                bool empty() const
+                {
+                    return (size() == 0);
+                }
+
+                inline const_iterator begin() const;
+                inline const_iterator end() const;
+
+                JSONItem::ItemType type() const
+                {
+                    if (binary_ == nullptr) {
+                        return JSONItem::ItemType::ITEM_NULL;
+                    }
+                    return static_cast<JSONItem::ItemType>(binary_[offset_]);
+                }
+
+                // Containers are decoded on an explicit stack like the text parsers, so corrupted 
+                // nesting cannot exhaust the call stack. Nesting deeper than the parsers accept is rejected.
+                JSONItem toJSONItem() const
+                {
+                    struct Frame
+                    {
+                        Item container;
+                        bool isObject;
+                        size_t pos;
+                        size_t count;
+                        JSONItem* target;
+                        std::vector<JSONItem> elements;
+                        std::vector<JSONObject::JSONPair> members;
+                    };
+
+                    JSONItem root{};
+                    std::vector<Frame> stack{};
+                    auto item = *this;
+                    auto slot = std::addressof(root);
+                    for (;;) {
+                        auto type = item.type();
+                        if (type == JSONItem::ItemType::ARRAY || type == JSONItem::ItemType::OBJECT) {
+                            if (stack.size() >= _JSON_Parse_Utils::defaultMaxDepth) {
+                                throw JSONExcept("JSON nesting exceeds the maximum depth");
+                            }
+                            stack.emplace_back();
+                            auto &frame = stack.back();
+                            frame.container = item;
+                            frame.isObject = (type == JSONItem::ItemType::OBJECT);
+                            frame.pos = 0;
+                            frame.count = item.size();
+                            frame.target = slot;
+                            auto reserved = std::min(frame.count, reserveLimit);
+                            if (frame.isObject) {
+                                frame.members.reserve(reserved);
+                            } else {
+                                frame.elements.reserve(reserved);
+                            }
+                        } else {
+                            *slot = item.toScalar_();
+                        }
+
+                        for (;;) {
+                            if (stack.empty()) {
+                                return root;
+                            }
+                            auto &frame = stack.back();
+                            if (frame.pos < frame.count) {
+                                if (frame.isObject) {
+                                    auto [key, value] = frame.container.member(frame.pos);
+                                    frame.members.emplace_back();
+                                    auto &member = frame.members.back();
+                                    member.key = JSONKey(key);
+                                    item = value;
+                                    slot = std::addressof(member.value);
+                                } else {
+                                    item = frame.container.at(frame.pos);
+                                    frame.elements.emplace_back();
+                                    slot = std::addressof(frame.elements.back());
+                                }
+                                frame.pos++;
+                                break;
+                            }
+                            if (frame.isObject) {
+                                *frame.target = JSONObject(std::move(frame.members));
+                            } else {
+                                *frame.target = JSONArray(std::move(frame.elements));
+                            }
+                            stack.pop_back();
+                        }
+                    }
+                }
+
+                JSONArray toJSONArray() const
+                {
+                    if (type() != JSONItem::ItemType::ARRAY) {
+                        throw JSONExcept("Item is not of array type");
+                    }
+                    return toJSONItem().takeArray();
+                }
+
+                JSONObject toJSONObject() const
+                {
+                    if (type() != JSONItem::ItemType::OBJECT) {
+                        throw JSONExcept("Item is not of object type");
+                    }
+                    return toJSONItem().takeObject();
+                }
+
+            private:
+                static constexpr size_t npos_ = static_cast<size_t>(-1);
+
+                const char* binary_;
+                uint64_t size_;
+                uint64_t offset_;
+
+                JSONItem toScalar_() const
+                {
+                    switch (type()) {
+                        case JSONItem::ItemType::BOOLEAN:
+                            return JSONItem(toBoolean());
+                        case JSONItem::ItemType::INTEGER:
+                            return JSONItem(toInt());
+                        case JSONItem::ItemType::LONG:
+                            return JSONItem(toLong());
+                        case JSONItem::ItemType::DOUBLE:
+                            return JSONItem(toDouble());
+                        case JSONItem::ItemType::STRING:
+                            return JSONItem(toString());
+                        default:
+                            break;
+                    }
+                    return JSONItem();
+                }
+
+                // Values are always written before their container, which also rules out cycles.
+                Item child_(uint64_t offset) const
+                {
+                    if (offset >= offset_) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    return Item(binary_, size_, offset);
+                }
+
+                template <typename _Ty>
+                _Ty read_(uint64_t pos) const
+                {
+                    if (pos > size_ || sizeof(_Ty) > (size_ - pos)) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    _Ty value{};
+                    std::memcpy(std::addressof(value), (binary_ + pos), sizeof(_Ty));
+                    return value;
+                }
+
+                std::string_view readString_(uint64_t pos) const
+                {
+                    auto len = read_<uint64_t>(pos);
+                    pos += sizeof(uint64_t);
+                    if (len > (size_ - pos)) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    return std::string_view((binary_ + pos), static_cast<size_t>(len));
+                }
+
+                size_t find_(std::string_view key) const
+                {
+                    if (type() != JSONItem::ItemType::OBJECT) {
+                        throw JSONExcept("Item is not of object type");
+                    }
+                    auto table = offset_ + 1 + sizeof(uint64_t);
+                    size_t low = 0, high = size();
+                    while (low < high) {
+                        auto mid = low + (high - low) / 2;
+                        auto midKey = readString_(read_<uint64_t>(table + sizeof(uint64_t) * (mid * 2)));
+                        auto cmp = midKey.compare(key);
+                        if (cmp == 0) {
+                            return mid;
+                        } else if (cmp < 0) {
+                            low = mid + 1;
+                        } else {
+                            high = mid;
+                        }
+                    }
+                    return npos_;
+                }
+        };
+
+        struct Item::JSONPair
+        {
+            std::string_view key;
+            Item value;
+        };
+
+        // Visits array elements or object members in insertion order, keys are empty for arrays.
+        class Item::const_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef JSONPair value_type;
+                typedef ptrdiff_t difference_type;
+                typedef const JSONPair* pointer;
+                typedef JSONPair reference;
+
+                const_iterator(const Item &item, size_t pos) noexcept : item_(item), pos_(pos) { }
+
+                inline JSONPair operator*() const;
+
+                const_iterator &operator++() noexcept
+                {
+                    ++pos_;
+                    return *this;
+                }
+
+                const_iterator operator++(int) noexcept
+                {
+                    auto iter = *this;
+                    ++pos_;
+                    return iter;
+                }
+
+                bool operator==(const const_iterator &other) const noexcept
+                {
+                    return (pos_ == other.pos_);
+                }
+
+                bool operator!=(const const_iterator &other) const noexcept
+                {
+                    return (pos_ != other.pos_);
+                }
+
+            private:
+                Item item_;
+                size_t pos_;
+        };
+
+        inline Item::JSONPair Item::const_iterator::operator*() const
+        {
+            if (item_.type() == JSONItem::ItemType::OBJECT) {
+                auto [key, value] = item_.member(pos_);
+                return {key, value};
+            }
+            return {std::string_view(), item_.at(pos_)};
+        }
+
+        inline Item::const_iterator Item::begin() const
+        {
+            return const_iterator(*this, 0);
+        }
+
+        inline Item::const_iterator Item::end() const
+        {
+            if (type() != JSONItem::ItemType::ARRAY && type() != JSONItem::ItemType::OBJECT) {
+                return const_iterator(*this, 0);
+            }
+            return const_iterator(*this, size());
+        }
+
+        inline std::string ToBinary(const JSONItem &item)
+        {
+            std::string binary{};
+            _Binary_Encoder(binary).encode(item);
+            return binary;
+        }
+
+        inline std::string ToBinary(const JSONArray &array)
+        {
+            std::string binary{};
+            _Binary_Encoder(binary).encode(array);
+            return binary;
+        }
+
+        inline std::string ToBinary(const JSONObject &object)
+        {
+            std::string binary{};
+            _Binary_Encoder(binary).encode(object);
+            return binary;
+        }
+
+        // Checks the V2 header and returns the root value, the binary must outlive the returned Item.
+        inline Item Root(const void* binary, size_t size)
+        {
+            if (binary == nullptr || !_IsBinaryV2(binary, size)) {
+                throw JSONExcept("Invalid binary data");
+            }
+            auto header = reinterpret_cast<const char*>(binary);
+            uint16_t binaryVersion = 0, binaryOrder = 0;
+            uint64_t binarySize = 0, root = 0;
+            std::memcpy(std::addressof(binaryVersion), (header + 4), sizeof(binaryVersion));
+            std::memcpy(std::addressof(binaryOrder), (header + 6), sizeof(binaryOrder));
+            std::memcpy(std::addressof(binarySize), (header + 16), sizeof(binarySize));
+            std::memcpy(std::addressof(root), (header + 24), sizeof(root));
+            if (binaryVersion != version) {
+                throw JSONExcept("Unsupported binary version");
+            }
+            if (binaryOrder != byteOrder) {
+                throw JSONExcept("Unsupported binary byte order");
+            }
+            if (binarySize > size || root < headerSize) {
+                throw JSONExcept("Invalid binary data");
+            }
+            return Item(header, binarySize, root);
+        }
+
+        // Compressed Binary Structure: [magic "CUJZ"][version][raw_size][[raw_size][packed_size][block]]...
+        // The raw stream holds a dictionary of every key once, then the root value as [tag][data] with 
+        // varint lengths and zigzag varint integers. Blocks are LZ compressed, or stored when that doesn't help.
+        constexpr char compressedMagic[4] = {'C', 'U', 'J', 'Z'};
+        constexpr uint8_t compressedVersion = 1;
+        constexpr size_t compressedBlockSize = 1024 * 1024;
+
+        // 0 only stores the compact stream, 1 is the fastest compression and 9 the smallest output.
+        constexpr int defaultLevel = 3;
+        constexpr int maxLevel = 9;
+
+        enum class _Compact_Tag : uint8_t {ITEM_NULL, BOOL_FALSE, BOOL_TRUE, INTEGER, LONG, DOUBLE, STRING, ARRAY, OBJECT};
+
+        inline bool _IsCompressedBinary(const void* binary, size_t size) noexcept
+        {
+            return (size > sizeof(compressedMagic) && std::memcmp(binary, compressedMagic, sizeof(compressedMagic)) == 0);
+        }
+
+        inline void _PutVarint(std::string &stream, uint64_t value)
+        {
+            char buffer[10]{};
+            size_t len = 0;
+            while (value >= 0x80) {
+                buffer[len++] = static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            buffer[len++] = static_cast<char>(value);
+            stream.append(buffer, len);
+        }
+
+        inline uint64_t _GetVarint(const char* &ptr, const char* end)
+        {
+            uint64_t value = 0;
+            for (uint32_t shift = 0; shift < 64; shift += 7) {
+                if (ptr == end) {
+                    break;
+                }
+                auto byte = static_cast<uint8_t>(*(ptr++));
+                value |= (static_cast<uint64_t>(byte & 0x7F) << shift);
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            throw JSONExcept("Invalid binary data");
+        }
+
+        class _Compact_Encoder
+        {
+            public:
+                _Compact_Encoder(std::string &stream) : stream_(stream), keys_(), keyOrder_() { }
+
+                template <typename _Ty>
+                void encode(const _Ty &value)
+                {
+                    collect_(value);
+                    _PutVarint(stream_, keyOrder_.size());
+                    for (const auto &key : keyOrder_) {
+                        _PutVarint(stream_, key.size());
+                        stream_.append(key.data(), key.size());
+                    }
+                    put_(value);
+                }
+
+            private:
+                std::string &stream_;
+                std::unordered_map<std::string_view, uint64_t> keys_;
+                std::vector<std::string_view> keyOrder_;
+
+                void collect_(const JSONItem &item)
+                {
+                    if (item.type_ == JSONItem::ItemType::ARRAY) {
+                        collect_(*(std::get<JSONArray*>(item.value_)));
+                    } else if (item.type_ == JSONItem::ItemType::OBJECT) {
+                        collect_(*(std::get<JSONObject*>(item.value_)));
+                    }
+                }
+
+                void collect_(const JSONArray &array)
+                {
+                    for (const auto &item : array) {
+                        collect_(item);
+                    }
+                }
+
+                void collect_(const JSONObject &object)
+                {
+                    for (const auto &[key, value] : object) {
+                        if (keys_.emplace(key, keyOrder_.size()).second) {
+                            keyOrder_.emplace_back(key);
+                        }
+                        collect_(value);
+                    }
+                }
+
+                void putTag_(_Compact_Tag tag)
+                {
+                    stream_.push_back(static_cast<char>(tag));
+                }
+
+                void putInteger_(_Compact_Tag tag, int64_t value)
+                {
+                    putTag_(tag);
+                    _PutVarint(stream_, ((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)));
+                }
+
+                void put_(const JSONItem &item)
+                {
+                    switch (item.type_) {
+                        case JSONItem::ItemType::BOOLEAN:
+                            putTag_(std::get<bool>(item.value_) ? _Compact_Tag::BOOL_TRUE : _Compact_Tag::BOOL_FALSE);
+                            break;
+                        case JSONItem::ItemType::INTEGER:
+                            putInteger_(_Compact_Tag::INTEGER, std::get<int>(item.value_));
+                            break;
+                        case JSONItem::ItemType::LONG:
+                            putInteger_(_Compact_Tag::LONG, std::get<int64_t>(item.value_));
+                            break;
+                        case JSONItem::ItemType::DOUBLE:
+                            {
+                                auto value = std::get<double>(item.value_);
+                                putTag_(_Compact_Tag::DOUBLE);
+                                stream_.append(reinterpret_cast<const char*>(std::addressof(value)), sizeof(value));
+                            }
+                            break;
+                        case JSONItem::ItemType::STRING:
+                            {
+                                const auto &value = std::get<std::string>(item.value_);
+                                putTag_(_Compact_Tag::STRING);
+                                _PutVarint(stream_, value.size());
+                                stream_.append(value);
+                            }
+                            break;
+                        case JSONItem::ItemType::ARRAY:
+                            put_(*(std::get<JSONArray*>(item.value_)));
+                            break;
+                        case JSONItem::ItemType::OBJECT:
+                            put_(*(std::get<JSONObject*>(item.value_)));
+                            break;
+                        default:
+                            putTag_(_Compact_Tag::ITEM_NULL);
+                            break;
+                    }
+                }
+
+                void put_(const JSONArray &array)
+                {
+                    putTag_(_Compact_Tag::ARRAY);
+                    _PutVarint(stream_, array.size());
+                    for (const auto &item : array) {
+                        put_(item);
+                    }
+                }
+
+                void put_(const JSONObject &object)
+                {
+                    putTag_(_Compact_Tag::OBJECT);
+                    _PutVarint(stream_, object.size());
+                    for (const auto &[key, value] : object) {
+                        _PutVarint(stream_, keys_.at(key));
+                        put_(value);
+                    }
+                }
+        };
+
+        class _Compact_Decoder
+        {
+            public:
+                _Compact_Decoder(std::string_view stream) : 
+                    ptr_(stream.data()), 
+                    end_(stream.data() + stream.size()), 
+                    keys_() 
+                { }
+
+                JSONItem decodeItem()
+                {
+                    getKeys_();
+                    auto item = get_(getTag_());
+                    checkEnd_();
+                    return item;
+                }
+
+                JSONArray decodeArray()
+                {
+                    getKeys_();
+                    if (getTag_() != _Compact_Tag::ARRAY) {
+                        throw JSONExcept("Item is not of array type");
+                    }
+                    auto array = get_(_Compact_Tag::ARRAY).takeArray();
+                    checkEnd_();
+                    return array;
+                }
+
+                JSONObject decodeObject()
+                {
+                    getKeys_();
+                    if (getTag_() != _Compact_Tag::OBJECT) {
+                        throw JSONExcept("Item is not of object type");
+                    }
+                    auto object = get_(_Compact_Tag::OBJECT).takeObject();
+                    checkEnd_();
+                    return object;
+                }
+
+            private:
+                const char* ptr_;
+                const char* end_;
+                std::vector<JSONKey> keys_;
+
+                uint64_t getSize_()
+                {
+                    auto size = _GetVarint(ptr_, end_);
+                    if (size > static_cast<uint64_t>(end_ - ptr_)) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    return size;
+                }
+
+                void getKeys_()
+                {
+                    auto count = getSize_();
+                    keys_.reserve(count);
+                    for (uint64_t idx = 0; idx < count; idx++) {
+                        auto len = getSize_();
+                        keys_.emplace_back(std::string_view(ptr_, len));
+                        ptr_ += len;
+                    }
+                }
+
+                void checkEnd_() const
+                {
+                    if (ptr_ != end_) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                }
+
+                _Compact_Tag getTag_()
+                {
+                    if (ptr_ == end_) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    return static_cast<_Compact_Tag>(*(ptr_++));
+                }
+
+                int64_t getInteger_()
+                {
+                    auto value = _GetVarint(ptr_, end_);
+                    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+                }
+
+                // Containers are decoded on an explicit stack like the text parsers, so corrupted 
+                // nesting cannot exhaust the call stack. Nesting deeper than the parsers accept is rejected.
+                JSONItem get_(_Compact_Tag tag)
+                {
+                    struct Frame
+                    {
+                        bool isObject;
+                        uint64_t remaining;
+                        JSONItem* target;
+                        std::vector<JSONItem> elements;
+                        std::vector<JSONObject::JSONPair> members;
+                    };
+
+                    JSONItem root{};
+                    std::vector<Frame> stack{};
+                    auto slot = std::addressof(root);
+                    for (;;) {
+                        if (tag == _Compact_Tag::ARRAY || tag == _Compact_Tag::OBJECT) {
+                            if (stack.size() >= _JSON_Parse_Utils::defaultMaxDepth) {
+                                throw JSONExcept("JSON nesting exceeds the maximum depth");
+                            }
+                            stack.emplace_back();
+                            auto &frame = stack.back();
+                            frame.isObject = (tag == _Compact_Tag::OBJECT);
+                            // Every element takes at least one byte.
+                            frame.remaining = getSize_();
+                            frame.target = slot;
+                            auto reserved = std::min(frame.remaining, static_cast<uint64_t>(reserveLimit));
+                            if (frame.isObject) {
+                                frame.members.reserve(reserved);
+                            } else {
+                                frame.elements.reserve(reserved);
+                            }
+                        } else {
+                            *slot = getScalar_(tag);
+                        }
+
+                        for (;;) {
+                            if (stack.empty()) {
+                                return root;
+                            }
+                            auto &frame = stack.back();
+                            if (frame.remaining != 0) {
+                                frame.remaining--;
+                                if (frame.isObject) {
+                                    auto keyId = _GetVarint(ptr_, end_);
+                                    if (keyId >= keys_.size()) {
+                                        throw JSONExcept("Invalid binary data");
+                                    }
+                                    frame.members.emplace_back();
+                                    auto &member = frame.members.back();
+                                    member.key = keys_[keyId];
+                                    slot = std::addressof(member.value);
+                                } else {
+                                    frame.elements.emplace_back();
+                                    slot = std::addressof(frame.elements.back());
+                                }
+                                break;
+                            }
+                            if (frame.isObject) {
+                                *frame.target = JSONObject(std::move(frame.members));
+                            } else {
+                                *frame.target = JSONArray(std::move(frame.elements));
+                            }
+                            stack.pop_back();
+                        }
+                        tag = getTag_();
+                    }
+                }
+
+                JSONItem getScalar_(_Compact_Tag tag)
+                {
+                    switch (tag) {
+                        case _Compact_Tag::ITEM_NULL:
+                            return JSONItem();
+                        case _Compact_Tag::BOOL_FALSE:
+                            return JSONItem(false);
+                        case _Compact_Tag::BOOL_TRUE:
+                            return JSONItem(true);
+                        case _Compact_Tag::INTEGER:
+                            return JSONItem(static_cast<int>(getInteger_()));
+                        case _Compact_Tag::LONG:
+                            return JSONItem(getInteger_());
+                        case _Compact_Tag::DOUBLE:
+                            {
+                                double value = 0.0;
+                                if (static_cast<size_t>(end_ - ptr_) < sizeof(value)) {
+                                    throw JSONExcept("Invalid binary data");
+                                }
+                                std::memcpy(std::addressof(value), ptr_, sizeof(value));
+                                ptr_ += sizeof(value);
+                                return JSONItem(value);
+                            }
+                        case _Compact_Tag::STRING:
+                            {
+                                auto len = getSize_();
+                                std::string value(ptr_, len);
+                                ptr_ += len;
+                                return JSONItem(std::move(value));
+                            }
+                        default:
+                            break;
+                    }
+                    throw JSONExcept("Invalid binary data");
+                }
+        };
+
+        // Block Structure: [token][literal_len]...[literals][offset][match_len]..., the token holds 4 bits of 
+        // literal length and 4 bits of match length, longer lengths continue in bytes of 255.
+        // The last sequence of a block only carries literals.
+        inline void _CompressBlock(const char* src, size_t size, std::string &dst, int level)
+        {
+            static constexpr size_t minMatch = 4;
+            static constexpr uint32_t hashBits = 16;
+            static constexpr uint32_t noPos = static_cast<uint32_t>(-1);
+
+            static const auto load32 = [](const char* ptr) -> uint32_t {
+                uint32_t value = 0;
+                std::memcpy(std::addressof(value), ptr, sizeof(value));
+                return value;
+            };
+
+            static const auto putLength = [](std::string &dst, size_t len) {
+                while (len >= 255) {
+                    dst.push_back(static_cast<char>(255));
+                    len -= 255;
+                }
+                dst.push_back(static_cast<char>(len));
+            };
+
+            static const auto putSequence = 
+                [](std::string &dst, const char* literals, size_t literalLen, size_t offset, size_t matchLen) 
+            {
+                auto token = static_cast<uint8_t>(std::min<size_t>(literalLen, 15) << 4);
+                if (matchLen > 0) {
+                    token |= static_cast<uint8_t>(std::min<size_t>((matchLen - minMatch), 15));
+                }
+                dst.push_back(static_cast<char>(token));
+                if (literalLen >= 15) {
+                    putLength(dst, (literalLen - 15));
+                }
+                dst.append(literals, literalLen);
+                if (matchLen > 0) {
+                    _PutVarint(dst, offset);
+                    if ((matchLen - minMatch) >= 15) {
+                        putLength(dst, (matchLen - minMatch - 15));
+                    }
+                }
+            };
+
+            auto maxChain = static_cast<size_t>(1) << (std::min(level, maxLevel) - 1);
+            std::vector<uint32_t> head(static_cast<size_t>(1) << hashBits, noPos);
+            std::vector<uint32_t> prev{};
+            if (maxChain > 1) {
+                prev.resize(size, noPos);
+            }
+            auto insert = [&](size_t pos) -> uint32_t {
+                auto hash = (load32(src + pos) * 2654435761U) >> (32 - hashBits);
+                auto cand = head[hash];
+                if (!prev.empty()) {
+                    prev[pos] = cand;
+                }
+                head[hash] = static_cast<uint32_t>(pos);
+                return cand;
+            };
+
+            size_t pos = 0, anchor = 0;
+            while (pos + minMatch <= size) {
+                size_t bestLen = 0, bestPos = 0, chain = maxChain;
+                auto cand = insert(pos);
+                while (cand != noPos && chain-- > 0) {
+                    if (load32(src + cand) == load32(src + pos)) {
+                        auto len = minMatch;
+                        while ((pos + len) < size && src[cand + len] == src[pos + len]) {
+                            len++;
+                        }
+                        if (len > bestLen) {
+                            bestLen = len;
+                            bestPos = cand;
+                        }
+                    }
+                    cand = prev.empty() ? noPos : prev[cand];
+                }
+                if (bestLen < minMatch) {
+                    pos++;
+                    continue;
+                }
+                putSequence(dst, (src + anchor), (pos - anchor), (pos - bestPos), bestLen);
+                if (!prev.empty()) {
+                    auto matchEnd = std::min((pos + bestLen), (size - minMatch + 1));
+                    for (auto matchPos = pos + 1; matchPos < matchEnd; matchPos++) {
+                        insert(matchPos);
+                    }
+                }
+                pos += bestLen;
+                anchor = pos;
+            }
+            putSequence(dst, (src + anchor), (size - anchor), 0, 0);
+        }
+
+        inline void _DecompressBlock(const char* src, size_t size, std::string &dst, size_t rawSize)
+        {
+            static constexpr size_t minMatch = 4;
+
+            static const auto getLength = [](const char* &ptr, const char* end, size_t len) -> size_t {
+                uint8_t byte = 255;
+                while (byte == 255) {
+                    if (ptr == end) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    byte = static_cast<uint8_t>(*(ptr++));
+                    len += byte;
+                }
+                return len;
+            };
+
+            auto blockBegin = dst.size();
+            auto ptr = src, end = src + size;
+            while (ptr < end) {
+                auto token = static_cast<uint8_t>(*(ptr++));
+                size_t literalLen = token >> 4;
+                if (literalLen == 15) {
+                    literalLen = getLength(ptr, end, literalLen);
+                }
+                if (literalLen > static_cast<size_t>(end - ptr) || (dst.size() - blockBegin + literalLen) > rawSize) {
+                    throw JSONExcept("Invalid binary data");
+                }
+                dst.append(ptr, literalLen);
+                ptr += literalLen;
+                if (ptr == end) {
+                    break;
+                }
+                auto offset = _GetVarint(ptr, end);
+                size_t matchLen = (token & 0x0F) + minMatch;
+                if ((token & 0x0F) == 15) {
+                    matchLen = getLength(ptr, end, matchLen);
+                }
+                auto outSize = dst.size() - blockBegin;
+                if (offset == 0 || offset > outSize || (outSize + matchLen) > rawSize) {
+                    throw JSONExcept("Invalid binary data");
+                }
+                // Matches may overlap their own output, so copy forward byte by byte when they do.
+                auto from = dst.size() - offset;
+                if (offset >= matchLen) {
+                    dst.append(dst, from, matchLen);
+                } else {
+                    for (size_t idx = 0; idx < matchLen; idx++) {
+                        dst.push_back(dst[from + idx]);
+                    }
+                }
+            }
+            if ((dst.size() - blockBegin) != rawSize) {
+                throw JSONExcept("Invalid binary data");
+            }
+        }
+
+        inline std::string _Compress(const std::string &stream, int level)
+        {
+            std::string binary{};
+            binary.reserve(stream.size() / 2 + 64);
+            binary.append(compressedMagic, sizeof(compressedMagic));
+            binary.push_back(static_cast<char>(compressedVersion));
+            _PutVarint(binary, stream.size());
+            std::string block{};
+            for (size_t pos = 0; pos < stream.size(); pos += compressedBlockSize) {
+                auto rawSize = std::min(compressedBlockSize, (stream.size() - pos));
+                block.clear();
+                if (level > 0) {
+                    _CompressBlock((stream.data() + pos), rawSize, block, level);
+                }
+                _PutVarint(binary, rawSize);
+                if (level > 0 && block.size() < rawSize) {
+                    _PutVarint(binary, block.size());
+                    binary.append(block);
+                } else {
+                    _PutVarint(binary, rawSize);
+                    binary.append(stream, pos, rawSize);
+                }
+            }
+            return binary;
+        }
+
+        inline std::string _Decompress(const void* binary, size_t size)
+        {
+            if (binary == nullptr || !_IsCompressedBinary(binary, size)) {
+                throw JSONExcept("Invalid binary data");
+            }
+            auto ptr = reinterpret_cast<const char*>(binary) + sizeof(compressedMagic);
+            auto end = reinterpret_cast<const char*>(binary) + size;
+            if (static_cast<uint8_t>(*(ptr++)) != compressedVersion) {
+                throw JSONExcept("Unsupported binary version");
+            }
+            auto streamSize = _GetVarint(ptr, end);
+            std::string stream{};
+            stream.reserve(std::min<uint64_t>(streamSize, (size * 64)));
+            while (stream.size() < streamSize) {
+                auto rawSize = _GetVarint(ptr, end);
+                auto packedSize = _GetVarint(ptr, end);
+                if (rawSize == 0 || rawSize > compressedBlockSize || packedSize > static_cast<uint64_t>(end - ptr)) {
+                    throw JSONExcept("Invalid binary data");
+                }
+                if (packedSize == rawSize) {
+                    stream.append(ptr, rawSize);
+                } else {
+                    _DecompressBlock(ptr, packedSize, stream, rawSize);
+                }
+                ptr += packedSize;
+            }
+            if (stream.size() != streamSize || ptr != end) {
+                throw JSONExcept("Invalid binary data");
+            }
+            return stream;
+        }
+
+        template <typename _Ty>
+        inline std::string _ToCompressedBinary(const _Ty &value, int level)
+        {
+            std::string stream{};
+            _Compact_Encoder(stream).encode(value);
+            return _Compress(stream, level);
+        }
+
+        inline std::string ToCompressedBinary(const JSONItem &item, int level = defaultLevel)
+        {
+            return _ToCompressedBinary(item, level);
+        }
+
+        inline std::string ToCompressedBinary(const JSONArray &array, int level = defaultLevel)
+        {
+            return _ToCompressedBinary(array, level);
+        }
+
+        inline std::string ToCompressedBinary(const JSONObject &object, int level = defaultLevel)
+        {
+            return _ToCompressedBinary(object, level);
+        }
+
+        inline JSONItem FromCompressedBinary(const void* binary, size_t size)
+        {
+            auto stream = _Decompress(binary, size);
+            return _Compact_Decoder(stream).decodeItem();
+        }
+
+        template <typename _Ty>
+        inline void _SaveCompressed(const std::string &path, const _Ty &value, int level)
+        {
+            auto fp = std::fopen(path.c_str(), "wb");
+            if (fp != nullptr) {
+                auto binary = _ToCompressedBinary(value, level);
+                std::fwrite(binary.data(), sizeof(char), binary.size(), fp);
+                std::fflush(fp);
+                std::fclose(fp);
+            }
+        }
+
+        inline void SaveCompressedArray(const std::string &path, const JSONArray &array, int level = defaultLevel)
+        {
+            _SaveCompressed(path, array, level);
+        }
+
+        inline void SaveCompressedObject(const std::string &path, const JSONObject &object, int level = defaultLevel)
+        {
+            _SaveCompressed(path, object, level);
+        }
+
+        inline byte_t* _ObjectToBinary(const JSONObject &object);
+
+        inline CU::JSONObject _BinaryToObject(const byte_t* binary);
+
+        inline byte_t* _ArrayToBinary(const JSONArray &array)
+        {
+            static const auto addBlock = [](_Binary_Container &container, const JSONItem &item) {
+                switch (item.type()) {
+                    case JSONItem::ItemType::ITEM_NULL:
+                        {
+                            auto type = JSONItem::ItemType::ITEM_NULL;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                        }
+                        break;
+                    case JSONItem::ItemType::BOOLEAN:
+                        {
+                            bool data = item;
+                            auto type = JSONItem::ItemType::BOOLEAN;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + sizeof(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(std::addressof(data), sizeof(data));
+                        }
+                        break;
+                    case JSONItem::ItemType::INTEGER:
+                        {
+                            int data = item;
+                            auto type = JSONItem::ItemType::INTEGER;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + sizeof(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(std::addressof(data), sizeof(data));
+                        }
+                        break;
+                    case JSONItem::ItemType::LONG:
+                        {
+                            int64_t data = item;
+                            auto type = JSONItem::ItemType::LONG;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + sizeof(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(std::addressof(data), sizeof(data));
+                        }
+                        break;
+                    case JSONItem::ItemType::DOUBLE:
+                        {
+                            double data = item;
+                            auto type = JSONItem::ItemType::DOUBLE;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + sizeof(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(std::addressof(data), sizeof(data));
+                        }
+                        break;
+                    case JSONItem::ItemType::STRING:
+                        {
+                            std::string data = item;
+                            auto type = JSONItem::ItemType::STRING;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + data.length() + 1;
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(data.data(), (data.length() + 1));
+                        }
+                        break;
+                    case JSONItem::ItemType::ARRAY:
+                        {
+                            auto data = _ArrayToBinary(item.asArray());
+                            auto type = JSONItem::ItemType::ARRAY;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + _GetBinarySize(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(data, _GetBinarySize(data));
+                            _DeleteBinary(data);
+                        }
+                        break;
+                    case JSONItem::ItemType::OBJECT:
+                        {
+                            auto data = _ObjectToBinary(item.asObject());
+                            auto type = JSONItem::ItemType::OBJECT;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + _GetBinarySize(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(data, _GetBinarySize(data));
+                            _DeleteBinary(data);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            };
+
+            // Array Binary Structure: [binary_size][[block_size][type][data]]...[end_block]
+            _Binary_Container container{};
+            {
+                pos_t binary_size = sizeof(pos_t);
+                container.add(std::addressof(binary_size), sizeof(binary_size));
+            }
+            for (const auto &item : array) {
+                addBlock(container, item);
+            }
+            container.add(std::addressof(npos), sizeof(npos));
+            *reinterpret_cast<pos_t*>(container.data()) = container.size();
+            return container.dump();
+        }
+
+        inline CU::JSONArray _BinaryToArray(const byte_t* binary)
+        {
+            static const auto addItem = 
+                [](std::vector<JSONItem> &arrayData, const byte_t* binary, pos_t block_offset) -> pos_t 
+            {
+                auto block_size = *reinterpret_cast<const pos_t*>(_Move_Ptr(binary, block_offset));
+                if (block_size == npos) {
+                    return npos;
+                }
+                auto type = *reinterpret_cast<const JSONItem::ItemType*>(_Move_Ptr(binary, (block_offset + sizeof(block_size))));
+                auto data = _Move_Ptr(binary, (block_offset + sizeof(block_size) + sizeof(type)));
+                switch (type) {
+                    case JSONItem::ItemType::ITEM_NULL:
+                        arrayData.emplace_back(nullptr);
+                        break;
+                    case JSONItem::ItemType::BOOLEAN:
+                        arrayData.emplace_back(*reinterpret_cast<const bool*>(data));
+                        break;
+                    case JSONItem::ItemType::INTEGER:
+                        arrayData.emplace_back(*reinterpret_cast<const int*>(data));
+                        break;
+                    case JSONItem::ItemType::LONG:
+                        arrayData.emplace_back(*reinterpret_cast<const int64_t*>(data));
+                        break;
+                    case JSONItem::ItemType::DOUBLE:
+                        arrayData.emplace_back(*reinterpret_cast<const double*>(data));
+                        break;
+                    case JSONItem::ItemType::STRING:
+                        arrayData.emplace_back(reinterpret_cast<const char*>(data));
+                        break;
+                    case JSONItem::ItemType::ARRAY:
+                        arrayData.emplace_back(_BinaryToArray(reinterpret_cast<const byte_t*>(data)));
+                        break;
+                    case JSONItem::ItemType::OBJECT:
+                        arrayData.emplace_back(_BinaryToObject(reinterpret_cast<const byte_t*>(data)));
+                        break;
+                    default:
+                        break;
+                }
+                return (block_offset + block_size);
+            };
+
+            std::vector<JSONItem> arrayData{};
+            pos_t size = _GetBinarySize(binary), offset = sizeof(pos_t);
+            while (offset < size) {
+                offset = addItem(arrayData, binary, offset);
+            }
+            return JSONArray(std::move(arrayData));
+        }
+
+        inline void SaveArray(const std::string &path, const JSONArray &array)
+        {
+            auto fp = std::fopen(path.c_str(), "wb");
+            if (fp != nullptr) {
+                auto binary = ToBinary(array);
+                std::fwrite(binary.data(), sizeof(char), binary.size(), fp);
+                std::fflush(fp);
+                std::fclose(fp);
+            }
+        }
+
+        // Reads the V2 format, compressed containers and the original length-prefixed format.
+        inline CU::JSONArray OpenArray(const std::string &path)
+        {
+            CU::JSONArray array{};
+            _JSON_Mapped_File file{};
+            if (file.open(path)) {
+                auto binary = file.view();
+                if (_IsBinaryV2(binary.data(), binary.size())) {
+                    array = Root(binary.data(), binary.size()).toJSONArray();
+                } else if (_IsCompressedBinary(binary.data(), binary.size())) {
+                    array = _Compact_Decoder(_Decompress(binary.data(), binary.size())).decodeArray();
+                } else if (binary.size() >= sizeof(pos_t)) {
+                    auto buffer = reinterpret_cast<const byte_t*>(binary.data());
+                    if (_GetBinarySize(buffer) <= binary.size()) {
+                        array = _BinaryToArray(buffer);
+                    }
+                }
+            }
+            return array;
+        }
+
+        inline byte_t* _ObjectToBinary(const JSONObject &object)
+        {
+            static const auto addBlock = [](_Binary_Container &container, const std::string &key, const JSONItem &item) {
+                switch (item.type()) {
+                    case JSONItem::ItemType::ITEM_NULL:
+                        {
+                            auto type = JSONItem::ItemType::ITEM_NULL;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1;
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(key.data(), (key.length() + 1));
+                        }
+                        break;
+                    case JSONItem::ItemType::BOOLEAN:
+                        {
+                            bool data = item;
+                            auto type = JSONItem::ItemType::BOOLEAN;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + sizeof(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(key.data(), (key.length() + 1));
+                            container.add(std::addressof(data), sizeof(data));
+                        }
+                        break;
+                    case JSONItem::ItemType::INTEGER:
+                        {
+                            int data = item;
+                            auto type = JSONItem::ItemType::INTEGER;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + sizeof(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(key.data(), (key.length() + 1));
+                            container.add(std::addressof(data), sizeof(data));
+                        }
+                        break;
+                    case JSONItem::ItemType::LONG:
+                        {
+                            int64_t data = item;
+                            auto type = JSONItem::ItemType::LONG;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + sizeof(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(key.data(), (key.length() + 1));
+                            container.add(std::addressof(data), sizeof(data));
+                        }
+                        break;
+                    case JSONItem::ItemType::DOUBLE:
+                        {
+                            double data = item;
+                            auto type = JSONItem::ItemType::DOUBLE;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + sizeof(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(key.data(), (key.length() + 1));
+                            container.add(std::addressof(data), sizeof(data));
+                        }
+                        break;
+                    case JSONItem::ItemType::STRING:
+                        {
+                            std::string data = item;
+                            auto type = JSONItem::ItemType::STRING;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + data.length() + 1;
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(key.data(), (key.length() + 1));
+                            container.add(data.data(), (data.length() + 1));
+                        }
+                        break;
+                    case JSONItem::ItemType::ARRAY:
+                        {
+                            auto data = _ArrayToBinary(item.asArray());
+                            auto type = JSONItem::ItemType::ARRAY;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + _GetBinarySize(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(key.data(), (key.length() + 1));
+                            container.add(data, _GetBinarySize(data));
+                            _DeleteBinary(data);
+                        }
+                        break;
+                    case JSONItem::ItemType::OBJECT:
+                        {
+                            auto data = _ObjectToBinary(item.asObject());
+                            auto type = JSONItem::ItemType::OBJECT;
+                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + _GetBinarySize(data);
+                            container.add(std::addressof(block_size), sizeof(block_size));
+                            container.add(std::addressof(type), sizeof(type));
+                            container.add(key.data(), (key.length() + 1));
+                            container.add(data, _GetBinarySize(data));
+                            _DeleteBinary(data);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            };
+
+            // Object Binary Structure: [binary_size][[block_size][type][key][data]]...[end_block]
+            _Binary_Container container{};
+            {
+                pos_t binary_size = sizeof(pos_t);
+                container.add(std::addressof(binary_size), sizeof(binary_size));
+            }
+            for (const auto &[key, value] : object) {
+                addBlock(container, key, value);
+            }
+            container.add(std::addressof(npos), sizeof(npos));
+            *reinterpret_cast<pos_t*>(container.data()) = container.size();
+            return container.dump();
+        }
+
+        inline CU::JSONObject _BinaryToObject(const byte_t* binary)
+        {
+            static const auto addItem = [](
+                std::vector<JSONObject::JSONPair> &members,
+                const byte_t* binary, 
+                pos_t block_offset
+            ) -> pos_t {
+                auto block_size = *reinterpret_cast<const pos_t*>(_Move_Ptr(binary, block_offset));
+                if (block_size == npos) {
+                    return npos;
+                }
+                auto type = *reinterpret_cast<const JSONItem::ItemType*>(_Move_Ptr(binary, (block_offset + sizeof(block_size))));
+                auto key = reinterpret_cast<const char*>(_Move_Ptr(binary, (block_offset + sizeof(block_size) + sizeof(type))));
+                auto key_size = std::strlen(key) + 1;
+                auto data = _Move_Ptr(binary, (block_offset + sizeof(block_size) + sizeof(type) + key_size));
+                switch (type) {
+                    case JSONItem::ItemType::ITEM_NULL:
+                        members.push_back({JSONKey(key), nullptr});
+                        break;
+                    case JSONItem::ItemType::BOOLEAN:
+                        members.push_back({JSONKey(key), *reinterpret_cast<const bool*>(data)});
+                        break;
+                    case JSONItem::ItemType::INTEGER:
+                        members.push_back({JSONKey(key), *reinterpret_cast<const int*>(data)});
+                        break;
+                    case JSONItem::ItemType::LONG:
+                        members.push_back({JSONKey(key), *reinterpret_cast<const int64_t*>(data)});
+                        break;
+                    case JSONItem::ItemType::DOUBLE:
+                        members.push_back({JSONKey(key), *reinterpret_cast<const double*>(data)});
+                        break;
+                    case JSONItem::ItemType::STRING:
+                        members.push_back({JSONKey(key), reinterpret_cast<const char*>(data)});
+                        break;
+                    case JSONItem::ItemType::ARRAY:
+                        members.push_back({JSONKey(key), _BinaryToArray(reinterpret_cast<const byte_t*>(data))});
+                        break;
+                    case JSONItem::ItemType::OBJECT:
+                        members.push_back({JSONKey(key), _BinaryToObject(reinterpret_cast<const byte_t*>(data))});
+                        break;
+                    default:
+                        break;
+                }
+                return (block_offset + block_size);
+            };
+
+            std::vector<JSONObject::JSONPair> members{};
+            pos_t size = _GetBinarySize(binary), offset = sizeof(pos_t);
+            while (offset < size) {
+                offset = addItem(members, binary, offset);
+            }
+            return JSONObject(std::move(members));
+        }
+
+        inline void SaveObject(const std::string &path, const JSONObject &object)
+        {
+            auto fp = std::fopen(path.c_str(), "wb");
+            if (fp != nullptr) {
+                auto binary = ToBinary(object);
+                std::fwrite(binary.data(), sizeof(char), binary.size(), fp);
+                std::fflush(fp);
+                std::fclose(fp);
+            }
+        }
+
+        // Reads the V2 format, compressed containers and the original length-prefixed format.
+        inline CU::JSONObject OpenObject(const std::string &path)
+        {
+            CU::JSONObject object{};
+            _JSON_Mapped_File file{};
+            if (file.open(path)) {
+                auto binary = file.view();
+                if (_IsBinaryV2(binary.data(), binary.size())) {
+                    object = Root(binary.data(), binary.size()).toJSONObject();
+                } else if (_IsCompressedBinary(binary.data(), binary.size())) {
+                    object = _Compact_Decoder(_Decompress(binary.data(), binary.size())).decodeObject();
+                } else if (binary.size() >= sizeof(pos_t)) {
+                    auto buffer = reinterpret_cast<const byte_t*>(binary.data());
+                    if (_GetBinarySize(buffer) <= binary.size()) {
+                        object = _BinaryToObject(buffer);
+                    }
+                }
+            }
+            return object;
+        }
+    }
+
+    // Read-only access to a JSONBinary v2 file mapped into memory, values are read straight from the 
+    // mapped pages and no JSONObject is built. Items taken from the view are valid until it is closed.
+    class JSONBinaryView
+    {
+        public:
+            inline JSONBinaryView();
+            inline JSONBinaryView(const std::string &path);
+            inline JSONBinaryView(JSONBinaryView &&other) noexcept;
+
+            JSONBinaryView(const JSONBinaryView &other) = delete;
+            JSONBinaryView &operator=(const JSONBinaryView &other) = delete;
+
+            inline JSONBinary::Item operator[](std::string_view key) const;
+            inline JSONBinary::Item operator[](size_t pos) const;
+
+            inline void open(const std::string &path);
+            inline void close();
+            inline bool isOpen() const;
+
+            inline JSONBinary::Item at(std::string_view key) const;
+            inline JSONBinary::Item at(size_t pos) const;
+            inline bool contains(std::string_view key) const;
+            inline size_t size() const;
+            inline bool empty() const;
+            inline JSONItem::ItemType type() const;
+            inline JSONBinary::Item root() const;
+
+            inline JSONBinary::Item::const_iterator begin() const;
+            inline JSONBinary::Item::const_iterator end() const;
+
+        private:
+            _JSON_Mapped_File file_;
+            JSONBinary::Item root_;
+    };
+
+    inline JSONBinaryView::JSONBinaryView() : file_(), root_() { }
+
+    inline JSONBinaryView::JSONBinaryView(const std::string &path) : file_(), root_()
+    {
+        open(path);
+    }
+
+    inline JSONBinaryView::JSONBinaryView(JSONBinaryView &&other) noexcept : 
+        file_(std::move(other.file_)), 
+        root_(other.root_)
+    {
+        other.root_ = JSONBinary::Item();
+    }
+
+    inline JSONBinary::Item JSONBinaryView::operator[](std::string_view key) const
+    {
+        return root_.at(key);
+    }
+
+    inline JSONBinary::Item JSONBinaryView::operator[](size_t pos) const
+    {
+        return root_.at(pos);
+    }
+
+    inline void JSONBinaryView::open(const std::string &path)
+    {
+        close();
+        if (!file_.open(path, false)) {
+            throw JSONExcept("Failed to open file");
+        }
+        auto binary = file_.view();
+        try {
+            root_ = JSONBinary::Root(binary.data(), binary.size());
+        } catch (...) {
+            file_.close();
+            throw;
+        }
+    }
+
+    inline void JSONBinaryView::close()
+    {
+        root_ = JSONBinary::Item();
+        file_.close();
+    }
+
+    inline bool JSONBinaryView::isOpen() const
+    {
+        return !file_.view().empty();
+    }
+
+    inline JSONBinary::Item JSONBinaryView::at(std::string_view key) const
+    {
+        return root_.at(key);
+    }
+
+    inline JSONBinary::Item JSONBinaryView::at(size_t pos) const
+    {
+        return root_.at(pos);
+    }
+
+    inline bool JSONBinaryView::contains(std::string_view key) const
+    {
+        return root_.contains(key);
+    }
+
+    inline size_t JSONBinaryView::size() const
+    {
+        return root_.size();
+    }
+
+    inline bool JSONBinaryView::empty() const
+    {
+        return root_.empty();
+    }
+
+    inline JSONItem::ItemType JSONBinaryView::type() const
+    {
+        return root_.type();
+    }
+
+    inline JSONBinary::Item JSONBinaryView::root() const
+    {
+        return root_;
+    }
+
+    inline JSONBinary::Item::const_iterator JSONBinaryView::begin() const
+    {
+        return root_.begin();
+    }
+
+    inline JSONBinary::Item::const_iterator JSONBinaryView::end() const
+    {
+        return root_.end();
+    }
+
+    // Keeps a JSONObject persisted as a snapshot followed by an append-only log of set/remove records, 
+    // so saving a change only writes the change. Records are buffered until flush(), opening the file 
+    // replays them and compact() rewrites it as a single snapshot.
+    // Journal Structure: [magic "CUJL"][version][[payload_size][checksum][type][payload]]...
+    class JSONPath::DomNode_
+    {
+        public:
+            DomNode_() noexcept : item_(nullptr), array_(nullptr), object_(nullptr) { }
+
+            DomNode_(const JSONItem &item) : item_(std::addressof(item)), array_(nullptr), object_(nullptr)
+            {
+                if (item.isArray()) {
+                    array_ = std::addressof(item.asArray());
+                } else if (item.isObject()) {
+                    object_ = std::addressof(item.asObject());
+                }
+            }
+
+            DomNode_(const JSONArray &array) noexcept : item_(nullptr), array_(std::addressof(array)), object_(nullptr) { }
+
+            DomNode_(const JSONObject &object) noexcept : item_(nullptr), array_(nullptr), object_(std::addressof(object)) { }
+
+            size_t size() const
+            {
+                if (array_ != nullptr) {
+                    return array_->size();
+                } else if (object_ != nullptr) {
+                    return object_->size();
+                }
+                return 0;
+            }
+
+            DomNode_ at(size_t pos) const
+            {
+                if (array_ != nullptr) {
+                    return DomNode_(array_->data()[pos]);
+                }
+                return DomNode_(object_->members()[pos].value);
+            }
+
+            bool child(const Segment &segment, DomNode_ &node) const
+            {
+                if (object_ != nullptr) {
+                    auto value = object_->find(segment.key);
+                    if (value != nullptr) {
+                        node = DomNode_(*value);
+                        return true;
+                    }
+                } else if (array_ != nullptr && segment.index < array_->size()) {
+                    node = DomNode_(array_->data()[segment.index]);
+                    return true;
+                }
+                return false;
+            }
+
+            // Only the root passed as a JSONArray or JSONObject has no item.
+            const JSONItem* item() const noexcept
+            {
+                return item_;
+            }
+
+            const JSONItem &value() const
+            {
+                static const JSONItem nullItem{};
+                return (item_ != nullptr) ? *item_ : nullItem;
+            }
+
+        private:
+            const JSONItem* item_;
+            const JSONArray* array_;
+            const JSONObject* object_;
+    };
+
+    class JSONPath::BinaryNode_
+    {
+        public:
+            BinaryNode_() noexcept : item_() { }
+
+            BinaryNode_(const JSONBinary::Item &item) noexcept : item_(item) { }
+
+            size_t size() const
+            {
+                if (item_.isArray() || item_.isObject()) {
+                    return item_.size();
+                }
+                return 0;
+            }
+
+            BinaryNode_ at(size_t pos) const
+            {
+                if (item_.isArray()) {
+                    return BinaryNode_(item_.at(pos));
+                }
+                return BinaryNode_(item_.member(pos).second);
+            }
+
+            bool child(const Segment &segment, BinaryNode_ &node) const
+            {
+                if (item_.isObject()) {
+                    if (item_.contains(segment.key.view())) {
+                        node = BinaryNode_(item_.at(segment.key.view()));
+                        return true;
+                    }
+                } else if (item_.isArray() && segment.index < item_.size()) {
+                    node = BinaryNode_(item_.at(segment.index));
+                    return true;
+                }
+                return false;
+            }
+
+            const JSONBinary::Item &item() const noexcept
+            {
+                return item_;
+            }
+
+            JSONItem value() const
+            {
+                return item_.toJSONItem();
+            }
+
+        private:
+            JSONBinary::Item item_;
+    };
+
+    inline JSONPath::JSONPath() : segments_() { }
+
+    inline JSONPath::JSONPath(std::string_view path) : segments_(Compile_(path)) { }
+
+    inline JSONPath::JSONPath(const char* path) : segments_(Compile_(path)) { }
+
+    inline JSONPath &JSONPath::append(std::string_view key)
+    {
+        segments_.emplace_back(KeySegment_(key));
+        return *this;
+    }
+
+    inline JSONPath &JSONPath::append(size_t pos)
+    {
+        segments_.emplace_back(KeySegment_(std::to_string(pos)));
+        return *this;
+    }
+
+    inline JSONPath &JSONPath::appendWildcard()
+    {
+        segments_.push_back({SegmentType::WILDCARD, JSONKey(), npos, FilterOp::EXISTS, {}, JSONItem()});
+        return *this;
+    }
+
+    inline const JSONItem* JSONPath::get(const JSONItem &root) const
+    {
+        return getItem_(DomNode_(root));
+    }
+
+    inline const JSONItem* JSONPath::get(const JSONArray &root) const
+    {
+        checkContainerRoot_();
+        return getItem_(DomNode_(root));
+    }
+
+    inline const JSONItem* JSONPath::get(const JSONObject &root) const
+    {
+        checkContainerRoot_();
+        return getItem_(DomNode_(root));
+    }
+
+    inline std::optional<JSONBinary::Item> JSONPath::get(const JSONBinary::Item &root) const
+    {
+        std::optional<JSONBinary::Item> result{};
+        auto visitor = [&result](const BinaryNode_ &node) -> bool {
+            result = node.item();
+            return false;
+        };
+        Walk_(segments_.data(), (segments_.data() + segments_.size()), BinaryNode_(root), visitor);
+        return result;
+    }
+
+    inline std::vector<const JSONItem*> JSONPath::select(const JSONItem &root) const
+    {
+        return selectItems_(DomNode_(root));
+    }
+
+    inline std::vector<const JSONItem*> JSONPath::select(const JSONArray &root) const
+    {
+        checkContainerRoot_();
+        return selectItems_(DomNode_(root));
+    }
+
+    inline std::vector<const JSONItem*> JSONPath::select(const JSONObject &root) const
+    {
+        checkContainerRoot_();
+        return selectItems_(DomNode_(root));
+    }
+
+    inline std::vector<JSONBinary::Item> JSONPath::select(const JSONBinary::Item &root) const
+    {
+        std::vector<JSONBinary::Item> results{};
+        auto visitor = [&results](const BinaryNode_ &node) -> bool {
+            results.emplace_back(node.item());
+            return true;
+        };
+        Walk_(segments_.data(), (segments_.data() + segments_.size()), BinaryNode_(root), visitor);
+        return results;
+    }
+
+    inline void JSONPath::checkContainerRoot_() const
+    {
+        if (segments_.empty()) {
+            throw JSONExcept("Empty JSON path on a JSONArray or JSONObject root");
+        }
+    }
+
+    inline const JSONItem* JSONPath::getItem_(const DomNode_ &root) const
+    {
+        const JSONItem* result = nullptr;
+        auto visitor = [&result](const DomNode_ &node) -> bool {
+            result = node.item();
+            return false;
+        };
+        Walk_(segments_.data(), (segments_.data() + segments_.size()), root, visitor);
+        return result;
+    }
+
+    inline std::vector<const JSONItem*> JSONPath::selectItems_(const DomNode_ &root) const
+    {
+        std::vector<const JSONItem*> results{};
+        auto visitor = [&results](const DomNode_ &node) -> bool {
+            results.emplace_back(node.item());
+            return true;
+        };
+        Walk_(segments_.data(), (segments_.data() + segments_.size()), root, visitor);
+        return results;
+    }
+
+    inline bool JSONPath::isSingular() const
+    {
+        for (const auto &segment : segments_) {
+            if (segment.type != SegmentType::KEY) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline bool JSONPath::empty() const
+    {
+        return segments_.empty();
+    }
+
+    inline size_t JSONPath::size() const
+    {
+        return segments_.size();
+    }
+
+    inline const std::vector<JSONPath::Segment> &JSONPath::segments() const
+    {
+        return segments_;
+    }
+
+    inline std::string JSONPath::toString() const
+    {
+        std::string text{};
+        Print_(text, segments_);
+        return text;
+    }
+
+    inline std::vector<JSONPath::Segment> JSONPath::Compile_(std::string_view path)
+    {
+        std::vector<Segment> segments{};
+        if (path.empty()) {
+            return segments;
+        }
+        if (path[0] != '/') {
+            throw JSONExcept("Invalid JSON path");
+        }
+        size_t pos = 1;
+        for (;;) {
+            size_t end = pos;
+            if (path.compare(pos, 2, "[?") == 0) {
+                // Skips the filter up to its closing bracket, brackets inside string values do not count.
+                bool inString = false;
+                for (end = pos + 2; end < path.size(); end++) {
+                    if (inString) {
+                        if (path[end] == '\\') {
+                            end++;
+                        } else if (path[end] == '\"') {
+                            inString = false;
+                        }
+                    } else if (path[end] == '\"') {
+                        inString = true;
+                    } else if (path[end] == ']') {
+                        break;
+                    }
+                }
+                if (end >= path.size() || (end + 1 < path.size() && path[end + 1] != '/')) {
+                    throw JSONExcept("Invalid JSON path");
+                }
+                segments.emplace_back(CompileFilter_(path.substr((pos + 2), (end - pos - 2))));
+                end++;
+            } else {
+                end = std::min(path.find('/', pos), path.size());
+                auto token = path.substr(pos, (end - pos));
+                if (token == "*") {
+                    segments.push_back({SegmentType::WILDCARD, JSONKey(), npos, FilterOp::EXISTS, {}, JSONItem()});
+                } else if (token.find('~') == std::string_view::npos) {
+                    segments.emplace_back(KeySegment_(token));
+                } else {
+                    std::string key{};
+                    for (size_t idx = 0; idx < token.size(); idx++) {
+                        if (token[idx] != '~') {
+                            key.push_back(token[idx]);
+                        } else if (idx + 1 < token.size() && (token[idx + 1] == '0' || token[idx + 1] == '1')) {
+                            key.push_back((token[++idx] == '0') ? '~' : '/');
+                        } else {
+                            throw JSONExcept("Invalid JSON path");
+                        }
+                    }
+                    segments.emplace_back(KeySegment_(key));
+                }
+            }
+            if (end >= path.size()) {
+                break;
+            }
+            pos = end + 1;
+        }
+        return segments;
+    }
+
+    inline JSONPath::Segment JSONPath::CompileFilter_(std::string_view filter)
+    {
+        static constexpr std::pair<std::string_view, FilterOp> operators[] = {
+            {"==", FilterOp::EQUAL},
+            {"!=", FilterOp::NOT_EQUAL},
+            {"<=", FilterOp::LESS_EQUAL},
+            {">=", FilterOp::GREATER_EQUAL},
+            {"<", FilterOp::LESS},
+            {">", FilterOp::GREATER}
+        };
+
+        Segment segment{SegmentType::FILTER, JSONKey(), npos, FilterOp::EXISTS, {}, JSONItem()};
+        auto opPos = std::min(filter.find_first_of("=!<>"), filter.size());
+        segment.operand = Compile_(filter.substr(0, opPos));
+        for (const auto &operand : segment.operand) {
+            if (operand.type != SegmentType::KEY) {
+                throw JSONExcept("Invalid JSON path");
+            }
+        }
+        if (opPos == filter.size()) {
+            return segment;
+        }
+
+        auto valuePos = opPos;
+        for (const auto &[text, op] : operators) {
+            if (filter.compare(opPos, text.size(), text) == 0) {
+                segment.op = op;
+                valuePos = opPos + text.size();
+                break;
+            }
+        }
+        if (valuePos == opPos) {
+            throw JSONExcept("Invalid JSON path");
+        }
+
+        // ParseJSONItem expects the text to continue after the item.
+        auto valueText = filter.substr(valuePos);
+        auto beginPos = _JSON_Parse_Utils::IgnoreBlank(valueText, 0);
+        if (beginPos == std::string_view::npos) {
+            throw JSONExcept("Invalid JSON path");
+        }
+        auto endPos = valueText.size();
+        while (endPos > beginPos && _JSON_Parse_Utils::IgnoreBlank(valueText, (endPos - 1)) != (endPos - 1)) {
+            endPos--;
+        }
+        std::string buffer(valueText.substr(beginPos, (endPos - beginPos)));
+        buffer.push_back(' ');
+        auto itemResult = _JSON_Parse_Utils::ParseJSONItem(buffer, 0);
+        if (itemResult.endPos != (endPos - beginPos)) {
+            throw JSONExcept("Invalid JSON path");
+        }
+        segment.value = std::move(itemResult.resultVal);
+        return segment;
+    }
+
+    // Array positions follow RFC 6901, digits without leading zeros.
+    inline JSONPath::Segment JSONPath::KeySegment_(std::string_view key)
+    {
+        Segment segment{SegmentType::KEY, JSONKey(key), npos, FilterOp::EXISTS, {}, JSONItem()};
+        if (!key.empty() && key.size() <= 18 && (key[0] != '0' || key.size() == 1)) {
+            size_t index = 0;
+            for (auto ch : key) {
+                if (ch < '0' || ch > '9') {
+                    return segment;
+                }
+                index = index * 10 + static_cast<size_t>(ch - '0');
+            }
+            segment.index = index;
+        }
+        return segment;
+    }
+
+    // Numbers compare by value whatever their representation, strings compare bytewise, 
+    // anything else is only equal or not equal.
+    inline bool JSONPath::Compare_(const JSONItem &value, FilterOp op, const JSONItem &operand)
+    {
+        static const auto toLong = [](const JSONItem &item, int64_t &number) -> bool {
+            if (item.isInt()) {
+                number = item.toInt();
+            } else if (item.isLong()) {
+                number = item.toLong();
+            } else {
+                return false;
+            }
+            return true;
+        };
+        static const auto toDouble = [](const JSONItem &item, double &number) -> bool {
+            int64_t integer = 0;
+            if (item.isDouble()) {
+                number = item.toDouble();
+            } else if (toLong(item, integer)) {
+                number = static_cast<double>(integer);
+            } else {
+                return false;
+            }
+            return true;
+        };
+
+        int cmp = 0;
+        int64_t lhsLong = 0, rhsLong = 0;
+        double lhsDouble = 0, rhsDouble = 0;
+        if (toLong(value, lhsLong) && toLong(operand, rhsLong)) {
+            cmp = (lhsLong < rhsLong) ? -1 : ((lhsLong > rhsLong) ? 1 : 0);
+        } else if (toDouble(value, lhsDouble) && toDouble(operand, rhsDouble)) {
+            cmp = (lhsDouble < rhsDouble) ? -1 : ((lhsDouble > rhsDouble) ? 1 : 0);
+        } else if (value.isString() && operand.isString()) {
+            cmp = value.asString().compare(operand.asString());
+        } else if (op == FilterOp::EQUAL) {
+            return (value == operand);
+        } else if (op == FilterOp::NOT_EQUAL) {
+            return (value != operand);
+        } else {
+            return false;
+        }
+
+        switch (op) {
+            case FilterOp::EQUAL:
+                return (cmp == 0);
+            case FilterOp::NOT_EQUAL:
+                return (cmp != 0);
+            case FilterOp::LESS:
+                return (cmp < 0);
+            case FilterOp::LESS_EQUAL:
+                return (cmp <= 0);
+            case FilterOp::GREATER:
+                return (cmp > 0);
+            case FilterOp::GREATER_EQUAL:
+                return (cmp >= 0);
+            default:
+                break;
+        }
+        return true;
+    }
+
+    inline void JSONPath::Print_(std::string &text, const std::vector<Segment> &segments)
+    {
+        static constexpr std::string_view operators[] = {"", "==", "!=", "<", "<=", ">", ">="};
+
+        for (const auto &segment : segments) {
+            text.push_back('/');
+            switch (segment.type) {
+                case SegmentType::KEY:
+                    for (auto ch : segment.key.view()) {
+                        if (ch == '~') {
+                            text.append("~0");
+                        } else if (ch == '/') {
+                            text.append("~1");
+                        } else {
+                            text.push_back(ch);
+                        }
+                    }
+                    break;
+                case SegmentType::WILDCARD:
+                    text.push_back('*');
+                    break;
+                case SegmentType::FILTER:
+                    text.append("[?");
+                    Print_(text, segment.operand);
+                    if (segment.op != FilterOp::EXISTS) {
+                        text.append(operators[static_cast<size_t>(segment.op)]);
+                        text.append(segment.value.toRaw().data());
+                    }
+                    text.push_back(']');
+                    break;
+            }
+        }
+    }
+
+    // Depth first in document order, stops as soon as the visitor returns false.
+    template <typename _Node, typename _Visitor>
+    bool JSONPath::Walk_(const Segment* segment, const Segment* end, const _Node &node, _Visitor &visitor)
+    {
+        if (segment == end) {
+            return visitor(node);
+        }
+        if (segment->type == SegmentType::KEY) {
+            _Node child{};
+            if (node.child(*segment, child)) {
+                return Walk_((segment + 1), end, child, visitor);
+            }
+            return true;
+        }
+        auto size = node.size();
+        for (size_t pos = 0; pos < size; pos++) {
+            auto child = node.at(pos);
+            if (segment->type == SegmentType::FILTER && !Match_(*segment, child)) {
+                continue;
+            }
+            if (!Walk_((segment + 1), end, child, visitor)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename _Node>
+    bool JSONPath::Match_(const Segment &filter, const _Node &node)
+    {
+        _Node target{};
+        bool found = false;
+        auto visitor = [&target, &found](const _Node &result) -> bool {
+            target = result;
+            found = true;
+            return false;
+        };
+        Walk_(filter.operand.data(), (filter.operand.data() + filter.operand.size()), node, visitor);
+        if (!found) {
+            return false;
+        }
+        if (filter.op == FilterOp::EXISTS) {
+            return true;
+        }
+        return Compare_(target.value(), filter.op, filter.value);
+    }
+
+    inline const JSONItem* JSONItem::get(const JSONPath &path) const
+    {
+        return path.get(*this);
+    }
+
+    inline std::vector<const JSONItem*> JSONItem::select(const JSONPath &path) const
+    {
+        return path.select(*this);
+    }
+
+    inline const JSONItem* JSONArray::get(const JSONPath &path) const
+    {
+        return path.get(*this);
+    }
+
+    inline std::vector<const JSONItem*> JSONArray::select(const JSONPath &path) const
+    {
+        return path.select(*this);
+    }
+
+    inline const JSONItem* JSONObject::get(const JSONPath &path) const
+    {
+        return path.get(*this);
+    }
+
+    inline std::vector<const JSONItem*> JSONObject::select(const JSONPath &path) const
+    {
+        return path.select(*this);
+    }
+
+    // RFC 6902 JSON Patch and RFC 7386 JSON Merge Patch, applied to the target in place. Values are moved 
+    // out of an rvalue patch instead of copied. A failing operation throws and leaves the operations 
+    // before it applied, patch a copy when all-or-nothing is needed.
+    namespace JSONPatch
+    {
+        inline std::vector<std::string> _ParsePointer(std::string_view pointer)
+        {
+            std::vector<std::string> tokens{};
+            if (pointer.empty()) {
+                return tokens;
+            }
+            if (pointer[0] != '/') {
+                throw JSONExcept("Invalid JSON patch");
+            }
+            size_t pos = 1;
+            for (;;) {
+                auto end = std::min(pointer.find('/', pos), pointer.size());
+                std::string token{};
+                for (auto idx = pos; idx < end; idx++) {
+                    if (pointer[idx] != '~') {
+                        token.push_back(pointer[idx]);
+                    } else if ((idx + 1) < end && (pointer[idx + 1] == '0' || pointer[idx + 1] == '1')) {
+                        token.push_back((pointer[++idx] == '0') ? '~' : '/');
+                    } else {
+                        throw JSONExcept("Invalid JSON patch");
+                    }
+                }
+                tokens.emplace_back(std::move(token));
+                if (end == pointer.size()) {
+                    break;
+                }
+                pos = end + 1;
+            }
+            return tokens;
+        }
+
+        inline void _AppendPointer(std::string &pointer, std::string_view token)
+        {
+            pointer.push_back('/');
+            for (auto ch : token) {
+                if (ch == '~') {
+                    pointer.append("~0");
+                } else if (ch == '/') {
+                    pointer.append("~1");
+                } else {
+                    pointer.push_back(ch);
+                }
+            }
+        }
+
+        // Array positions are digits without leading zeros, "-" is one past the last element.
+        inline size_t _ParseIndex(std::string_view token, size_t size, bool allowEnd)
+        {
+            if (allowEnd && token == "-") {
+                return size;
+            }
+            if (token.empty() || token.size() > 18 || (token[0] == '0' && token.size() > 1)) {
+                throw JSONExcept("Position out of bounds");
+            }
+            size_t index = 0;
+            for (auto ch : token) {
+                if (ch < '0' || ch > '9') {
+                    throw JSONExcept("Position out of bounds");
+                }
+                index = index * 10 + static_cast<size_t>(ch - '0');
+            }
+            if (index > size || (index == size && !allowEnd)) {
+                throw JSONExcept("Position out of bounds");
+            }
+            return index;
+        }
+
+        inline const JSONItem &_Find(const JSONItem &root, const std::vector<std::string> &tokens)
+        {
+            auto item = std::addressof(root);
+            for (const auto &token : tokens) {
+                if (item->isObject()) {
+                    item = std::addressof(item->asObject().at(token));
+                } else if (item->isArray()) {
+                    const auto &array = item->asArray();
+                    item = std::addressof(array.at(_ParseIndex(token, array.size(), false)));
+                } else {
+                    throw JSONExcept("Key not found");
+                }
+            }
+            return *item;
+        }
+
+        // Goes through the mutable accessors, so no container on the way keeps a memoised hash.
+        inline JSONItem &_Locate(JSONItem &root, const std::vector<std::string> &tokens, size_t count)
+        {
+            auto item = std::addressof(root);
+            for (size_t idx = 0; idx < count; idx++) {
+                const auto &token = tokens[idx];
+                if (item->isObject()) {
+                    auto &object = item->asObject();
+                    if (!object.contains(token)) {
+                        throw JSONExcept("Key not found");
+                    }
+                    item = std::addressof(object[token]);
+                } else if (item->isArray()) {
+                    auto &array = item->asArray();
+                    item = std::addressof(array[_ParseIndex(token, array.size(), false)]);
+                } else {
+                    throw JSONExcept("Key not found");
+                }
+            }
+            return *item;
+        }
+
+        // Inverse of one applied change, the undo log is replayed backwards when a later operation fails.
+        // RESTORE puts value back at tokens, REMOVE deletes the member or element at tokens and INSERT 
+        // reinserts value at position of the parent. The value taken out by a step is carried to the next 
+        // one, an INSERT with carried set reinserts it, which undoes a "move".
+        struct _Undo
+        {
+            enum class Kind : uint8_t {RESTORE, REMOVE, INSERT};
+
+            Kind kind;
+            std::vector<std::string> tokens;
+            size_t position;
+            JSONItem value;
+            bool carried;
+        };
+
+        // Makes room for one more entry before a change, so that recording it afterwards cannot fail.
+        inline void _ReserveUndo(std::vector<_Undo> &undo)
+        {
+            if (undo.size() == undo.capacity()) {
+                undo.reserve(std::max(static_cast<size_t>(8), (undo.size() * 2)));
+            }
+        }
+
+        inline void _Add(JSONItem &root, const std::vector<std::string> &tokens, JSONItem &&value, std::vector<_Undo> &undo)
+        {
+            _ReserveUndo(undo);
+            _Undo entry{_Undo::Kind::RESTORE, tokens, 0, JSONItem(), false};
+            if (tokens.empty()) {
+                entry.value = std::move(root);
+                root = std::move(value);
+                undo.push_back(std::move(entry));
+                return;
+            }
+            auto &parent = _Locate(root, tokens, (tokens.size() - 1));
+            if (parent.isObject()) {
+                auto &object = parent.asObject();
+                if (object.contains(tokens.back())) {
+                    auto &member = object[tokens.back()];
+                    entry.value = std::move(member);
+                    member = std::move(value);
+                } else {
+                    entry.kind = _Undo::Kind::REMOVE;
+                    object.add(tokens.back(), std::move(value));
+                }
+            } else if (parent.isArray()) {
+                auto &array = parent.asArray();
+                auto pos = _ParseIndex(tokens.back(), array.size(), true);
+                entry.kind = _Undo::Kind::REMOVE;
+                entry.tokens.back() = std::to_string(pos);
+                array.insert(pos, std::move(value));
+            } else {
+                throw JSONExcept("Key not found");
+            }
+            undo.push_back(std::move(entry));
+        }
+
+        // The removed value is returned when carried is set, otherwise it is kept by the undo log.
+        inline JSONItem _Remove(JSONItem &root, const std::vector<std::string> &tokens, std::vector<_Undo> &undo, bool carried)
+        {
+            if (tokens.empty()) {
+                throw JSONExcept("Invalid JSON patch");
+            }
+            _ReserveUndo(undo);
+            _Undo entry{_Undo::Kind::INSERT, tokens, 0, JSONItem(), carried};
+            auto &parent = _Locate(root, tokens, (tokens.size() - 1));
+            JSONItem value{};
+            if (parent.isObject()) {
+                auto &object = parent.asObject();
+                if (!object.contains(tokens.back())) {
+                    throw JSONExcept("Key not found");
+                }
+                const auto &members = object.members();
+                while (members[entry.position].key != tokens.back()) {
+                    entry.position++;
+                }
+                value = std::move(object[tokens.back()]);
+                object.remove(tokens.back());
+            } else if (parent.isArray()) {
+                auto &array = parent.asArray();
+                entry.position = _ParseIndex(tokens.back(), array.size(), false);
+                value = std::move(array[entry.position]);
+                array.erase(entry.position);
+            } else {
+                throw JSONExcept("Key not found");
+            }
+            if (!carried) {
+                entry.value = std::move(value);
+            }
+            undo.push_back(std::move(entry));
+            return value;
+        }
+
+        inline void _Rollback(JSONItem &root, std::vector<_Undo> &undo)
+        {
+            JSONItem carry{};
+            while (!undo.empty()) {
+                auto &entry = undo.back();
+                if (entry.kind == _Undo::Kind::RESTORE) {
+                    auto &item = _Locate(root, entry.tokens, entry.tokens.size());
+                    carry = std::move(item);
+                    item = std::move(entry.value);
+                } else if (entry.kind == _Undo::Kind::REMOVE) {
+                    std::vector<_Undo> discarded{};
+                    carry = _Remove(root, entry.tokens, discarded, true);
+                } else {
+                    auto value = entry.carried ? std::move(carry) : std::move(entry.value);
+                    auto &parent = _Locate(root, entry.tokens, (entry.tokens.size() - 1));
+                    if (parent.isObject()) {
+                        // The member goes back to the end, the ones that followed it are moved behind it again.
+                        auto &object = parent.asObject();
+                        object.add(entry.tokens.back(), std::move(value));
+                        auto count = object.size() - 1 - entry.position;
+                        for (size_t idx = 0; idx < count; idx++) {
+                            auto key = object.members()[entry.position].key;
+                            auto member = std::move(object[key]);
+                            object.remove(key);
+                            object.add(key, std::move(member));
+                        }
+                    } else {
+                        parent.asArray().insert(entry.position, std::move(value));
+                    }
+                }
+                undo.pop_back();
+            }
+        }
+
+        inline std::string_view _Member(const JSONObject &operation, std::string_view key)
+        {
+            auto member = operation.find(key);
+            if (member == nullptr || !member->isString()) {
+                throw JSONExcept("Invalid JSON patch");
+            }
+            return member->asString();
+        }
+
+        // value is only read by add, replace and test, which require the operation to have one.
+        inline void _Apply(JSONItem &target, const JSONObject &operation, JSONItem &&value, std::vector<_Undo> &undo)
+        {
+            auto op = _Member(operation, "op");
+            auto path = _ParsePointer(_Member(operation, "path"));
+            if ((op == "add" || op == "replace" || op == "test") && operation.find("value") == nullptr) {
+                throw JSONExcept("Invalid JSON patch");
+            }
+            if (op == "add") {
+                _Add(target, path, std::move(value), undo);
+            } else if (op == "remove") {
+                _Remove(target, path, undo, false);
+            } else if (op == "replace") {
+                _ReserveUndo(undo);
+                _Undo entry{_Undo::Kind::RESTORE, path, 0, JSONItem(), false};
+                auto &item = _Locate(target, path, path.size());
+                entry.value = std::move(item);
+                item = std::move(value);
+                undo.push_back(std::move(entry));
+            } else if (op == "move") {
+                auto fromText = _Member(operation, "from");
+                auto pathText = _Member(operation, "path");
+                if (fromText == pathText) {
+                    return;
+                }
+                if (pathText.size() > fromText.size() && pathText.compare(0, fromText.size(), fromText) == 0 && 
+                    pathText[fromText.size()] == '/') 
+                {
+                    throw JSONExcept("Invalid JSON patch");
+                }
+                auto moved = _Remove(target, _ParsePointer(fromText), undo, true);
+                _Add(target, path, std::move(moved), undo);
+            } else if (op == "copy") {
+                JSONItem copied(_Find(target, _ParsePointer(_Member(operation, "from"))));
+                _Add(target, path, std::move(copied), undo);
+            } else if (op == "test") {
+                if (_Find(target, path) != value) {
+                    throw JSONExcept("JSON patch test failed");
+                }
+            } else {
+                throw JSONExcept("Invalid JSON patch");
+            }
+        }
+
+        inline void _MakeOperation(JSONArray &patch, std::string_view op, const std::string &path, const JSONItem* value)
+        {
+            JSONObject operation{};
+            operation.add("op", std::string(op));
+            operation.add("path", path);
+            if (value != nullptr) {
+                operation.add("value", *value);
+            }
+            patch.add(std::move(operation));
+        }
+
+        // Subtrees compare by their cached hashes first, so unchanged parts of a tree that was diffed 
+        // before are skipped without being walked again.
+        inline bool _Same(const JSONItem &source, const JSONItem &target)
+        {
+            return (source.hash() == target.hash() && source == target);
+        }
+
+        inline void _Diff(const JSONItem &source, const JSONItem &target, std::string &path, JSONArray &patch);
+
+        // Added members go to the end of an object, so only the leading target members that appear in 
+        // source in the same order stay in place. Members of source found later in target are removed 
+        // and added again, the patched object then has the member order of target.
+        inline void _DiffObject(const JSONObject &source, const JSONObject &target, std::string &path, JSONArray &patch)
+        {
+            const auto &sourceMembers = source.members();
+            std::vector<bool> inPlace(sourceMembers.size(), false);
+            size_t inPlaceCount = 0;
+            size_t next = 0;
+            for (const auto &member : target) {
+                while (next < sourceMembers.size() && sourceMembers[next].key != member.key) {
+                    next++;
+                }
+                if (next == sourceMembers.size()) {
+                    break;
+                }
+                inPlace[next++] = true;
+                inPlaceCount++;
+            }
+
+            auto length = path.size();
+            for (size_t pos = 0; pos < sourceMembers.size(); pos++) {
+                if (!inPlace[pos]) {
+                    _AppendPointer(path, sourceMembers[pos].key.view());
+                    _MakeOperation(patch, "remove", path, nullptr);
+                    path.resize(length);
+                }
+            }
+            size_t count = 0;
+            for (const auto &[key, value] : target) {
+                _AppendPointer(path, key.view());
+                if (count++ < inPlaceCount) {
+                    _Diff(*source.find(key), value, path, patch);
+                } else {
+                    _MakeOperation(patch, "add", path, std::addressof(value));
+                }
+                path.resize(length);
+            }
+        }
+
+        // Common leading and trailing elements are kept, the differing middle is patched position by 
+        // position and then grown or shrunk, so an insertion or removal does not rewrite the tail.
+        inline void _DiffArray(const JSONArray &source, const JSONArray &target, std::string &path, JSONArray &patch)
+        {
+            const auto &sourceData = source.data();
+            const auto &targetData = target.data();
+            size_t prefix = 0;
+            while (prefix < sourceData.size() && prefix < targetData.size() && _Same(sourceData[prefix], targetData[prefix])) {
+                prefix++;
+            }
+            size_t suffix = 0;
+            while ((suffix + prefix) < sourceData.size() && (suffix + prefix) < targetData.size() && 
+                _Same(sourceData[sourceData.size() - suffix - 1], targetData[targetData.size() - suffix - 1])) 
+            {
+                suffix++;
+            }
+
+            auto length = path.size();
+            auto sourceCount = sourceData.size() - prefix - suffix;
+            auto targetCount = targetData.size() - prefix - suffix;
+            auto common = std::min(sourceCount, targetCount);
+            for (size_t idx = 0; idx < common; idx++) {
+                _AppendPointer(path, std::to_string(prefix + idx));
+                _Diff(sourceData[prefix + idx], targetData[prefix + idx], path, patch);
+                path.resize(length);
+            }
+            for (auto idx = common; idx < targetCount; idx++) {
+                _AppendPointer(path, std::to_string(prefix + idx));
+                _MakeOperation(patch, "add", path, std::addressof(targetData[prefix + idx]));
+                path.resize(length);
+            }
+            for (auto idx = common; idx < sourceCount; idx++) {
+                _AppendPointer(path, std::to_string(prefix + common));
+                _MakeOperation(patch, "remove", path, nullptr);
+                path.resize(length);
+            }
+        }
+
+        inline void _Diff(const JSONItem &source, const JSONItem &target, std::string &path, JSONArray &patch)
+        {
+            if (_Same(source, target)) {
+                return;
+            }
+            if (source.isObject() && target.isObject()) {
+                _DiffObject(source.asObject(), target.asObject(), path, patch);
+            } else if (source.isArray() && target.isArray()) {
+                _DiffArray(source.asArray(), target.asArray(), path, patch);
+            } else {
+                _MakeOperation(patch, "replace", path, std::addressof(target));
+            }
+        }
+
+        inline void _MergeObject(JSONObject &target, const JSONObject &patch);
+        inline void _MergeObject(JSONObject &target, JSONObject &&patch);
+
+        inline void _MergeValue(JSONObject &target, const JSONKey &key, const JSONItem &value)
+        {
+            if (value.isNull()) {
+                if (target.contains(key)) {
+                    target.remove(key);
+                }
+            } else if (value.isObject()) {
+                auto &item = target[key];
+                if (!item.isObject()) {
+                    item = JSONObject();
+                }
+                _MergeObject(item.asObject(), value.asObject());
+            } else {
+                target[key] = value;
+            }
+        }
+
+        inline void _MergeValue(JSONObject &target, const JSONKey &key, JSONItem &&value)
+        {
+            if (value.isNull()) {
+                if (target.contains(key)) {
+                    target.remove(key);
+                }
+            } else if (value.isObject()) {
+                auto &item = target[key];
+                if (!item.isObject()) {
+                    item = JSONObject();
+                }
+                _MergeObject(item.asObject(), value.takeObject());
+            } else {
+                target[key] = std::move(value);
+            }
+        }
+
+        inline void _MergeObject(JSONObject &target, const JSONObject &patch)
+        {
+            for (const auto &[key, value] : patch) {
+                _MergeValue(target, key, value);
+            }
+        }
+
+        inline void _MergeObject(JSONObject &target, JSONObject &&patch)
+        {
+            for (const auto &member : patch.members()) {
+                _MergeValue(target, member.key, std::move(patch[member.key]));
+            }
+        }
+
+        inline void _Apply(JSONItem &target, const JSONArray &patch, std::vector<_Undo> &undo)
+        {
+            for (const auto &operation : patch) {
+                if (!operation.isObject()) {
+                    throw JSONExcept("Invalid JSON patch");
+                }
+                const auto &object = operation.asObject();
+                auto value = object.find("value");
+                _Apply(target, object, (value != nullptr) ? JSONItem(*value) : JSONItem(), undo);
+            }
+        }
+
+        inline void _Apply(JSONItem &target, JSONArray &&patch, std::vector<_Undo> &undo)
+        {
+            for (auto &operation : patch) {
+                if (!operation.isObject()) {
+                    throw JSONExcept("Invalid JSON patch");
+                }
+                auto &object = operation.asObject();
+                JSONItem value{};
+                if (object.contains("value")) {
+                    value = std::move(object["value"]);
+                }
+                _Apply(target, object, std::move(value), undo);
+            }
+            patch.clear();
+        }
+
+        // The patch is applied in place as a whole or not at all, a failing operation rolls back the 
+        // ones applied before it.
+        template <typename _Patch>
+        void _ApplyAtomic(JSONItem &target, _Patch &&patch, bool keepObject)
+        {
+            std::vector<_Undo> undo{};
+            try {
+                _Apply(target, std::forward<_Patch>(patch), undo);
+                if (keepObject && !target.isObject()) {
+                    throw JSONExcept("Item is not of object type");
+                }
+            } catch (...) {
+                _Rollback(target, undo);
+                throw;
+            }
+        }
+
+        inline void Apply(JSONItem &target, const JSONArray &patch)
+        {
+            _ApplyAtomic(target, patch, false);
+        }
+
+        inline void Apply(JSONItem &target, JSONArray &&patch)
+        {
+            _ApplyAtomic(target, std::move(patch), false);
+        }
+
+        // The root of an object document must stay an object.
+        inline void Apply(JSONObject &target, const JSONArray &patch)
+        {
+            JSONItem root(std::move(target));
+            try {
+                _ApplyAtomic(root, patch, true);
+            } catch (...) {
+                if (root.isObject()) {
+                    target = root.takeObject();
+                }
+                throw;
+            }
+            target = root.takeObject();
+        }
+
+        inline void Apply(JSONObject &target, JSONArray &&patch)
+        {
+            JSONItem root(std::move(target));
+            try {
+                _ApplyAtomic(root, std::move(patch), true);
+            } catch (...) {
+                if (root.isObject()) {
+                    target = root.takeObject();
+                }
+                throw;
+            }
+            target = root.takeObject();
+        }
+
+        // Operations turning source into target, removals come before additions at every level. 
+        // Applying them gives an object equal to target including the order of its members.
+        inline JSONArray Diff(const JSONItem &source, const JSONItem &target)
+        {
+            JSONArray patch{};
+            std::string path{};
+            _Diff(source, target, path, patch);
+            return patch;
+        }
+
+        inline JSONArray Diff(const JSONObject &source, const JSONObject &target)
+        {
+            JSONArray patch{};
+            std::string path{};
+            _DiffObject(source, target, path, patch);
+            return patch;
+        }
+
+        inline void ApplyMerge(JSONItem &target, const JSONItem &patch)
+        {
+            if (!patch.isObject()) {
+                target = patch;
+                return;
+            }
+            if (!target.isObject()) {
+                target = JSONObject();
+            }
+            _MergeObject(target.asObject(), patch.asObject());
+        }
+
+        inline void ApplyMerge(JSONItem &target, JSONItem &&patch)
+        {
+            if (!patch.isObject()) {
+                target = std::move(patch);
+                return;
+            }
+            if (!target.isObject()) {
+                target = JSONObject();
+            }
+            _MergeObject(target.asObject(), patch.takeObject());
+        }
+
+        inline void ApplyMerge(JSONObject &target, const JSONObject &patch)
+        {
+            _MergeObject(target, patch);
+        }
+
+        inline void ApplyMerge(JSONObject &target, JSONObject &&patch)
+        {
+            _MergeObject(target, std::move(patch));
+        }
+
+        // Merge patches cannot set a member to null, such members of target come out removed.
+        inline JSONItem DiffMerge(const JSONItem &source, const JSONItem &target);
+
+        inline JSONObject DiffMerge(const JSONObject &source, const JSONObject &target)
+        {
+            JSONObject patch{};
+            for (const auto &[key, value] : source) {
+                if (target.find(key) == nullptr) {
+                    patch.add(key, JSONItem());
+                }
+            }
+            for (const auto &[key, value] : target) {
+                auto sourceValue = source.find(key);
+                if (sourceValue == nullptr) {
+                    patch.add(key, value);
+                } else if (!_Same(*sourceValue, value)) {
+                    patch.add(key, DiffMerge(*sourceValue, value));
+                }
+            }
+            return patch;
+        }
+
+        inline JSONItem DiffMerge(const JSONItem &source, const JSONItem &target)
+        {
+            if (source.isObject() && target.isObject()) {
+                return DiffMerge(source.asObject(), target.asObject());
+            }
+            return target;
+        }
+    }
+
+    // Cursor over JSON text shared by the parsers that do not build the DOM as they go.
+    // Containers are opened by expect() and closed by consume(), which keep the closers of the open ones.
+    class _JSON_Reader
+    {
+        public:
+            explicit _JSON_Reader(std::string_view jsonText, size_t maxDepth = _JSON_Parse_Utils::defaultMaxDepth) : 
+                jsonText_(jsonText), pos_(0), maxDepth_(maxDepth), closers_(), buffer_() 
+            { }
+
+            char peek() noexcept
+            {
+                pos_ = std::min(_JSON_Parse_Utils::IgnoreBlank(jsonText_, pos_), jsonText_.size());
+                return (pos_ < jsonText_.size()) ? jsonText_[pos_] : '\0';
+            }
+
+            bool consume(char ch) noexcept
+            {
+                if (peek() == ch) {
+                    if ((ch == '}' || ch == ']') && !closers_.empty()) {
+                        closers_.pop_back();
+                    }
+                    pos_++;
+                    return true;
+                }
+                return false;
+            }
+
+            void expect(char ch)
+            {
+                if (ch == '{' || ch == '[') {
+                    if (closers_.size() >= maxDepth_) {
+                        fail("JSON nesting exceeds the maximum depth");
+                    }
+                    closers_.push_back((ch == '{') ? '}' : ']');
+                }
+                if (!consume(ch)) {
+                    switch (ch) {
+                        case '{':
+                            fail("JSON Object must begin with \'{\'");
+                            break;
+                        case '}':
+                            fail("JSON Object must end with \'}\'");
+                            break;
+                        case '[':
+                            fail("JSON Array must begin with \'[\'");
+                            break;
+                        case ']':
+                            fail("JSON Array must end with \']\'");
+                            break;
+                        default:
+                            fail("missing \':\' after JSON Object key");
+                            break;
+                    }
+                }
+            }
+
+            bool literal(std::string_view text) noexcept
+            {
+                peek();
+                if (jsonText_.substr(pos_, text.size()) == text) {
+                    pos_ += text.size();
+                    return true;
+                }
+                return false;
+            }
+
+            // The view stays valid until the next string is read.
+            std::string_view string()
+            {
+                if (peek() != '\"') {
+                    fail("JSON String must begin with \'\"\'");
+                }
+                auto beginPos = ++pos_;
+                auto size = jsonText_.size();
+                while (pos_ < size && jsonText_[pos_] != '\"' && jsonText_[pos_] != '\\') {
+                    pos_++;
+                }
+                if (pos_ < size && jsonText_[pos_] == '\"') {
+                    return jsonText_.substr(beginPos, (pos_++ - beginPos));
+                }
+
+                buffer_.assign((jsonText_.data() + beginPos), (pos_ - beginPos));
+                while (pos_ < size) {
+                    auto ch = jsonText_[pos_];
+                    if (ch == '\"') {
+                        pos_++;
+                        return buffer_;
+                    } else if (ch == '\\') {
+                        if ((pos_ + 1) >= size) {
+                            break;
+                        }
+                        auto charResult = _JSON_Parse_Utils::ParseEscapeChar(jsonText_, pos_);
+                        buffer_.append(charResult.resultVal.data());
+                        pos_ = charResult.endPos;
+                    } else {
+                        buffer_.push_back(ch);
+                        pos_++;
+                    }
+                }
+                _JSON_Parse_Utils::ThrowSyntaxExcept("JSON String must end with \'\"\'", jsonText_, beginPos);
+                return {};
+            }
+
+            _JSON_Number_Utils::Number number()
+            {
+                peek();
+                _JSON_Number_Utils::Number number{};
+                auto endPos = _JSON_Number_Utils::ParseNumber(jsonText_, pos_, number);
+                if (endPos == std::string_view::npos) {
+                    fail("invalid JSON Number");
+                }
+                pos_ = endPos;
+                return number;
+            }
+
+            // Strings, numbers and literals, integers that fit are stored as int like ParseJSONItem does.
+            JSONItem scalar()
+            {
+                switch (peek()) {
+                    case '\"':
+                        return std::string(string());
+                    case 't':
+                    case 'f':
+                    case 'n':
+                        if (literal("true")) {
+                            return true;
+                        } else if (literal("false")) {
+                            return false;
+                        } else if (literal("null")) {
+                            return JSONItem();
+                        }
+                        fail("unknown JSON Item");
+                    default:
+                        break;
+                }
+                auto value = number();
+                if (value.isDouble) {
+                    return value.number;
+                } else if (value.integer >= INT_MIN && value.integer <= INT_MAX) {
+                    return static_cast<int>(value.integer);
+                }
+                return value.integer;
+            }
+
+            // Parses a whole value into the DOM with the iterative reference parser, which continues 
+            // counting the nesting from the containers already open.
+            JSONItem item()
+            {
+                peek();
+                auto itemResult = _JSON_Parse_Utils::ParseJSONItem(jsonText_, pos_, (maxDepth_ - std::min(closers_.size(), maxDepth_)));
+                pos_ = itemResult.endPos;
+                return std::move(itemResult.resultVal);
+            }
+
+            // Validates and skips the value of an unknown key, without recursing into nested containers.
+            void skip()
+            {
+                auto depth = closers_.size();
+                for (;;) {
+                    switch (peek()) {
+                        case '{':
+                            expect('{');
+                            if (!consume('}')) {
+                                string();
+                                expect(':');
+                                continue;
+                            }
+                            break;
+                        case '[':
+                            expect('[');
+                            if (!consume(']')) {
+                                continue;
+                            }
+                            break;
+                        case '\"':
+                            string();
+                            break;
+                        case 't':
+                        case 'f':
+                        case 'n':
+                            if (!literal("true") && !literal("false") && !literal("null")) {
+                                fail("unknown JSON Item");
+                            }
+                            break;
+                        default:
+                            number();
+                            break;
+                    }
 
-                ~_Binary_Container() noexcept
-                {
-                    if (block_ != nullptr) {
-                        std::free(block_);
+                    for (;;) {
+                        if (closers_.size() == depth) {
+                            return;
+                        }
+                        if (consume(',')) {
+                            if (closers_.back() == '}') {
+                                string();
+                                expect(':');
+                            }
+                            break;
+                        }
+                        expect(closers_.back());
                     }
                 }
+            }
 
-                void resize(pos_t req_capacity) noexcept
-                {
-                    auto new_block = reinterpret_cast<byte_t*>(std::realloc(block_, req_capacity));
-                    if (new_block != nullptr) {
-                        block_ = new_block;
-                        capacity_ = req_capacity;
-                    }
-                    if (size_ > capacity_) {
-                        size_ = capacity_;
-                    }
+            void finish()
+            {
+                if (peek() != '\0' || pos_ < jsonText_.size()) {
+                    fail("unexpected text after JSON Item");
                 }
+            }
 
-                void add(const void* data, pos_t data_size) noexcept
-                {
-                    if ((size_ + data_size) > capacity_) {
-                        resize(size_ * 2 + data_size);
+            [[noreturn]] void fail(const char* message) const
+            {
+                _JSON_Parse_Utils::ThrowSyntaxExcept(message, jsonText_, pos_);
+                throw JSONExcept(message);
+            }
+
+        private:
+            std::string_view jsonText_;
+            size_t pos_;
+            size_t maxDepth_;
+            std::string closers_;
+            std::string buffer_;
+    };
+
+    // Typed binding between JSON text and the structs declared with CU_JSON_BIND, values are parsed into 
+    // and written from the fields directly without building a JSONItem. Keys are dispatched through a hash 
+    // table built at compile time, unknown keys are skipped and missing keys keep the value of the field.
+    // Fields may be bool, integers, floating points, std::string, std::vector, std::optional, JSONItem, 
+    // JSONArray, JSONObject or other bound structs. Integers must fit in int64_t.
+    namespace JSONBind
+    {
+        template <typename _Class, typename _Member>
+        struct Field
+        {
+            std::string_view name;
+            _Member _Class::*member;
+        };
+
+        template <typename _Class, typename _Member>
+        constexpr Field<_Class, _Member> MakeField(std::string_view name, _Member _Class::*member) noexcept
+        {
+            return {name, member};
+        }
+
+        constexpr uint32_t _Hash(std::string_view key, uint32_t seed) noexcept
+        {
+            uint32_t hash = 2166136261U ^ seed;
+            for (auto ch : key) {
+                hash = (hash ^ static_cast<uint8_t>(ch)) * 16777619U;
+            }
+            return hash;
+        }
+
+        template <typename _Fields, size_t ..._Idx>
+        constexpr auto _Names(const _Fields &fields, std::index_sequence<_Idx...>) noexcept
+        {
+            return std::array<std::string_view, sizeof...(_Idx)>{std::get<_Idx>(fields).name...};
+        }
+
+        constexpr size_t _TableSize(size_t count) noexcept
+        {
+            size_t size = 8;
+            while (size < (count * 4)) {
+                size <<= 1;
+            }
+            return size;
+        }
+
+        // The first seed that maps every name to its own slot, so a known key is found by the first probe. 
+        // Falls back to linear probing with seed 0 when there is none.
+        template <size_t _Size, size_t _Count>
+        constexpr uint32_t _Seed(const std::array<std::string_view, _Count> &names) noexcept
+        {
+            for (uint32_t seed = 0; seed < 256; seed++) {
+                std::array<bool, _Size> used{};
+                bool perfect = true;
+                for (size_t idx = 0; idx < _Count && perfect; idx++) {
+                    auto slot = _Hash(names[idx], seed) & (_Size - 1);
+                    perfect = !used[slot];
+                    used[slot] = true;
+                }
+                if (perfect) {
+                    return seed;
+                }
+            }
+            return 0;
+        }
+
+        template <size_t _Size, size_t _Count>
+        constexpr std::array<uint8_t, _Size> _Table(const std::array<std::string_view, _Count> &names, uint32_t seed) noexcept
+        {
+            std::array<uint8_t, _Size> table{};
+            for (size_t idx = 0; idx < _Count; idx++) {
+                auto slot = _Hash(names[idx], seed) & (_Size - 1);
+                while (table[slot] != 0) {
+                    slot = (slot + 1) & (_Size - 1);
+                }
+                table[slot] = static_cast<uint8_t>(idx + 1);
+            }
+            return table;
+        }
+
+        template <typename _Ty, typename = void>
+        struct _IsBound : std::false_type { };
+
+        template <typename _Ty>
+        struct _IsBound<_Ty, std::void_t<decltype(_CU_JSON_Bind_Fields(static_cast<const _Ty*>(nullptr)))>> : 
+            std::true_type { };
+
+        // Bound structs, the other supported types are specializations below.
+        template <typename _Ty, typename = void>
+        struct _Binder
+        {
+            static_assert(_IsBound<_Ty>::value, "Type is not declared with CU_JSON_BIND");
+
+            static constexpr auto fields = _CU_JSON_Bind_Fields(static_cast<const _Ty*>(nullptr));
+            static constexpr size_t count = std::tuple_size_v<std::remove_const_t<decltype(fields)>>;
+            static constexpr auto names = _Names(fields, std::make_index_sequence<count>());
+            static constexpr size_t tableSize = _TableSize(count);
+            static constexpr uint32_t seed = _Seed<tableSize>(names);
+            static constexpr auto table = _Table<tableSize>(names, seed);
+
+            // A field given more than once keeps its first value like JSONObject(text), the later ones are skipped.
+            static void Read(_JSON_Reader &reader, _Ty &value)
+            {
+                reader.expect('{');
+                if (reader.consume('}')) {
+                    return;
+                }
+                std::array<bool, count> seen{};
+                do {
+                    auto idx = Find(reader.string());
+                    reader.expect(':');
+                    if (idx < count && !seen[idx]) {
+                        seen[idx] = true;
+                        ReadField_(reader, value, idx, std::make_index_sequence<count>());
+                    } else {
+                        reader.skip();
                     }
-                    auto dst = _Move_Ptr(block_, size_);
-                    if (dst != nullptr && data != nullptr) {
-                        std::memcpy(dst, data, data_size);
-                        size_ += data_size;
+                } while (reader.consume(','));
+                reader.expect('}');
+            }
+
+            static void Write(JSONWriter &writer, const _Ty &value)
+            {
+                writer.writeRaw("{");
+                WriteFields_(writer, value, std::make_index_sequence<count>());
+                writer.writeRaw("}");
+            }
+
+            static size_t Find(std::string_view key) noexcept
+            {
+                auto slot = _Hash(key, seed) & (tableSize - 1);
+                while (table[slot] != 0) {
+                    size_t idx = table[slot] - 1;
+                    if (names[idx] == key) {
+                        return idx;
                     }
+                    slot = (slot + 1) & (tableSize - 1);
                 }
+                return count;
+            }
 
-                byte_t* data() noexcept
-                {
-                    return block_;
-                }
+            template <size_t _Idx>
+            static void ReadMember_(_JSON_Reader &reader, _Ty &value)
+            {
+                auto &member = value.*(std::get<_Idx>(fields).member);
+                _Binder<std::remove_reference_t<decltype(member)>>::Read(reader, member);
+            }
 
-                byte_t* dump() noexcept
-                {
-                    auto dump_data = block_;
-                    block_ = nullptr;
-                    capacity_ = 0;
-                    size_ = 0;
-                    return dump_data;
+            template <size_t ..._Idx>
+            static void ReadField_(_JSON_Reader &reader, _Ty &value, size_t idx, std::index_sequence<_Idx...>)
+            {
+                static_cast<void>(((idx == _Idx && (ReadMember_<_Idx>(reader, value), true)) || ...));
+            }
+
+            template <size_t _Idx>
+            static void WriteMember_(JSONWriter &writer, const _Ty &value)
+            {
+                writer.writeRaw((_Idx == 0) ? "\"" : ",\"");
+                writer.writeRaw(std::get<_Idx>(fields).name);
+                writer.writeRaw("\":");
+                const auto &member = value.*(std::get<_Idx>(fields).member);
+                _Binder<std::decay_t<decltype(member)>>::Write(writer, member);
+            }
+
+            template <size_t ..._Idx>
+            static void WriteFields_(JSONWriter &writer, const _Ty &value, std::index_sequence<_Idx...>)
+            {
+                (WriteMember_<_Idx>(writer, value), ...);
+            }
+        };
+
+        template <>
+        struct _Binder<bool>
+        {
+            static void Read(_JSON_Reader &reader, bool &value)
+            {
+                if (reader.literal("true")) {
+                    value = true;
+                } else if (reader.literal("false")) {
+                    value = false;
+                } else {
+                    reader.fail("JSON Item is not a boolean");
                 }
+            }
 
-                pos_t size() const noexcept
-                {
-                    return size_;
+            static void Write(JSONWriter &writer, bool value)
+            {
+                writer.writeBoolean(value);
+            }
+        };
+
+        template <typename _Ty>
+        struct _Binder<_Ty, std::enable_if_t<std::is_integral_v<_Ty> && !std::is_same_v<_Ty, bool>>>
+        {
+            static void Read(_JSON_Reader &reader, _Ty &value)
+            {
+                auto number = reader.number();
+                if (number.isDouble) {
+                    reader.fail("JSON Number is not an integer");
+                }
+                if constexpr (std::is_unsigned_v<_Ty>) {
+                    if (number.integer < 0) {
+                        reader.fail("JSON Number is out of range");
+                    }
+                }
+                if constexpr (sizeof(_Ty) < sizeof(int64_t)) {
+                    if (number.integer < static_cast<int64_t>(std::numeric_limits<_Ty>::min()) || 
+                        number.integer > static_cast<int64_t>(std::numeric_limits<_Ty>::max())) 
+                    {
+                        reader.fail("JSON Number is out of range");
+                    }
                 }
+                value = static_cast<_Ty>(number.integer);
+            }
 
-            private:
-                byte_t* block_;
-                pos_t capacity_;
-                pos_t size_;
+            static void Write(JSONWriter &writer, _Ty value)
+            {
+                if constexpr (std::is_unsigned_v<_Ty>) {
+                    char buffer[32]{};
+                    auto length = _JSON_Number_Utils::FormatUnsigned(buffer, static_cast<uint64_t>(value));
+                    writer.writeRaw(std::string_view(buffer, length));
+                } else {
+                    writer.writeLong(static_cast<int64_t>(value));
+                }
+            }
         };
 
-        inline pos_t _GetBinarySize(const byte_t* binary) noexcept
+        template <typename _Ty>
+        struct _Binder<_Ty, std::enable_if_t<std::is_floating_point_v<_Ty>>>
         {
-            return *reinterpret_cast<const pos_t*>(binary);
-        }
+            static void Read(_JSON_Reader &reader, _Ty &value)
+            {
+                auto number = reader.number();
+                value = static_cast<_Ty>(number.isDouble ? number.number : static_cast<double>(number.integer));
+            }
 
-        inline void _DeleteBinary(byte_t* binary) noexcept
+            static void Write(JSONWriter &writer, _Ty value)
+            {
+                writer.writeDouble(static_cast<double>(value));
+            }
+        };
+
+        template <>
+        struct _Binder<std::string>
         {
-            if (binary != nullptr) {
-                std::free(binary);
+            static void Read(_JSON_Reader &reader, std::string &value)
+            {
+                auto text = reader.string();
+                value.assign(text.data(), text.size());
             }
-        }
 
-        inline byte_t* _ObjectToBinary(const JSONObject &object);
+            static void Write(JSONWriter &writer, const std::string &value)
+            {
+                writer.writeString(value);
+            }
+        };
 
-        inline CU::JSONObject _BinaryToObject(const byte_t* binary);
+        template <typename _Ty>
+        struct _Binder<std::vector<_Ty>>
+        {
+            static void Read(_JSON_Reader &reader, std::vector<_Ty> &value)
+            {
+                reader.expect('[');
+                value.clear();
+                if (reader.consume(']')) {
+                    return;
+                }
+                do {
+                    if constexpr (std::is_same_v<_Ty, bool>) {
+                        bool item = false;
+                        _Binder<bool>::Read(reader, item);
+                        value.push_back(item);
+                    } else {
+                        _Binder<_Ty>::Read(reader, value.emplace_back());
+                    }
+                } while (reader.consume(','));
+                reader.expect(']');
+            }
 
-        inline byte_t* _ArrayToBinary(const JSONArray &array)
+            static void Write(JSONWriter &writer, const std::vector<_Ty> &value)
+            {
+                writer.writeRaw("[");
+                for (size_t idx = 0; idx < value.size(); idx++) {
+                    if (idx > 0) {
+                        writer.writeRaw(",");
+                    }
+                    _Binder<_Ty>::Write(writer, value[idx]);
+                }
+                writer.writeRaw("]");
+            }
+        };
+
+        template <typename _Ty>
+        struct _Binder<std::optional<_Ty>>
         {
-            static const auto addBlock = [](_Binary_Container &container, const JSONItem &item) {
-                switch (item.type()) {
-                    case JSONItem::ItemType::ITEM_NULL:
-                        {
-                            auto type = JSONItem::ItemType::ITEM_NULL;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                        }
-                        break;
-                    case JSONItem::ItemType::BOOLEAN:
-                        {
-                            bool data = item;
-                            auto type = JSONItem::ItemType::BOOLEAN;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + sizeof(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(std::addressof(data), sizeof(data));
-                        }
-                        break;
-                    case JSONItem::ItemType::INTEGER:
-                        {
-                            int data = item;
-                            auto type = JSONItem::ItemType::INTEGER;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + sizeof(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(std::addressof(data), sizeof(data));
-                        }
-                        break;
-                    case JSONItem::ItemType::LONG:
-                        {
-                            int64_t data = item;
-                            auto type = JSONItem::ItemType::LONG;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + sizeof(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(std::addressof(data), sizeof(data));
-                        }
-                        break;
-                    case JSONItem::ItemType::DOUBLE:
-                        {
-                            double data = item;
-                            auto type = JSONItem::ItemType::DOUBLE;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + sizeof(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(std::addressof(data), sizeof(data));
-                        }
-                        break;
-                    case JSONItem::ItemType::STRING:
-                        {
-                            std::string data = item;
-                            auto type = JSONItem::ItemType::STRING;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + data.length() + 1;
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(data.data(), (data.length() + 1));
-                        }
-                        break;
-                    case JSONItem::ItemType::ARRAY:
-                        {
-                            auto data = _ArrayToBinary(item.toArray());
-                            auto type = JSONItem::ItemType::ARRAY;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + _GetBinarySize(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(data, _GetBinarySize(data));
-                            _DeleteBinary(data);
-                        }
-                        break;
-                    case JSONItem::ItemType::OBJECT:
-                        {
-                            auto data = _ObjectToBinary(item.toObject());
-                            auto type = JSONItem::ItemType::OBJECT;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + _GetBinarySize(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(data, _GetBinarySize(data));
-                            _DeleteBinary(data);
-                        }
-                        break;
-                    default:
-                        break;
+            static void Read(_JSON_Reader &reader, std::optional<_Ty> &value)
+            {
+                if (reader.literal("null")) {
+                    value.reset();
+                } else {
+                    _Binder<_Ty>::Read(reader, value.emplace());
+                }
+            }
+
+            static void Write(JSONWriter &writer, const std::optional<_Ty> &value)
+            {
+                if (value.has_value()) {
+                    _Binder<_Ty>::Write(writer, *value);
+                } else {
+                    writer.writeNull();
+                }
+            }
+        };
+
+        // Dynamic parts of a bound struct are kept as DOM values, built by the iterative reference parser.
+        template <>
+        struct _Binder<JSONItem>
+        {
+            static void Read(_JSON_Reader &reader, JSONItem &value)
+            {
+                value = reader.item();
+            }
+
+            static JSONObject ReadObject(_JSON_Reader &reader)
+            {
+                if (reader.peek() != '{') {
+                    reader.fail("JSON Object must begin with \'{\'");
                 }
-            };
+                return reader.item().takeObject();
+            }
 
-            // Array Binary Structure: [binary_size][[block_size][type][data]]...[end_block]
-            _Binary_Container container{};
+            static JSONArray ReadArray(_JSON_Reader &reader)
             {
-                pos_t binary_size = sizeof(pos_t);
-                container.add(std::addressof(binary_size), sizeof(binary_size));
+                if (reader.peek() != '[') {
+                    reader.fail("JSON Array must begin with \'[\'");
+                }
+                return reader.item().takeArray();
             }
-            for (const auto &item : array) {
-                addBlock(container, item);
+
+            static void Write(JSONWriter &writer, const JSONItem &value)
+            {
+                writer.write(value);
             }
-            container.add(std::addressof(npos), sizeof(npos));
-            *reinterpret_cast<pos_t*>(container.data()) = container.size();
-            return container.dump();
-        }
+        };
 
-        inline CU::JSONArray _BinaryToArray(const byte_t* binary)
+        template <>
+        struct _Binder<JSONArray>
         {
-            static const auto addItem = 
-                [](std::vector<JSONItem> &arrayData, const byte_t* binary, pos_t block_offset) -> pos_t 
+            static void Read(_JSON_Reader &reader, JSONArray &value)
             {
-                auto block_size = *reinterpret_cast<const pos_t*>(_Move_Ptr(binary, block_offset));
-                if (block_size == npos) {
-                    return npos;
-                }
-                auto type = *reinterpret_cast<const JSONItem::ItemType*>(_Move_Ptr(binary, (block_offset + sizeof(block_size))));
-                auto data = _Move_Ptr(binary, (block_offset + sizeof(block_size) + sizeof(type)));
-                switch (type) {
-                    case JSONItem::ItemType::ITEM_NULL:
-                        arrayData.emplace_back(nullptr);
-                        break;
-                    case JSONItem::ItemType::BOOLEAN:
-                        arrayData.emplace_back(*reinterpret_cast<const bool*>(data));
-                        break;
-                    case JSONItem::ItemType::INTEGER:
-                        arrayData.emplace_back(*reinterpret_cast<const int*>(data));
-                        break;
-                    case JSONItem::ItemType::LONG:
-                        arrayData.emplace_back(*reinterpret_cast<const int64_t*>(data));
-                        break;
-                    case JSONItem::ItemType::DOUBLE:
-                        arrayData.emplace_back(*reinterpret_cast<const double*>(data));
-                        break;
-                    case JSONItem::ItemType::STRING:
-                        arrayData.emplace_back(reinterpret_cast<const char*>(data));
-                        break;
-                    case JSONItem::ItemType::ARRAY:
-                        arrayData.emplace_back(_BinaryToArray(reinterpret_cast<const byte_t*>(data)));
-                        break;
-                    case JSONItem::ItemType::OBJECT:
-                        arrayData.emplace_back(_BinaryToObject(reinterpret_cast<const byte_t*>(data)));
-                        break;
-                    default:
-                        break;
-                }
-                return (block_offset + block_size);
-            };
+                value = _Binder<JSONItem>::ReadArray(reader);
+            }
 
-            std::vector<JSONItem> arrayData{};
-            pos_t size = _GetBinarySize(binary), offset = sizeof(pos_t);
-            while (offset < size) {
-                offset = addItem(arrayData, binary, offset);
+            static void Write(JSONWriter &writer, const JSONArray &value)
+            {
+                writer.write(value);
             }
-            return JSONArray(std::move(arrayData));
-        }
+        };
 
-        inline void SaveArray(const std::string &path, const JSONArray &array)
+        template <>
+        struct _Binder<JSONObject>
         {
-            auto fp = std::fopen(path.c_str(), "wb");
-            if (fp != nullptr) {
-                auto binary = _ArrayToBinary(array);
-                if (binary != nullptr) {
-                    std::fwrite(binary, sizeof(byte_t), _GetBinarySize(binary), fp);
-                    std::fflush(fp);
-                    _DeleteBinary(binary);
-                }
-                std::fclose(fp);
+            static void Read(_JSON_Reader &reader, JSONObject &value)
+            {
+                value = _Binder<JSONItem>::ReadObject(reader);
+            }
+
+            static void Write(JSONWriter &writer, const JSONObject &value)
+            {
+                writer.write(value);
             }
+        };
+
+        // Fields missing from jsonText keep their current value in value.
+        template <typename _Ty>
+        void Parse(std::string_view jsonText, _Ty &value)
+        {
+            _JSON_Reader reader(jsonText);
+            _Binder<_Ty>::Read(reader, value);
+            reader.finish();
         }
 
-        inline CU::JSONArray OpenArray(const std::string &path)
+        template <typename _Ty>
+        _Ty Parse(std::string_view jsonText)
         {
-            CU::JSONArray array{};
-            auto fp = std::fopen(path.c_str(), "rb");
-            if (fp != nullptr) {
-                pos_t binary_size = 0;
-                std::fread(std::addressof(binary_size), sizeof(binary_size), 1, fp);
-                auto buffer = reinterpret_cast<byte_t*>(std::malloc(binary_size));
-                if (buffer != nullptr) {
-                    std::rewind(fp);
-                    std::fread(buffer, sizeof(byte_t), binary_size, fp);
-                    array = _BinaryToArray(buffer);
-                    _DeleteBinary(buffer);
-                }
-                std::fclose(fp);
-            }
-            return array;
+            _Ty value{};
+            Parse(jsonText, value);
+            return value;
         }
 
-        inline byte_t* _ObjectToBinary(const JSONObject &object)
+        template <typename _Ty>
+        void Write(JSONWriter &writer, const _Ty &value)
         {
-            static const auto addBlock = [](_Binary_Container &container, const std::string &key, const JSONItem &item) {
-                switch (item.type()) {
-                    case JSONItem::ItemType::ITEM_NULL:
-                        {
-                            auto type = JSONItem::ItemType::ITEM_NULL;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1;
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(key.data(), (key.length() + 1));
-                        }
-                        break;
-                    case JSONItem::ItemType::BOOLEAN:
-                        {
-                            bool data = item;
-                            auto type = JSONItem::ItemType::BOOLEAN;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + sizeof(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(key.data(), (key.length() + 1));
-                            container.add(std::addressof(data), sizeof(data));
-                        }
-                        break;
-                    case JSONItem::ItemType::INTEGER:
-                        {
-                            int data = item;
-                            auto type = JSONItem::ItemType::INTEGER;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + sizeof(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(key.data(), (key.length() + 1));
-                            container.add(std::addressof(data), sizeof(data));
-                        }
-                        break;
-                    case JSONItem::ItemType::LONG:
-                        {
-                            int64_t data = item;
-                            auto type = JSONItem::ItemType::LONG;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + sizeof(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(key.data(), (key.length() + 1));
-                            container.add(std::addressof(data), sizeof(data));
-                        }
-                        break;
-                    case JSONItem::ItemType::DOUBLE:
-                        {
-                            double data = item;
-                            auto type = JSONItem::ItemType::DOUBLE;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + sizeof(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(key.data(), (key.length() + 1));
-                            container.add(std::addressof(data), sizeof(data));
-                        }
-                        break;
-                    case JSONItem::ItemType::STRING:
-                        {
-                            std::string data = item;
-                            auto type = JSONItem::ItemType::STRING;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + data.length() + 1;
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(key.data(), (key.length() + 1));
-                            container.add(data.data(), (data.length() + 1));
-                        }
-                        break;
-                    case JSONItem::ItemType::ARRAY:
-                        {
-                            auto data = _ArrayToBinary(item.toArray());
-                            auto type = JSONItem::ItemType::ARRAY;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + _GetBinarySize(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(key.data(), (key.length() + 1));
-                            container.add(data, _GetBinarySize(data));
-                            _DeleteBinary(data);
-                        }
-                        break;
-                    case JSONItem::ItemType::OBJECT:
-                        {
-                            auto data = _ObjectToBinary(item.toObject());
-                            auto type = JSONItem::ItemType::OBJECT;
-                            pos_t block_size = sizeof(type) + sizeof(pos_t) + key.length() + 1 + _GetBinarySize(data);
-                            container.add(std::addressof(block_size), sizeof(block_size));
-                            container.add(std::addressof(type), sizeof(type));
-                            container.add(key.data(), (key.length() + 1));
-                            container.add(data, _GetBinarySize(data));
-                            _DeleteBinary(data);
-                        }
-                        break;
-                    default:
-                        break;
-                }
+            _Binder<_Ty>::Write(writer, value);
+        }
+
+        template <typename _Ty>
+        std::string ToString(const _Ty &value)
+        {
+            std::string jsonText{};
+            {
+                JSONWriter writer(jsonText);
+                _Binder<_Ty>::Write(writer, value);
+            }
+            return jsonText;
+        }
+    }
+
+    inline JSONSchema::JSONSchema() : 
+        nodes_(), 
+        properties_(), 
+        root_(0)
+    { 
+        nodes_.push_back(Node_{typeAny_, false, false, 0.0, 0.0, npos_, 0, 0, 0, {}});
+    }
+
+    inline JSONSchema::JSONSchema(const JSONObject &schema) : JSONSchema()
+    {
+        root_ = compile_(schema);
+    }
+
+    inline JSONSchema::JSONSchema(std::string_view schemaText) : JSONSchema()
+    {
+        root_ = compile_(JSONObject(schemaText));
+    }
+
+    inline void JSONSchema::validate(const JSONItem &item) const
+    {
+        try {
+            check_(root_, item);
+        } catch (const Violation_ &violation) {
+            Throw_(violation);
+        }
+    }
+
+    inline void JSONSchema::validate(const JSONArray &array) const
+    {
+        try {
+            if (nodes_[root_].enumValues.empty()) {
+                CheckType_(nodes_[root_].types, typeArray_);
+                checkArray_(root_, array);
+            } else {
+                check_(root_, JSONItem(array));
+            }
+        } catch (const Violation_ &violation) {
+            Throw_(violation);
+        }
+    }
+
+    inline void JSONSchema::validate(const JSONObject &object) const
+    {
+        try {
+            if (nodes_[root_].enumValues.empty()) {
+                CheckType_(nodes_[root_].types, typeObject_);
+                checkObject_(root_, object);
+            } else {
+                check_(root_, JSONItem(object));
+            }
+        } catch (const Violation_ &violation) {
+            Throw_(violation);
+        }
+    }
+
+    inline bool JSONSchema::isValid(const JSONItem &item) const
+    {
+        try {
+            check_(root_, item);
+        } catch (const Violation_ &) {
+            return false;
+        }
+        return true;
+    }
+
+    inline JSONItem JSONSchema::parse(std::string_view jsonText) const
+    {
+        _JSON_Reader reader(jsonText);
+        JSONItem item{};
+        try {
+            parse_(root_, reader, item);
+        } catch (const Violation_ &violation) {
+            Throw_(violation);
+        }
+        reader.finish();
+        return item;
+    }
+
+    inline size_t JSONSchema::compile_(const JSONItem &schema)
+    {
+        if (schema.isObject()) {
+            return compile_(schema.asObject());
+        } else if (schema.isBoolean()) {
+            if (schema.toBoolean()) {
+                return 0;
+            }
+            nodes_.push_back(Node_{0, false, false, 0.0, 0.0, npos_, 0, 0, 0, {}});
+            return (nodes_.size() - 1);
+        }
+        throw JSONExcept("Invalid JSON schema");
+    }
+
+    inline size_t JSONSchema::compile_(const JSONObject &schema)
+    {
+        static const auto typeOf = [](const JSONItem &name) -> uint8_t {
+            static const std::pair<std::string_view, uint8_t> typeNames[] = {
+                {"null", typeNull_}, {"boolean", typeBoolean_}, {"integer", typeInteger_}, {"number", typeNumber_}, 
+                {"string", typeString_}, {"array", typeArray_}, {"object", typeObject_}
             };
+            if (name.isString()) {
+                for (const auto &[typeName, type] : typeNames) {
+                    if (name.asString() == typeName) {
+                        return type;
+                    }
+                }
+            }
+            throw JSONExcept("Invalid JSON schema");
+        };
+
+        static const auto toNumber = [](const JSONItem &item) -> double {
+            auto type = TypeOf_(item);
+            if (type != typeInteger_ && type != typeNumber_) {
+                throw JSONExcept("Invalid JSON schema");
+            }
+            return Number_(item);
+        };
+
+        auto pos = nodes_.size();
+        nodes_.push_back(Node_{typeAny_, false, false, 0.0, 0.0, npos_, 0, 0, 0, {}});
+        Node_ node{typeAny_, false, false, 0.0, 0.0, npos_, 0, 0, 0, {}};
+        std::vector<Property_> properties{};
+        const JSONArray* required = nullptr;
+        for (const auto &[key, value] : schema) {
+            if (key == "type") {
+                if (value.isArray()) {
+                    node.types = 0;
+                    for (const auto &name : value.asArray()) {
+                        node.types |= typeOf(name);
+                    }
+                } else {
+                    node.types = typeOf(value);
+                }
+            } else if (key == "enum") {
+                if (!value.isArray()) {
+                    throw JSONExcept("Invalid JSON schema");
+                }
+                for (const auto &enumValue : value.asArray()) {
+                    node.enumValues.push_back(enumValue);
+                }
+            } else if (key == "minimum") {
+                node.hasMinimum = true;
+                node.minimum = toNumber(value);
+            } else if (key == "maximum") {
+                node.hasMaximum = true;
+                node.maximum = toNumber(value);
+            } else if (key == "maxLength") {
+                if (TypeOf_(value) != typeInteger_ || toNumber(value) < 0) {
+                    throw JSONExcept("Invalid JSON schema");
+                }
+                node.maxLength = static_cast<size_t>(toNumber(value));
+            } else if (key == "properties") {
+                if (!value.isObject()) {
+                    throw JSONExcept("Invalid JSON schema");
+                }
+                for (const auto &[name, propertySchema] : value.asObject()) {
+                    properties.push_back(Property_{name, compile_(propertySchema), false});
+                }
+            } else if (key == "required") {
+                if (!value.isArray()) {
+                    throw JSONExcept("Invalid JSON schema");
+                }
+                required = std::addressof(value.asArray());
+            } else if (key == "items") {
+                node.items = compile_(value);
+            }
+        }
+        if (required != nullptr) {
+            for (const auto &name : *required) {
+                if (!name.isString()) {
+                    throw JSONExcept("Invalid JSON schema");
+                }
+                auto iter = std::find_if(properties.begin(), properties.end(), 
+                    [&name](const Property_ &property) { return (property.key == name.asString()); });
+                if (iter != properties.end()) {
+                    iter->required = true;
+                } else {
+                    properties.push_back(Property_{JSONKey(name.asString()), 0, true});
+                }
+            }
+        }
+        node.firstProperty = properties_.size();
+        node.propertyCount = properties.size();
+        properties_.insert(properties_.end(), properties.begin(), properties.end());
+        nodes_[pos] = std::move(node);
+        return pos;
+    }
 
-            // Object Binary Structure: [binary_size][[block_size][type][key][data]]...[end_block]
-            _Binary_Container container{};
-            {
-                pos_t binary_size = sizeof(pos_t);
-                container.add(std::addressof(binary_size), sizeof(binary_size));
+    inline size_t JSONSchema::propertyNode_(size_t node, const JSONKey &key) const noexcept
+    {
+        const auto &schemaNode = nodes_[node];
+        for (auto pos = schemaNode.firstProperty; pos < (schemaNode.firstProperty + schemaNode.propertyCount); pos++) {
+            if (properties_[pos].key == key) {
+                return properties_[pos].node;
             }
-            const auto &objectData = object.data();
-            const auto &objectOrder = object.order();
-            for (const auto &key : objectOrder) {
-                addBlock(container, key, objectData.at(key));
+        }
+        return 0;
+    }
+
+    inline void JSONSchema::check_(size_t node, const JSONItem &item) const
+    {
+        if (node == 0) {
+            return;
+        }
+        auto type = TypeOf_(item);
+        checkValue_(node, type, item);
+        if (type == typeObject_) {
+            checkObject_(node, item.asObject());
+        } else if (type == typeArray_) {
+            checkArray_(node, item.asArray());
+        }
+    }
+
+    inline void JSONSchema::checkArray_(size_t node, const JSONArray &array) const
+    {
+        auto items = nodes_[node].items;
+        if (items == 0) {
+            return;
+        }
+        size_t pos = 0;
+        for (const auto &item : array) {
+            try {
+                check_(items, item);
+            } catch (Violation_ &violation) {
+                violation.path.push_back(std::to_string(pos));
+                throw;
             }
-            container.add(std::addressof(npos), sizeof(npos));
-            *reinterpret_cast<pos_t*>(container.data()) = container.size();
-            return container.dump();
+            pos++;
         }
+    }
 
-        inline CU::JSONObject _BinaryToObject(const byte_t* binary)
-        {
-            static const auto addItem = [](
-                std::unordered_map<std::string, JSONItem> &objectData, 
-                std::vector<std::string> &objectOrder,
-                const byte_t* binary, 
-                pos_t block_offset
-            ) -> pos_t {
-                auto block_size = *reinterpret_cast<const pos_t*>(_Move_Ptr(binary, block_offset));
-                if (block_size == npos) {
-                    return npos;
+    inline void JSONSchema::checkObject_(size_t node, const JSONObject &object) const
+    {
+        const auto &schemaNode = nodes_[node];
+        for (auto pos = schemaNode.firstProperty; pos < (schemaNode.firstProperty + schemaNode.propertyCount); pos++) {
+            const auto &property = properties_[pos];
+            auto value = object.find(property.key);
+            if (value == nullptr) {
+                if (property.required) {
+                    Fail_(("missing required member \"" + property.key.str() + "\"").c_str());
                 }
-                auto type = *reinterpret_cast<const JSONItem::ItemType*>(_Move_Ptr(binary, (block_offset + sizeof(block_size))));
-                auto key = reinterpret_cast<const char*>(_Move_Ptr(binary, (block_offset + sizeof(block_size) + sizeof(type))));
-                auto key_size = std::strlen(key) + 1;
-                auto data = _Move_Ptr(binary, (block_offset + sizeof(block_size) + sizeof(type) + key_size));
-                switch (type) {
-                    case JSONItem::ItemType::ITEM_NULL:
-                        objectData.emplace(key, nullptr);
-                        objectOrder.emplace_back(key);
-                        break;
-                    case JSONItem::ItemType::BOOLEAN:
-                        objectData.emplace(key, *reinterpret_cast<const bool*>(data));
-                        objectOrder.emplace_back(key);
-                        break;
-                    case JSONItem::ItemType::INTEGER:
-                        objectData.emplace(key, *reinterpret_cast<const int*>(data));
-                        objectOrder.emplace_back(key);
-                        break;
-                    case JSONItem::ItemType::LONG:
-                        objectData.emplace(key, *reinterpret_cast<const int64_t*>(data));
-                        objectOrder.emplace_back(key);
-                        break;
-                    case JSONItem::ItemType::DOUBLE:
-                        objectData.emplace(key, *reinterpret_cast<const double*>(data));
-                        objectOrder.emplace_back(key);
-                        break;
-                    case JSONItem::ItemType::STRING:
-                        objectData.emplace(key, reinterpret_cast<const char*>(data));
-                        objectOrder.emplace_back(key);
-                        break;
-                    case JSONItem::ItemType::ARRAY:
-                        objectData.emplace(key, _BinaryToArray(reinterpret_cast<const byte_t*>(data)));
-                        objectOrder.emplace_back(key);
-                        break;
-                    case JSONItem::ItemType::OBJECT:
-                        objectData.emplace(key, _BinaryToObject(reinterpret_cast<const byte_t*>(data)));
-                        objectOrder.emplace_back(key);
-                        break;
-                    default:
-                        break;
+            } else if (property.node != 0) {
+                try {
+                    check_(property.node, *value);
+                } catch (Violation_ &violation) {
+                    violation.path.push_back(property.key.str());
+                    throw;
                 }
-                return (block_offset + block_size);
-            };
+            }
+        }
+    }
 
-            std::unordered_map<std::string, JSONItem> objectData{};
-            std::vector<std::string> objectOrder{};
-            pos_t size = _GetBinarySize(binary), offset = sizeof(pos_t);
-            while (offset < size) {
-                offset = addItem(objectData, objectOrder, binary, offset);
+    inline void JSONSchema::checkValue_(size_t node, uint8_t type, const JSONItem &item) const
+    {
+        const auto &schemaNode = nodes_[node];
+        CheckType_(schemaNode.types, type);
+        if (!schemaNode.enumValues.empty()) {
+            auto iter = std::find_if(schemaNode.enumValues.begin(), schemaNode.enumValues.end(), 
+                [&item](const JSONItem &value) { return Equal_(item, value); });
+            if (iter == schemaNode.enumValues.end()) {
+                Fail_("value is not one of enum");
+            }
+        }
+        if (type == typeInteger_ || type == typeNumber_) {
+            auto number = Number_(item);
+            if (schemaNode.hasMinimum && number < schemaNode.minimum) {
+                Fail_("value is less than minimum");
+            }
+            if (schemaNode.hasMaximum && number > schemaNode.maximum) {
+                Fail_("value is greater than maximum");
+            }
+        } else if (type == typeString_ && schemaNode.maxLength != npos_) {
+            const auto &text = item.asString();
+            size_t length = 0;
+            for (auto ch : text) {
+                if ((static_cast<uint8_t>(ch) & 0xC0) != 0x80) {
+                    length++;
+                }
+            }
+            if (length > schemaNode.maxLength) {
+                Fail_("string is longer than maxLength");
             }
-            return JSONObject(std::move(objectData), std::move(objectOrder));
         }
+    }
 
-        inline void SaveObject(const std::string &path, const JSONObject &object)
+    // Containers are type checked before their members are parsed, so a payload of the wrong shape 
+    // is rejected at its first bad value. Recursion follows the schema, unconstrained values below it 
+    // are handed to the iterative reference parser.
+    inline void JSONSchema::parse_(size_t node, _JSON_Reader &reader, JSONItem &item) const
+    {
+        if (node == 0) {
+            item = reader.item();
+            return;
+        }
+        const auto &schemaNode = nodes_[node];
+        switch (reader.peek()) {
+            case '{':
+                {
+                    CheckType_(schemaNode.types, typeObject_);
+                    JSONObject object{};
+                    reader.expect('{');
+                    if (!reader.consume('}')) {
+                        do {
+                            JSONKey key(reader.string());
+                            reader.expect(':');
+                            // The first value of a repeated key is kept like JSONObject(text) does, later 
+                            // ones are only checked for syntax and not against the schema.
+                            if (object.find(key) != nullptr) {
+                                reader.skip();
+                                continue;
+                            }
+                            JSONItem value{};
+                            try {
+                                parse_(propertyNode_(node, key), reader, value);
+                            } catch (Violation_ &violation) {
+                                violation.path.push_back(key.str());
+                                throw;
+                            }
+                            object.add(key, std::move(value));
+                        } while (reader.consume(','));
+                        reader.expect('}');
+                    }
+                    for (auto pos = schemaNode.firstProperty; pos < (schemaNode.firstProperty + schemaNode.propertyCount); pos++) {
+                        if (properties_[pos].required && object.find(properties_[pos].key) == nullptr) {
+                            Fail_(("missing required member \"" + properties_[pos].key.str() + "\"").c_str());
+                        }
+                    }
+                    item = std::move(object);
+                }
+                break;
+            case '[':
+                {
+                    CheckType_(schemaNode.types, typeArray_);
+                    JSONArray array{};
+                    reader.expect('[');
+                    if (!reader.consume(']')) {
+                        do {
+                            JSONItem value{};
+                            try {
+                                parse_(schemaNode.items, reader, value);
+                            } catch (Violation_ &violation) {
+                                violation.path.push_back(std::to_string(array.size()));
+                                throw;
+                            }
+                            array.add(std::move(value));
+                        } while (reader.consume(','));
+                        reader.expect(']');
+                    }
+                    item = std::move(array);
+                }
+                break;
+            default:
+                item = reader.scalar();
+                break;
+        }
+        checkValue_(node, TypeOf_(item), item);
+    }
+
+    inline uint8_t JSONSchema::TypeOf_(const JSONItem &item) noexcept
+    {
+        switch (item.type()) {
+            case JSONItem::ItemType::ITEM_NULL:
+                return typeNull_;
+            case JSONItem::ItemType::BOOLEAN:
+                return typeBoolean_;
+            case JSONItem::ItemType::INTEGER:
+            case JSONItem::ItemType::LONG:
+                return typeInteger_;
+            case JSONItem::ItemType::DOUBLE:
+                {
+                    auto value = item.toDouble();
+                    if (value >= -9.0e18 && value <= 9.0e18 && static_cast<double>(static_cast<int64_t>(value)) == value) {
+                        return typeInteger_;
+                    }
+                }
+                return typeNumber_;
+            case JSONItem::ItemType::STRING:
+                return typeString_;
+            case JSONItem::ItemType::ARRAY:
+                return typeArray_;
+            case JSONItem::ItemType::OBJECT:
+                return typeObject_;
+        }
+        return typeNull_;
+    }
+
+    // Numbers compare by value, 1 and 1.0 are the same enum member.
+    inline bool JSONSchema::Equal_(const JSONItem &item, const JSONItem &value)
+    {
+        auto itemType = TypeOf_(item), valueType = TypeOf_(value);
+        if ((itemType == typeInteger_ || itemType == typeNumber_) && (valueType == typeInteger_ || valueType == typeNumber_)) {
+            return (Number_(item) == Number_(value));
+        }
+        return (item == value);
+    }
+
+    inline double JSONSchema::Number_(const JSONItem &item)
+    {
+        return (item.isDouble() ? item.toDouble() : static_cast<double>(item.isLong() ? item.toLong() : item.toInt()));
+    }
+
+    // "number" accepts integers too.
+    inline void JSONSchema::CheckType_(uint8_t types, uint8_t type)
+    {
+        if ((types & type) == 0 && !(type == typeInteger_ && (types & typeNumber_) != 0)) {
+            Fail_("value is not of the expected type");
+        }
+    }
+
+    inline void JSONSchema::Fail_(const char* message)
+    {
+        throw Violation_{{}, message};
+    }
+
+    inline void JSONSchema::Throw_(const Violation_ &violation)
+    {
+        std::string path{};
+        for (auto iter = violation.path.rbegin(); iter != violation.path.rend(); iter++) {
+            JSONPatch::_AppendPointer(path, *iter);
+        }
+        if (path.empty()) {
+            throw JSONExcept("JSON schema violation: " + violation.message);
+        }
+        throw JSONExcept("JSON schema violation at " + path + ": " + violation.message);
+    }
+
+    class JSONBinaryJournal
+    {
+        public:
+            typedef std::vector<std::string> Path;
+
+            inline JSONBinaryJournal();
+            inline JSONBinaryJournal(const std::string &path);
+            inline ~JSONBinaryJournal();
+
+            JSONBinaryJournal(const JSONBinaryJournal &other) = delete;
+            JSONBinaryJournal &operator=(const JSONBinaryJournal &other) = delete;
+
+            inline void open(const std::string &path);
+            inline void close();
+            inline bool isOpen() const;
+
+            inline void set(std::string_view key, const JSONItem &value);
+            inline void set(const Path &path, const JSONItem &value);
+            inline void remove(std::string_view key);
+            inline void remove(const Path &path);
+            inline void flush();
+            inline void compact(int level = JSONBinary::defaultLevel);
+
+            inline const JSONObject &object() const;
+            inline size_t records() const;
+
+        private:
+            enum class RecordType : uint8_t {SNAPSHOT, SET, REMOVE};
+
+            static constexpr char magic_[4] = {'C', 'U', 'J', 'L'};
+            static constexpr uint8_t version_ = 1;
+            static constexpr size_t headerSize_ = 5;
+            static constexpr size_t recordHeaderSize_ = 8;
+            static constexpr size_t bufferSize_ = 1024 * 1024;
+
+            std::string path_;
+            std::FILE* fp_;
+            JSONObject object_;
+            size_t records_;
+            std::string buffer_;
+
+            inline static uint32_t Checksum_(const char* data, size_t size, uint32_t hash = 2166136261U);
+            inline static void AppendRecord_(std::string &buffer, RecordType type, std::string_view payload);
+            inline static std::FILE* OpenAppend_(const std::string &path);
+            inline static bool Sync_(std::FILE* fp);
+
+            inline JSONObject* walk_(const Path &path, bool create);
+            inline void apply_(RecordType type, std::string_view payload);
+            template <typename _Apply>
+            inline void append_(RecordType type, const std::string &payload, _Apply &&apply);
+            inline bool write_();
+    };
+
+    inline JSONBinaryJournal::JSONBinaryJournal() : path_(), fp_(nullptr), object_(), records_(0), buffer_() { }
+
+    inline JSONBinaryJournal::JSONBinaryJournal(const std::string &path) : 
+        path_(), 
+        fp_(nullptr), 
+        object_(), 
+        records_(0), 
+        buffer_()
+    {
+        open(path);
+    }
+
+    // Records that cannot be written are dropped here, close() reports them.
+    inline JSONBinaryJournal::~JSONBinaryJournal()
+    {
+        try {
+            close();
+        } catch (const JSONExcept &) { }
+    }
+
+    inline void JSONBinaryJournal::open(const std::string &path)
+    {
+        close();
+        std::error_code ec{};
+        if (!std::filesystem::exists(path, ec)) {
+            path_ = path;
+            compact(0);
+            return;
+        }
+
+        size_t validSize = 0, fileSize = 0;
         {
-            auto fp = std::fopen(path.c_str(), "wb");
-            if (fp != nullptr) {
-                auto binary = _ObjectToBinary(object);
-                if (binary != nullptr) {
-                    std::fwrite(binary, sizeof(byte_t), _GetBinarySize(binary), fp);
-                    std::fflush(fp);
-                    _DeleteBinary(binary);
+            _JSON_Mapped_File file{};
+            if (!file.open(path)) {
+                throw JSONExcept("Failed to open file");
+            }
+            auto binary = file.view();
+            fileSize = binary.size();
+            if (binary.size() < headerSize_ || std::memcmp(binary.data(), magic_, sizeof(magic_)) != 0) {
+                throw JSONExcept("Invalid binary data");
+            }
+            if (static_cast<uint8_t>(binary[sizeof(magic_)]) != version_) {
+                throw JSONExcept("Unsupported binary version");
+            }
+            // A record torn by an interrupted write ends the log, it is cut off before appending again.
+            size_t pos = headerSize_;
+            while ((binary.size() - pos) >= recordHeaderSize_) {
+                uint32_t payloadSize = 0, checksum = 0;
+                std::memcpy(std::addressof(payloadSize), (binary.data() + pos), sizeof(payloadSize));
+                std::memcpy(std::addressof(checksum), (binary.data() + pos + 4), sizeof(checksum));
+                if (payloadSize == 0 || payloadSize > (binary.size() - pos - recordHeaderSize_)) {
+                    break;
                 }
-                std::fclose(fp);
+                auto payload = binary.substr((pos + recordHeaderSize_), payloadSize);
+                if (Checksum_(payload.data(), payload.size()) != checksum) {
+                    break;
+                }
+                auto type = static_cast<RecordType>(payload[0]);
+                try {
+                    if (pos == headerSize_ && type != RecordType::SNAPSHOT) {
+                        throw JSONExcept("Invalid binary data");
+                    }
+                    apply_(type, payload.substr(1));
+                } catch (...) {
+                    object_.clear();
+                    records_ = 0;
+                    throw;
+                }
+                pos += recordHeaderSize_ + payloadSize;
             }
+            if (pos == headerSize_) {
+                throw JSONExcept("Invalid binary data");
+            }
+            validSize = pos;
+        }
+        if (validSize < fileSize) {
+            std::error_code ec{};
+            std::filesystem::resize_file(path, validSize, ec);
+            if (ec) {
+                object_.clear();
+                records_ = 0;
+                throw JSONExcept("Failed to write file");
+            }
+        }
+        fp_ = OpenAppend_(path);
+        if (fp_ == nullptr) {
+            throw JSONExcept("Failed to open file");
         }
+        path_ = path;
+    }
 
-        inline CU::JSONObject OpenObject(const std::string &path)
-        {
-            CU::JSONObject object{};
-            auto fp = std::fopen(path.c_str(), "rb");
-            if (fp != nullptr) {
-                pos_t binary_size = 0;
-                std::fread(std::addressof(binary_size), sizeof(binary_size), 1, fp);
-                auto buffer = reinterpret_cast<byte_t*>(std::malloc(binary_size));
-                if (buffer != nullptr) {
-                    std::rewind(fp);
-                    std::fread(buffer, sizeof(byte_t), binary_size, fp);
-                    object = _BinaryToObject(buffer);
-                    _DeleteBinary(buffer);
+    // The journal is closed even when the pending records cannot be written.
+    inline void JSONBinaryJournal::close()
+    {
+        auto written = true;
+        if (fp_ != nullptr) {
+            written = write_();
+            std::fclose(fp_);
+            fp_ = nullptr;
+        }
+        path_.clear();
+        object_.clear();
+        records_ = 0;
+        buffer_.clear();
+        if (!written) {
+            throw JSONExcept("Failed to write file");
+        }
+    }
+
+    inline bool JSONBinaryJournal::isOpen() const
+    {
+        return (fp_ != nullptr);
+    }
+
+    inline void JSONBinaryJournal::set(std::string_view key, const JSONItem &value)
+    {
+        set(Path{std::string(key)}, value);
+    }
+
+    inline void JSONBinaryJournal::set(const Path &path, const JSONItem &value)
+    {
+        if (path.empty()) {
+            throw JSONExcept("Key not found");
+        }
+        std::string payload{};
+        JSONBinary::_PutVarint(payload, path.size());
+        for (const auto &key : path) {
+            JSONBinary::_PutVarint(payload, key.size());
+            payload.append(key);
+        }
+        JSONBinary::_Compact_Encoder(payload).encode(value);
+        walk_(path, false);
+        append_(RecordType::SET, payload, [&] { (*walk_(path, true))[path.back()] = value; });
+    }
+
+    inline void JSONBinaryJournal::remove(std::string_view key)
+    {
+        remove(Path{std::string(key)});
+    }
+
+    inline void JSONBinaryJournal::remove(const Path &path)
+    {
+        if (path.empty()) {
+            throw JSONExcept("Key not found");
+        }
+        auto object = walk_(path, false);
+        if (object == nullptr) {
+            throw JSONExcept("Key not found");
+        }
+        std::string payload{};
+        JSONBinary::_PutVarint(payload, path.size());
+        for (const auto &key : path) {
+            JSONBinary::_PutVarint(payload, key.size());
+            payload.append(key);
+        }
+        append_(RecordType::REMOVE, payload, [&] { object->remove(path.back()); });
+    }
+
+    // Records that fail to write stay pending, the file is cut back to the last whole record.
+    inline void JSONBinaryJournal::flush()
+    {
+        if (!write_()) {
+            throw JSONExcept("Failed to write file");
+        }
+    }
+
+    // The snapshot is written to a temporary file and synced to the device, then renamed over the journal, 
+    // pending records are flushed before so a failed compaction loses nothing.
+    inline void JSONBinaryJournal::compact(int level)
+    {
+        if (path_.empty()) {
+            throw JSONExcept("Failed to open file");
+        }
+        flush();
+        std::string binary(magic_, sizeof(magic_));
+        binary.push_back(static_cast<char>(version_));
+        AppendRecord_(binary, RecordType::SNAPSHOT, JSONBinary::ToCompressedBinary(object_, level));
+
+        auto tmpPath = path_ + ".tmp";
+        auto fp = std::fopen(tmpPath.c_str(), "wb");
+        if (fp == nullptr) {
+            throw JSONExcept("Failed to open file");
+        }
+        auto len = std::fwrite(binary.data(), sizeof(char), binary.size(), fp);
+        auto synced = Sync_(fp);
+        std::fclose(fp);
+        if (len != binary.size() || !synced) {
+            std::remove(tmpPath.c_str());
+            throw JSONExcept("Failed to write file");
+        }
+        if (fp_ != nullptr) {
+            std::fclose(fp_);
+            fp_ = nullptr;
+        }
+        std::error_code ec{};
+        std::filesystem::rename(tmpPath, path_, ec);
+        fp_ = OpenAppend_(path_);
+        if (ec) {
+            std::remove(tmpPath.c_str());
+            throw JSONExcept("Failed to write file");
+        }
+        if (fp_ == nullptr) {
+            throw JSONExcept("Failed to open file");
+        }
+        records_ = 0;
+    }
+
+    inline const JSONObject &JSONBinaryJournal::object() const
+    {
+        return object_;
+    }
+
+    inline size_t JSONBinaryJournal::records() const
+    {
+        return records_;
+    }
+
+    // FNV-1a
+    inline uint32_t JSONBinaryJournal::Checksum_(const char* data, size_t size, uint32_t hash)
+    {
+        for (size_t idx = 0; idx < size; idx++) {
+            hash ^= static_cast<uint8_t>(data[idx]);
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+    inline void JSONBinaryJournal::AppendRecord_(std::string &buffer, RecordType type, std::string_view payload)
+    {
+        if (payload.size() >= std::numeric_limits<uint32_t>::max()) {
+            throw JSONExcept("Failed to write file");
+        }
+        auto payloadSize = static_cast<uint32_t>(payload.size() + 1);
+        auto typeChar = static_cast<char>(type);
+        auto checksum = Checksum_(payload.data(), payload.size(), Checksum_(std::addressof(typeChar), 1));
+        buffer.append(reinterpret_cast<const char*>(std::addressof(payloadSize)), sizeof(payloadSize));
+        buffer.append(reinterpret_cast<const char*>(std::addressof(checksum)), sizeof(checksum));
+        buffer.push_back(typeChar);
+        buffer.append(payload.data(), payload.size());
+    }
+
+    // Records are buffered by the journal, so the stream is unbuffered and every write reaches the file.
+    inline std::FILE* JSONBinaryJournal::OpenAppend_(const std::string &path)
+    {
+        auto fp = std::fopen(path.c_str(), "ab");
+        if (fp != nullptr) {
+            std::setvbuf(fp, nullptr, _IONBF, 0);
+        }
+        return fp;
+    }
+
+    inline bool JSONBinaryJournal::Sync_(std::FILE* fp)
+    {
+        if (std::fflush(fp) != 0) {
+            return false;
+        }
+#if defined(_CU_JSON_MMAP_)
+        return (::fsync(::fileno(fp)) == 0);
+#elif defined(_WIN32)
+        return (::_commit(::_fileno(fp)) == 0);
+#else
+        return true;
+#endif
+    }
+
+    // Returns the object holding the last key of path, creating missing objects on the way when create is set.
+    inline JSONObject* JSONBinaryJournal::walk_(const Path &path, bool create)
+    {
+        auto object = std::addressof(object_);
+        for (size_t idx = 0; (idx + 1) < path.size(); idx++) {
+            const auto &key = path[idx];
+            if (!object->contains(key)) {
+                if (!create) {
+                    return nullptr;
                 }
-                std::fclose(fp);
+                object->add(key, JSONObject());
             }
-            return object;
+            object = std::addressof((*object)[key].asObject());
+        }
+        return object;
+    }
+
+    inline void JSONBinaryJournal::apply_(RecordType type, std::string_view payload)
+    {
+        if (type == RecordType::SNAPSHOT) {
+            object_ = JSONBinary::_Compact_Decoder(JSONBinary::_Decompress(payload.data(), payload.size())).decodeObject();
+            records_ = 0;
+            return;
+        }
+        auto ptr = payload.data(), end = payload.data() + payload.size();
+        auto count = JSONBinary::_GetVarint(ptr, end);
+        if (count == 0 || count > payload.size()) {
+            throw JSONExcept("Invalid binary data");
+        }
+        Path path{};
+        for (uint64_t idx = 0; idx < count; idx++) {
+            auto len = JSONBinary::_GetVarint(ptr, end);
+            if (len > static_cast<uint64_t>(end - ptr)) {
+                throw JSONExcept("Invalid binary data");
+            }
+            path.emplace_back(ptr, len);
+            ptr += len;
+        }
+        if (type == RecordType::SET) {
+            auto value = JSONBinary::_Compact_Decoder(std::string_view(ptr, (end - ptr))).decodeItem();
+            (*walk_(path, true))[path.back()] = value;
+        } else if (type == RecordType::REMOVE) {
+            auto object = walk_(path, false);
+            if (object != nullptr && object->contains(path.back())) {
+                object->remove(path.back());
+            }
+        } else {
+            throw JSONExcept("Invalid binary data");
+        }
+        records_++;
+    }
+
+    // The record is buffered before apply changes the object and dropped again if apply throws, 
+    // so the object never holds a change the journal does not.
+    template <typename _Apply>
+    inline void JSONBinaryJournal::append_(RecordType type, const std::string &payload, _Apply &&apply)
+    {
+        if (fp_ == nullptr) {
+            throw JSONExcept("Failed to open file");
+        }
+        auto size = buffer_.size();
+        AppendRecord_(buffer_, type, payload);
+        try {
+            apply();
+        } catch (...) {
+            buffer_.resize(size);
+            throw;
+        }
+        records_++;
+        if (buffer_.size() >= bufferSize_) {
+            flush();
+        }
+    }
+
+    // Writes the buffered records, a failed write is cut off the file again and the records stay buffered.
+    inline bool JSONBinaryJournal::write_()
+    {
+        if (fp_ == nullptr || buffer_.empty()) {
+            return true;
+        }
+        std::error_code ec{};
+        auto size = std::filesystem::file_size(path_, ec);
+        if (ec) {
+            return false;
         }
+        auto len = std::fwrite(buffer_.data(), sizeof(char), buffer_.size(), fp_);
+        if (len != buffer_.size() || std::fflush(fp_) != 0) {
+            std::clearerr(fp_);
+            std::filesystem::resize_file(path_, size, ec);
+            return false;
+        }
+        buffer_.clear();
+        return true;
     }
 }
 
 namespace std
 {
+    template <>
+    struct hash<CU::JSONKey>
+    {
+        size_t operator()(const CU::JSONKey &val) const
+        {
+            return val.hash();
+        }
+    };
+
     template <>
     struct hash<CU::JSONItem>
     {
@@ -0,0 +1,124 @@
+// Read-only traversal and dismantling of a parsed tree, through the copying accessors
+// (toArray / toObject / toString) and through the reference and move-out accessors.
+//     g++ -std=c++17 -O2 -I.. AccessorBenchmark.cpp -o AccessorBenchmark -lpthread
+//     ./AccessorBenchmark [records] [reps]
+
+#include "BenchmarkUtils.h"
+#include <cstdlib>
+
+using namespace CU;
+
+// Counts nodes and string bytes, every container and string is copied on the way.
+static size_t WalkCopy(const JSONItem &item)
+{
+    size_t count = 1;
+    if (item.isArray()) {
+        auto array = item.toArray();
+        for (const auto &element : array) {
+            count += WalkCopy(element);
+        }
+    } else if (item.isObject()) {
+        auto object = item.toObject();
+        for (const auto &member : object) {
+            count += WalkCopy(member.value);
+        }
+    } else if (item.isString()) {
+        count += item.toString().size();
+    }
+    return count;
+}
+
+static size_t WalkReference(const JSONItem &item)
+{
+    size_t count = 1;
+    if (item.isArray()) {
+        for (const auto &element : item.asArray()) {
+            count += WalkReference(element);
+        }
+    } else if (item.isObject()) {
+        for (const auto &member : item.asObject()) {
+            count += WalkReference(member.value);
+        }
+    } else if (item.isString()) {
+        count += item.asString().size();
+    }
+    return count;
+}
+
+// Collects every string of the tree, copying them or moving them out.
+static void CollectCopy(const JSONItem &item, std::vector<std::string> &strings)
+{
+    if (item.isArray()) {
+        for (const auto &element : item.toArray()) {
+            CollectCopy(element, strings);
+        }
+    } else if (item.isObject()) {
+        for (const auto &member : item.toObject()) {
+            CollectCopy(member.value, strings);
+        }
+    } else if (item.isString()) {
+        strings.emplace_back(item.toString());
+    }
+}
+
+static void CollectTake(JSONItem &item, std::vector<std::string> &strings)
+{
+    if (item.isArray()) {
+        auto array = item.takeArray();
+        for (auto &element : array) {
+            CollectTake(element, strings);
+        }
+    } else if (item.isObject()) {
+        auto object = item.takeObject();
+        for (const auto &member : object) {
+            CollectTake(object[member.key], strings);
+        }
+    } else if (item.isString()) {
+        strings.emplace_back(item.takeString());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t records = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 3000;
+    size_t reps = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 20;
+
+    JSONItem root = JSONObject(JSONBenchmark::MakeDocument(records));
+    std::printf("tree: %zu records\n", records);
+
+    // Both ways must see the same tree.
+    auto copied = root;
+    std::vector<std::string> copiedStrings{}, takenStrings{};
+    CollectCopy(root, copiedStrings);
+    CollectTake(copied, takenStrings);
+    if (WalkCopy(root) != WalkReference(root) || copiedStrings != takenStrings) {
+        std::printf("traversals differ\n");
+        return 1;
+    }
+
+    auto copyTime = JSONBenchmark::MinTime(reps, [&] {
+        return WalkCopy(root);
+    });
+    auto referenceTime = JSONBenchmark::MinTime(reps, [&] {
+        return WalkReference(root);
+    });
+    std::printf("%-36s %9.3f ms\n", "walk with toArray / toObject", copyTime);
+    std::printf("%-36s %9.3f ms (%.1fx)\n", "walk with asArray / asObject", referenceTime, copyTime / referenceTime);
+
+    // Dismantling consumes the tree, so each run works on a fresh copy made outside the measured time.
+    std::vector<JSONItem> copies(reps, root);
+    size_t next = 0;
+    auto collectCopyTime = JSONBenchmark::MinTime(reps, [&] {
+        std::vector<std::string> strings{};
+        CollectCopy(root, strings);
+        return strings;
+    });
+    auto collectTakeTime = JSONBenchmark::MinTime(reps, [&] {
+        std::vector<std::string> strings{};
+        CollectTake(copies[next++], strings);
+        return strings;
+    });
+    std::printf("%-36s %9.3f ms\n", "collect strings by copy", collectCopyTime);
+    std::printf("%-36s %9.3f ms (%.1fx)\n", "collect strings with take*", collectTakeTime, collectCopyTime / collectTakeTime);
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Shared helpers of the CuJSONObject benchmarks, each benchmark is a standalone program.
+// Build from this directory, for example:
+//     g++ -std=c++17 -O2 -march=native -I.. ParseBenchmark.cpp -o ParseBenchmark -lpthread
+
+#if !defined(_CU_JSON_BENCHMARK_)
+#define _CU_JSON_BENCHMARK_ 1
+
+#include "CuJSONObject.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace JSONBenchmark
+{
+    // xorshift64, documents only depend on the seed.
+    class Random
+    {
+        public:
+            explicit Random(uint64_t seed) : state_(seed * 2654435761U + 1) { }
+
+            uint64_t next()
+            {
+                state_ ^= state_ << 13;
+                state_ ^= state_ >> 7;
+                state_ ^= state_ << 17;
+                return state_;
+            }
+
+            size_t below(size_t bound)
+            {
+                return static_cast<size_t>(next() % bound);
+            }
+
+        private:
+            uint64_t state_;
+    };
+
+    inline std::string MakeWord(Random &random, size_t maxLength)
+    {
+        std::string word{};
+        auto length = 1 + random.below(maxLength);
+        for (size_t idx = 0; idx < length; idx++) {
+            word.push_back(static_cast<char>('a' + random.below(26)));
+        }
+        return word;
+    }
+
+    // A telemetry-like record: strings with escapes, integers, doubles, literals and nested containers.
+    inline std::string MakeRecord(Random &random, size_t id)
+    {
+        std::string record = "{\"id\": " + std::to_string(id);
+        record += ", \"host\": \"" + MakeWord(random, 12) + ".example.com\"";
+        record += ", \"message\": \"" + MakeWord(random, 24) + " \\\"" + MakeWord(random, 8) + "\\\"\\n\\u00e9 " + MakeWord(random, 40) + "\"";
+        record += ", \"latency\": " + std::to_string(random.below(1000000) / 1000.0);
+        record += ", \"bytes\": " + std::to_string(random.next() >> 24);
+        record += ", \"ok\": " + std::string(random.below(2) ? "true" : "false");
+        record += ", \"parent\": null";
+        record += ", \"tags\": [";
+        for (size_t idx = 0, count = random.below(6); idx < count; idx++) {
+            record += (idx == 0 ? "\"" : ", \"") + MakeWord(random, 10) + "\"";
+        }
+        record += "], \"metrics\": {";
+        for (size_t idx = 0, count = 2 + random.below(6); idx < count; idx++) {
+            record += (idx == 0 ? "\"" : ", \"") + MakeWord(random, 10) + std::to_string(idx) + "\": ";
+            record += std::to_string(static_cast<int>(random.below(200000)) - 100000);
+        }
+        record += "}}";
+        return record;
+    }
+
+    // {"service": ..., "records": [record, ...]}, about 400 bytes per record.
+    inline std::string MakeDocument(size_t records, uint64_t seed = 1)
+    {
+        Random random(seed);
+        std::string document = "{\n    \"service\": \"benchmark\",\n    \"version\": 3,\n    \"records\": [\n";
+        for (size_t idx = 0; idx < records; idx++) {
+            document += "        " + MakeRecord(random, idx) + ((idx + 1) < records ? ",\n" : "\n");
+        }
+        document += "    ]\n}\n";
+        return document;
+    }
+
+    // Runs func reps times and returns the fastest run in milliseconds, 
+    // the value func returns is destroyed outside the measured time.
+    template <typename _Func>
+    inline double MinTime(size_t reps, _Func &&func)
+    {
+        auto best = 1e300;
+        for (size_t rep = 0; rep < reps; rep++) {
+            auto begin = std::chrono::steady_clock::now();
+            auto result = func();
+            auto end = std::chrono::steady_clock::now();
+            (void)result;
+            auto elapsed = std::chrono::duration<double, std::milli>(end - begin).count();
+            if (elapsed < best) {
+                best = elapsed;
+            }
+        }
+        return best;
+    }
+
+    // Keeps values alive so the compiler cannot drop the measured work.
+    inline void Consume(size_t value)
+    {
+        static volatile size_t sink = 0;
+        sink = sink + value;
+    }
+}
+
+#endif // !defined(_CU_JSON_BENCHMARK_)
@@ -0,0 +1,123 @@
+// Two-stage parser of JSONParser (structural index, then tree building) against the reference
+// parser of JSONObject(text), which walks the text one character at a time, on accepted and rejected input.
+//     g++ -std=c++17 -O2 -march=native -I.. ParseBenchmark.cpp -o ParseBenchmark -lpthread
+//     ./ParseBenchmark [records] [reps]
+
+#include "BenchmarkUtils.h"
+#include <cstdlib>
+
+using namespace CU;
+
+// Long strings and numbers, where scanning the text outweighs building the tree.
+static std::string MakeFlatDocument(size_t records, uint64_t seed = 2)
+{
+    JSONBenchmark::Random random(seed);
+    std::string document = "{\"lines\": [";
+    for (size_t idx = 0; idx < records; idx++) {
+        document += (idx == 0) ? "\n    \"" : ",\n    \"";
+        for (size_t word = 0, count = 10 + random.below(30); word < count; word++) {
+            document += JSONBenchmark::MakeWord(random, 10) + ((word + 1) < count ? " " : "");
+        }
+        document += "\"";
+    }
+    document += "\n], \"samples\": [";
+    for (size_t idx = 0; idx < (records * 10); idx++) {
+        document += ((idx == 0) ? "" : ", ") + std::to_string(random.below(100000000));
+    }
+    document += "]}\n";
+    return document;
+}
+
+static std::string ParseError(std::string_view jsonText, JSONParser* parser)
+{
+    try {
+        if (parser != nullptr) {
+            parser->parseObject(jsonText);
+        } else {
+            JSONObject object(jsonText);
+        }
+    } catch (const JSONExcept &e) {
+        return e.what();
+    }
+    return "no error";
+}
+
+static void Print(const char* name, double time, double megabytes)
+{
+    std::printf("    %-34s %9.3f ms %9.1f MB/s\n", name, time, megabytes / (time / 1000.0));
+}
+
+static bool Run(const char* name, const std::string &document, size_t reps)
+{
+    auto megabytes = document.size() / (1024.0 * 1024.0);
+    std::printf("%s: %.2f MB\n", name, megabytes);
+
+    // Both parsers must build the same tree and report the same errors.
+    JSONParser parser{};
+    if (parser.parseObject(document).toString() != JSONObject(document).toString()) {
+        std::printf("trees differ\n");
+        return false;
+    }
+    for (auto cut : {document.size() / 3, document.size() / 2, document.size() - 3}) {
+        auto truncated = std::string_view(document).substr(0, cut);
+        if (ParseError(truncated, &parser) != ParseError(truncated, nullptr)) {
+            std::printf("errors differ at %zu\n", cut);
+            return false;
+        }
+    }
+
+    auto referenceTime = JSONBenchmark::MinTime(reps, [&] {
+        return JSONObject(document);
+    });
+    auto indexedTime = JSONBenchmark::MinTime(reps, [&] {
+        return parser.parseObject(document);
+    });
+    _JSON_Parse_Utils::StructuralIndex index{};
+    auto scanTime = JSONBenchmark::MinTime(reps, [&] {
+        index.build(document);
+        return index.usable(document);
+    });
+
+    // Cut before the closing brackets, the whole text is read before the error is found.
+    auto truncated = std::string_view(document).substr(0, document.size() - 3);
+    auto rejectedReferenceTime = JSONBenchmark::MinTime(reps, [&] {
+        return ParseError(truncated, nullptr);
+    });
+    auto rejectedIndexedTime = JSONBenchmark::MinTime(reps, [&] {
+        return ParseError(truncated, &parser);
+    });
+
+    Print("JSONObject(text)", referenceTime, megabytes);
+    Print("JSONParser::parseObject", indexedTime, megabytes);
+    Print("  of which structural scan", scanTime, megabytes);
+    Print("rejected, JSONObject(text)", rejectedReferenceTime, megabytes);
+    Print("rejected, JSONParser::parseObject", rejectedIndexedTime, megabytes);
+    std::printf("    speedup: %.2fx, on rejected input: %.2fx\n", 
+        referenceTime / indexedTime, rejectedReferenceTime / rejectedIndexedTime);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t records = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    size_t reps = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 20;
+
+#if defined(_CU_JSON_AVX2_)
+    std::printf("structural scan: AVX2\n");
+#elif defined(_CU_JSON_SSE2_)
+    std::printf("structural scan: SSE2\n");
+#elif defined(_CU_JSON_NEON_)
+    std::printf("structural scan: NEON\n");
+#else
+    std::printf("structural scan: scalar\n");
+#endif
+
+    // Trees and errors are compared before timing, parsing is timed without freeing the result.
+    if (!Run("records", JSONBenchmark::MakeDocument(records), reps)) {
+        return 1;
+    }
+    if (!Run("strings and numbers", MakeFlatDocument(records), reps)) {
+        return 1;
+    }
+    return 0;
+}
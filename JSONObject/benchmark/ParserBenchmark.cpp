@@ -0,0 +1,149 @@
+// Heap allocations and time per parse of small, similarly shaped messages, with a fresh
+// JSONObject / JSONDocument each time and with a reused JSONParser.
+//     g++ -std=c++17 -O2 -I.. ParserBenchmark.cpp -o ParserBenchmark -lpthread
+//     ./ParserBenchmark [messages] [reps]
+
+#include "BenchmarkUtils.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+using namespace CU;
+
+// Every operator new of the program is counted, malloc calls made directly are not.
+// All replaceable forms are replaced, so every new is paired with a delete of the same family.
+static std::atomic<size_t> allocations{0};
+
+// Over-aligned blocks keep the pointer returned by malloc right before them.
+static void* Allocate(size_t size, size_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    size = (size > 0) ? size : 1;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return std::malloc(size);
+    }
+    auto raw = std::malloc(size + alignment + sizeof(void*));
+    if (raw == nullptr) {
+        return nullptr;
+    }
+    auto aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + alignment - 1) & ~(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+static void* AllocateOrThrow(size_t size, size_t alignment)
+{
+    auto ptr = Allocate(size, alignment);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+// Kept out of line, g++ otherwise sees free() applied to the result of operator new once a
+// delete is inlined into its caller and warns with -Wmismatched-new-delete.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+static void Release(void* ptr, size_t alignment) noexcept
+{
+    if (ptr != nullptr && alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ptr = reinterpret_cast<void**>(ptr)[-1];
+    }
+    std::free(ptr);
+}
+
+void* operator new(size_t size) { return AllocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return AllocateOrThrow(size, 0); }
+void* operator new(size_t size, std::align_val_t align) { return AllocateOrThrow(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return AllocateOrThrow(size, static_cast<size_t>(align)); }
+void* operator new(size_t size, const std::nothrow_t &) noexcept { return Allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t &) noexcept { return Allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return Allocate(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return Allocate(size, static_cast<size_t>(align)); }
+
+void operator delete(void* ptr) noexcept { Release(ptr, 0); }
+void operator delete[](void* ptr) noexcept { Release(ptr, 0); }
+void operator delete(void* ptr, size_t) noexcept { Release(ptr, 0); }
+void operator delete[](void* ptr, size_t) noexcept { Release(ptr, 0); }
+void operator delete(void* ptr, std::align_val_t align) noexcept { Release(ptr, static_cast<size_t>(align)); }
+void operator delete[](void* ptr, std::align_val_t align) noexcept { Release(ptr, static_cast<size_t>(align)); }
+void operator delete(void* ptr, size_t, std::align_val_t align) noexcept { Release(ptr, static_cast<size_t>(align)); }
+void operator delete[](void* ptr, size_t, std::align_val_t align) noexcept { Release(ptr, static_cast<size_t>(align)); }
+void operator delete(void* ptr, const std::nothrow_t &) noexcept { Release(ptr, 0); }
+void operator delete[](void* ptr, const std::nothrow_t &) noexcept { Release(ptr, 0); }
+void operator delete(void* ptr, std::align_val_t align, const std::nothrow_t &) noexcept { Release(ptr, static_cast<size_t>(align)); }
+void operator delete[](void* ptr, std::align_val_t align, const std::nothrow_t &) noexcept { Release(ptr, static_cast<size_t>(align)); }
+
+static std::string MakeMessage(JSONBenchmark::Random &random, size_t id)
+{
+    std::string message = "{\"id\": " + std::to_string(id);
+    message += ", \"user\": {\"name\": \"user" + std::to_string(random.below(1000)) + "\", \"tags\": [\"a\", \"b\", \"c\"]";
+    message += ", \"score\": " + std::to_string(random.below(100000) / 7.0) + "}";
+    message += ", \"items\": [" + std::to_string(random.below(10)) + ", 2, 3, 4, 5, 6, 7, 8]";
+    message += ", \"ok\": true, \"note\": \"caf\\u00e9 " + std::to_string(id) + "\"}";
+    return message;
+}
+
+template <typename _Func>
+static void Measure(const char* name, const std::vector<std::string> &messages, size_t reps, _Func &&parse)
+{
+    // Warms up retained buffers, steady state is what is measured.
+    for (size_t idx = 0; idx < 5 && idx < messages.size(); idx++) {
+        JSONBenchmark::Consume(parse(messages[idx]));
+    }
+    auto before = allocations.load(std::memory_order_relaxed);
+    auto elapsed = JSONBenchmark::MinTime(1, [&] {
+        for (size_t rep = 0; rep < reps; rep++) {
+            for (const auto &message : messages) {
+                JSONBenchmark::Consume(parse(message));
+            }
+        }
+        return 0;
+    });
+    auto parses = static_cast<double>(reps * messages.size());
+    auto count = allocations.load(std::memory_order_relaxed) - before;
+    std::printf("%-32s %8.2f allocs/parse %10.1f ns/parse\n", name, (count / parses), (elapsed * 1e6 / parses));
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    size_t reps = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 20;
+
+    JSONBenchmark::Random random(7);
+    std::vector<std::string> messages{};
+    size_t bytes = 0;
+    for (size_t idx = 0; idx < count; idx++) {
+        messages.emplace_back(MakeMessage(random, idx));
+        bytes += messages.back().size();
+    }
+    std::printf("messages: %zu, %zu bytes on average\n", count, (bytes / count));
+
+    JSONParser parser{};
+    for (const auto &message : messages) {
+        if (parser.parseObject(message).toString() != JSONObject(message).toString() ||
+            parser.parse(message).toString() != JSONDocument(message).toString())
+        {
+            std::printf("results differ\n");
+            return 1;
+        }
+    }
+
+    Measure("JSONObject(text)", messages, reps, [](std::string_view text) {
+        return JSONObject(text).size();
+    });
+    Measure("JSONDocument(text)", messages, reps, [](std::string_view text) {
+        return JSONDocument(text).object().size();
+    });
+    Measure("JSONParser::parseObject", messages, reps, [&](std::string_view text) {
+        return parser.parseObject(text).size();
+    });
+    Measure("JSONParser::parse", messages, reps, [&](std::string_view text) {
+        return parser.parse(text).object().size();
+    });
+    Measure("JSONParser::parse BORROW", messages, reps, [&](std::string_view text) {
+        return parser.parse(text, JSONDocument::ParseMode::BORROW).object().size();
+    });
+    return 0;
+}